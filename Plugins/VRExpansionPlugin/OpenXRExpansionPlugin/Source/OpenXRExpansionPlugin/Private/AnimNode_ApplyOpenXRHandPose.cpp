@@ -13,6 +13,58 @@
 #include "Runtime/Engine/Public/Animation/AnimInstanceProxy.h"
 #include "BoneControllers/AnimNode_SkeletalControlBase.h"
 	
+namespace OpenXRHandBones
+{
+	// Manually built parent hierarchy starting at the wrist which has no parent (-1)
+	static const int32 BoneParents[EHandKeypointCount] =
+	{
+		1,	// Palm -> Wrist
+		-1,	// Wrist -> None
+		1,	// ThumbMetacarpal -> Wrist
+		2,	// ThumbProximal -> ThumbMetacarpal
+		3,	// ThumbDistal -> ThumbProximal
+		4,	// ThumbTip -> ThumbDistal
+
+		1,	// IndexMetacarpal -> Wrist
+		6,	// IndexProximal -> IndexMetacarpal
+		7,	// IndexIntermediate -> IndexProximal
+		8,	// IndexDistal -> IndexIntermediate
+		9,	// IndexTip -> IndexDistal
+
+		1,	// MiddleMetacarpal -> Wrist
+		11,	// MiddleProximal -> MiddleMetacarpal
+		12,	// MiddleIntermediate -> MiddleProximal
+		13,	// MiddleDistal -> MiddleIntermediate
+		14,	// MiddleTip -> MiddleDistal
+
+		1,	// RingMetacarpal -> Wrist
+		16,	// RingProximal -> RingMetacarpal
+		17,	// RingIntermediate -> RingProximal
+		18,	// RingDistal -> RingIntermediate
+		19,	// RingTip -> RingDistal
+
+		1,	// LittleMetacarpal -> Wrist
+		21,	// LittleProximal -> LittleMetacarpal
+		22,	// LittleIntermediate -> LittleProximal
+		23,	// LittleDistal -> LittleIntermediate
+		24,	// LittleTip -> LittleDistal
+	};
+
+	// The joint that a joint is made relative to
+	static int32 GetConversionParent(int32 Index, bool bMergeMissingUE4Bones)
+	{
+		int32 ParentIndex = BoneParents[Index];
+
+		// Merging the missing metacarpal bone into the proximal, thumb keeps the metacarpal intact so we don't skip it
+		if (bMergeMissingUE4Bones && Index != (int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_PROXIMAL_EXT && ParentIndex > 0 && BoneParents[ParentIndex] == 1)
+		{
+			ParentIndex = 1; // Wrist
+		}
+
+		return ParentIndex;
+	}
+}
+
 FAnimNode_ApplyOpenXRHandPose::FAnimNode_ApplyOpenXRHandPose()
 	: FAnimNode_SkeletalControlBase()
 {
@@ -22,6 +74,7 @@ FAnimNode_ApplyOpenXRHandPose::FAnimNode_ApplyOpenXRHandPose()
 	bIsOpenInputAnimationInstance = false;
 	bSkipRootBone = false;
 	bOnlyApplyWristTransform = false;
+	RequiredJointMask = 0;
 	//WristAdjustment = FQuat::Identity;
 }
 
@@ -116,6 +169,42 @@ void FAnimNode_ApplyOpenXRHandPose::InitializeBoneReferences(const FBoneContaine
 			
 		}
 	}
+
+	RebuildBoneRemap(RequiredBones);
+}
+
+void FAnimNode_ApplyOpenXRHandPose::RebuildBoneRemap(const FBoneContainer& RequiredBones)
+{
+	BoneRemap.Reset(MappedBonePairs.BonePairs.Num());
+	RequiredJointMask = 0;
+
+	if (!MappedBonePairs.bInitialized)
+		return;
+
+	for (FBPOpenXRSkeletalPair& BonePair : MappedBonePairs.BonePairs)
+	{
+		// Required bones change with LOD, so the compact indices have to be refreshed even if the mapping didn't change
+		BonePair.ReferenceToConstruct.CachedCompactPoseIndex = BonePair.ReferenceToConstruct.GetCompactPoseIndex(RequiredBones);
+		BonePair.ParentReference = FCompactPoseBoneIndex(INDEX_NONE);
+
+		if (BonePair.ReferenceToConstruct.CachedCompactPoseIndex == INDEX_NONE || !BonePair.ReferenceToConstruct.IsValidToEvaluate(RequiredBones))
+			continue;
+
+		BonePair.ParentReference = RequiredBones.GetParentBoneIndex(BonePair.ReferenceToConstruct.CachedCompactPoseIndex);
+
+		const int32 OpenXRBone = (int32)BonePair.OpenXRBone;
+		if (OpenXRBone < 0 || OpenXRBone >= EHandKeypointCount)
+			continue;
+
+		BoneRemap.Add(FOpenXRHandBoneRemap(BonePair.ReferenceToConstruct.CachedCompactPoseIndex, BonePair.ParentReference, (uint8)OpenXRBone));
+
+		RequiredJointMask |= 1u << OpenXRBone;
+		const int32 ConversionParent = OpenXRHandBones::GetConversionParent(OpenXRBone, MappedBonePairs.bMergeMissingBonesUE4);
+		if (ConversionParent >= 0)
+		{
+			RequiredJointMask |= 1u << ConversionParent;
+		}
+	}
 }
 
 void FAnimNode_ApplyOpenXRHandPose::CalculateSkeletalAdjustment(USkeleton* AssetSkeleton)
@@ -185,7 +274,7 @@ void FAnimNode_ApplyOpenXRHandPose::CalculateOpenXRAdjustment()
 
 }
 
-void FAnimNode_ApplyOpenXRHandPose::ConvertHandTransformsSpace(TArray<FTransform>& OutTransforms, const TArray<FTransform>& WorldTransforms, FTransform AddTrans, bool bMirrorLeftRight, bool bMergeMissingUE4Bones)
+void FAnimNode_ApplyOpenXRHandPose::ConvertHandTransformsSpace(TArray<FTransform>& OutTransforms, const TArray<FTransform>& WorldTransforms, FTransform AddTrans, bool bMirrorLeftRight, bool bMergeMissingUE4Bones, uint32 JointMask)
 {
 	// Fail if the count is too low
 	if (WorldTransforms.Num() < EHandKeypointCount)
@@ -197,118 +286,55 @@ void FAnimNode_ApplyOpenXRHandPose::ConvertHandTransformsSpace(TArray<FTransform
 		OutTransforms.AddUninitialized(WorldTransforms.Num());
 	}
 
-	TArray<FTransform> TempWorldTransforms = WorldTransforms;
+	if (ScratchWorldTransforms.Num() < EHandKeypointCount)
+	{
+		ScratchWorldTransforms.Empty(EHandKeypointCount);
+		ScratchWorldTransforms.AddUninitialized(EHandKeypointCount);
+	}
 
 	// Ensure add trans is normalized
 	AddTrans.NormalizeRotation();
 
-	// Bone/Parent map
-	int32 BoneParents[26] =
-	{
-		// Manually build the parent hierarchy starting at the wrist which has no parent (-1)
-		1,	// Palm -> Wrist
-		-1,	// Wrist -> None
-		1,	// ThumbMetacarpal -> Wrist
-		2,	// ThumbProximal -> ThumbMetacarpal
-		3,	// ThumbDistal -> ThumbProximal
-		4,	// ThumbTip -> ThumbDistal
-
-		1,	// IndexMetacarpal -> Wrist
-		6,	// IndexProximal -> IndexMetacarpal
-		7,	// IndexIntermediate -> IndexProximal
-		8,	// IndexDistal -> IndexIntermediate
-		9,	// IndexTip -> IndexDistal
-
-		1,	// MiddleMetacarpal -> Wrist
-		11,	// MiddleProximal -> MiddleMetacarpal
-		12,	// MiddleIntermediate -> MiddleProximal
-		13,	// MiddleDistal -> MiddleIntermediate
-		14,	// MiddleTip -> MiddleDistal
-
-		1,	// RingMetacarpal -> Wrist
-		16,	// RingProximal -> RingMetacarpal
-		17,	// RingIntermediate -> RingProximal
-		18,	// RingDistal -> RingIntermediate
-		19,	// RingTip -> RingDistal
-
-		1,	// LittleMetacarpal -> Wrist
-		21,	// LittleProximal -> LittleMetacarpal
-		22,	// LittleIntermediate -> LittleProximal
-		23,	// LittleDistal -> LittleIntermediate
-		24,	// LittleTip -> LittleDistal
-	};
-
 	bool bUseAutoCalculatedRetarget = AddTrans.Equals(FTransform::Identity);
+	const FQuat Adjustment = bUseAutoCalculatedRetarget ? MappedBonePairs.AdjustmentQuat : AddTrans.GetRotation();
 
 	// Convert transforms to parent space
 	// The hand tracking transforms are in world space.
-
 	for (int32 Index = 0; Index < EHandKeypointCount; ++Index)
 	{
-		if (TempWorldTransforms[Index].ContainsNaN() || TempWorldTransforms[Index].Equals(FTransform::Identity))
-		{
-			OutTransforms[Index] = FTransform::Identity;
-			//continue;
-		}
+		if (!(JointMask & (1u << Index)))
+			continue;
+
+		FTransform& BoneTransform = ScratchWorldTransforms[Index];
+		BoneTransform = WorldTransforms[Index];
 
 		// Ensure normalization
-		TempWorldTransforms[Index].NormalizeRotation();
+		BoneTransform.NormalizeRotation();
 
 		if (bMirrorLeftRight)
 		{
-			TempWorldTransforms[Index].Mirror(EAxis::Y, EAxis::Y);
+			BoneTransform.Mirror(EAxis::Y, EAxis::Y);
 		}
 
-		if (bUseAutoCalculatedRetarget)
-		{
-			TempWorldTransforms[Index].ConcatenateRotation(MappedBonePairs.AdjustmentQuat);
-			//WorldTransforms[Index].ConcatenateRotation(MappedBonePairs.BonePairs[0].RetargetRot);
-		}
-		else
-		{
-			TempWorldTransforms[Index].ConcatenateRotation(AddTrans.GetRotation());
-		}
+		BoneTransform.ConcatenateRotation(Adjustment);
 	}
 
-	// Make this into a single loop, their structure always has children after parent
+	// Their structure always has children after parent
 	for (int32 Index = 0; Index < EHandKeypointCount; ++Index)
 	{
-		FTransform& BoneTransform = TempWorldTransforms[Index];
-		//BoneTransform.NormalizeRotation();
+		if (!(JointMask & (1u << Index)))
+			continue;
 
-		int32 ParentIndex = BoneParents[Index];
-		int32 ParentParent = -1;
-
-		// Thumb keeps the metacarpal intact, we don't skip it
-		if (bMergeMissingUE4Bones)
-		{
-			if (Index != (int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_PROXIMAL_EXT && ParentIndex > 0)
-			{
-				ParentParent = BoneParents[ParentIndex];
-			}
-		}
+		const int32 ParentIndex = OpenXRHandBones::GetConversionParent(Index, bMergeMissingUE4Bones);
 
 		if (ParentIndex < 0)
 		{
 			// We are at the root, so use it.
-			OutTransforms[Index] = BoneTransform;
+			OutTransforms[Index] = ScratchWorldTransforms[Index];
 		}
 		else
 		{
-			FTransform ParentTransform = FTransform::Identity;
-
-			// Merging missing metacarpal bone into the transform
-			if (bMergeMissingUE4Bones && ParentParent == 1) // Wrist
-			{
-				ParentTransform = TempWorldTransforms[ParentParent];
-			}
-			else
-			{
-				ParentTransform = TempWorldTransforms[ParentIndex];
-			}
-
-			//ParentTransform.NormalizeRotation();
-			OutTransforms[Index] = BoneTransform.GetRelativeTransform(ParentTransform);
+			OutTransforms[Index] = ScratchWorldTransforms[Index].GetRelativeTransform(ScratchWorldTransforms[ParentIndex]);
 		}
 	}
 }
@@ -384,73 +410,56 @@ void FAnimNode_ApplyOpenXRHandPose::EvaluateSkeletalControl_AnyThread(FComponent
 
 
 	FTransform trans = FTransform::Identity;
-	OutBoneTransforms.Reserve(MappedBonePairs.BonePairs.Num());
-	TArray<FBoneTransform> TransBones;
 	FTransform AdditionTransform = StoredActionInfoPtr->AdditionTransform;
 
 	FTransform TempTrans = FTransform::Identity;
 	FTransform ParentTrans = FTransform::Identity;
-	FTransform * ParentTransPtr = nullptr;
 
-	//AdditionTransform.SetRotation(MappedBonePairs.AdjustmentQuat);
+	// Only the wrist is needed if that is all that we are applying
+	const uint32 JointMask = bOnlyApplyWristTransform ? (1u << (int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT) : RequiredJointMask;
+	ConvertHandTransformsSpace(ScratchHandTransforms, StoredActionInfoPtr->SkeletalTransforms, AdditionTransform, StoredActionInfoPtr->bMirrorLeftRight, MappedBonePairs.bMergeMissingBonesUE4, JointMask);
 
-	TArray<FTransform> HandTransforms;
-	ConvertHandTransformsSpace(HandTransforms, StoredActionInfoPtr->SkeletalTransforms, AdditionTransform, StoredActionInfoPtr->bMirrorLeftRight, MappedBonePairs.bMergeMissingBonesUE4);
+	if (ScratchHandTransforms.Num() < EHandKeypointCount)
+		return;
 
-	for (const FBPOpenXRSkeletalPair& BonePair : MappedBonePairs.BonePairs)
+	for (const FOpenXRHandBoneRemap& Remap : BoneRemap)
 	{
-		BoneTransIndex = (int8)BonePair.OpenXRBone;
+		BoneTransIndex = Remap.OpenXRBone;
 		ParentTrans = FTransform::Identity;
 
-		if (bSkipRootBone && BonePair.OpenXRBone == EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT)
+		EXRHandJointType CurrentBone = (EXRHandJointType)BoneTransIndex;
+
+		if (bSkipRootBone && CurrentBone == EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT)
 			continue;
 
-		if (BoneTransIndex >= NumBones || BonePair.ReferenceToConstruct.CachedCompactPoseIndex == INDEX_NONE)
-			continue;		
+		if (BoneTransIndex >= NumBones)
+			continue;
 
-		if (!BonePair.ReferenceToConstruct.IsValidToEvaluate(BoneContainer))
-		{
+		if (bOnlyApplyWristTransform && CurrentBone != EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT)
 			continue;
-		}
 
-		trans = Output.Pose.GetComponentSpaceTransform(BonePair.ReferenceToConstruct.CachedCompactPoseIndex);
+		trans = Output.Pose.GetComponentSpaceTransform(Remap.BoneIndex);
 
-		if (BonePair.ParentReference != INDEX_NONE)
+		if (Remap.ParentIndex != INDEX_NONE)
 		{
-			ParentTrans = Output.Pose.GetComponentSpaceTransform(BonePair.ParentReference);
+			ParentTrans = Output.Pose.GetComponentSpaceTransform(Remap.ParentIndex);
 			ParentTrans.SetScale3D(FVector(1.f));
 		}
 
-		EXRHandJointType CurrentBone = (EXRHandJointType)BoneTransIndex;
-		TempTrans = (HandTransforms[BoneTransIndex]);
-		//TempTrans.ConcatenateRotation(BonePair.RetargetRot);
-
-		/*if (StoredActionInfoPtr->bMirrorHand)
-		{
-			FMatrix M = TempTrans.ToMatrixWithScale();
-			M.Mirror(EAxis::Z, EAxis::X);
-			M.Mirror(EAxis::X, EAxis::Z);
-			TempTrans.SetFromMatrix(M);
-		}*/
-
-		TempTrans = TempTrans * ParentTrans;
+		TempTrans = ScratchHandTransforms[BoneTransIndex] * ParentTrans;
 
 		if (StoredActionInfoPtr->bAllowDeformingMesh || bOnlyApplyWristTransform)
 			trans.SetTranslation(TempTrans.GetTranslation());
 
 		trans.SetRotation(TempTrans.GetRotation());
 		
-		TransBones.Add(FBoneTransform(BonePair.ReferenceToConstruct.CachedCompactPoseIndex, trans));
-
 		// Need to do it per bone so future bones are correct
 		// Only if in parent space though, can do it all at the end in component space
-		if (TransBones.Num())
-		{
-			Output.Pose.LocalBlendCSBoneTransforms(TransBones, BlendWeight);
-			TransBones.Reset();
-		}
+		ScratchBoneTransforms.Reset();
+		ScratchBoneTransforms.Add(FBoneTransform(Remap.BoneIndex, trans));
+		Output.Pose.LocalBlendCSBoneTransforms(ScratchBoneTransforms, BlendWeight);
 
-		if (bOnlyApplyWristTransform && CurrentBone == EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT)
+		if (bOnlyApplyWristTransform)
 		{
 			break; // Early out of the loop, we only wanted to apply the wrist
 		}
@@ -270,17 +270,26 @@ bool UOpenXRExpansionFunctionLibrary::GetOpenXRFingerCurlValuesForHand(
 }
 
 float UOpenXRExpansionFunctionLibrary::GetCurlValueForBoneRoot(TArray<FTransform>& TransformArray, EHandKeypoint RootBone)
+{
+	return GetCurlValueForBones(
+		TransformArray[(uint8)RootBone].GetRotation(),
+		TransformArray[(uint8)RootBone + 1].GetRotation(),
+		TransformArray[(uint8)RootBone + 2].GetRotation(),
+		RootBone == EHandKeypoint::ThumbMetacarpal);
+}
+
+float UOpenXRExpansionFunctionLibrary::GetCurlValueForBones(const FQuat& ProxRot, const FQuat& InterRot, const FQuat& DistalRot, bool bIsThumb)
 {
 	float Angle1 = 0.0f;
 	float Angle2 = 0.0f;
 	float Angle1Curl = 0.0f;
 	float Angle2Curl = 0.0f;
 
-	if (RootBone == EHandKeypoint::ThumbMetacarpal)
+	if (bIsThumb)
 	{
-		FVector Prox = TransformArray[(uint8)RootBone].GetRotation().GetForwardVector();
-		FVector Inter = TransformArray[(uint8)RootBone + 1].GetRotation().GetForwardVector();
-		FVector Distal = TransformArray[(uint8)RootBone + 2].GetRotation().GetForwardVector();
+		FVector Prox = ProxRot.GetForwardVector();
+		FVector Inter = InterRot.GetForwardVector();
+		FVector Distal = DistalRot.GetForwardVector();
 
 		Prox = FVector::VectorPlaneProject(Prox, FVector::UpVector);
 		Inter = FVector::VectorPlaneProject(Inter, FVector::UpVector);
@@ -294,9 +303,9 @@ float UOpenXRExpansionFunctionLibrary::GetCurlValueForBoneRoot(TArray<FTransform
 	}
 	else
 	{
-		FVector Prox = TransformArray[(uint8)RootBone].GetRotation().GetForwardVector();
-		FVector Inter = TransformArray[(uint8)RootBone + 1].GetRotation().GetForwardVector();
-		FVector Distal = TransformArray[(uint8)RootBone + 2].GetRotation().GetForwardVector();
+		FVector Prox = ProxRot.GetForwardVector();
+		FVector Inter = InterRot.GetForwardVector();
+		FVector Distal = DistalRot.GetForwardVector();
 
 
 		// We don't use the Y (splay) value, only X and Z plane
@@ -6,6 +6,8 @@
 #include "MotionControllerComponent.h"
 #include "OpenXRExpansionFunctionLibrary.h"
 #include "Engine/NetSerialization.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
 
 #include "XRMotionControllerBase.h" // for GetHandEnumForSourceName()
 //#include "EngineMinimal.h"
@@ -21,6 +23,7 @@ UOpenXRHandPoseComponent::UOpenXRHandPoseComponent(const FObjectInitializer& Obj
 	bSmoothReplicatedSkeletalData = true;
 	SkeletalNetUpdateCount = 0.f;
 	bDetectGestures = true;
+	GestureHysteresis = 0.0f;
 	SetIsReplicatedByDefault(true);
 	bGetMockUpPoseForDebugging = false;
 }
@@ -49,10 +52,11 @@ void UOpenXRHandPoseComponent::Server_SendSkeletalTransforms_Implementation(cons
 
 				FBPXRSkeletalRepContainer::CopyReplicatedTo(SkeletalInfo, HandSkeletalActions[i]);
 				LeftHandRep = SkeletalInfo;
+				LeftHandRep.CopyEncodingSettings(HandSkeletalActions[i]);
 
 				if (bSmoothReplicatedSkeletalData)
 				{
-					LeftHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations, bUseExponentialSmoothing);
+					LeftHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations, bUseExponentialSmoothing, GetWorld()->GetRealTimeSeconds());
 				}
 			}
 			else
@@ -64,10 +68,11 @@ void UOpenXRHandPoseComponent::Server_SendSkeletalTransforms_Implementation(cons
 
 				FBPXRSkeletalRepContainer::CopyReplicatedTo(SkeletalInfo, HandSkeletalActions[i]);
 				RightHandRep = SkeletalInfo;
+				RightHandRep.CopyEncodingSettings(HandSkeletalActions[i]);
 
 				if (bSmoothReplicatedSkeletalData)
 				{
-					RightHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations, bUseExponentialSmoothing);
+					RightHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations, bUseExponentialSmoothing, GetWorld()->GetRealTimeSeconds());
 				}
 			}
 
@@ -271,6 +276,7 @@ bool UOpenXRHandPoseComponent::SaveCurrentPose(FName RecordingName, EVRSkeletalH
 
 		NewGesture.Name = RecordingName;
 		GesturesDB->Gestures.Add(NewGesture);
+		GesturesDB->RecompileGestures();
 
 		return true;
 	}
@@ -279,12 +285,9 @@ bool UOpenXRHandPoseComponent::SaveCurrentPose(FName RecordingName, EVRSkeletalH
 }
 
 
-bool UOpenXRHandPoseComponent::K2_DetectCurrentPose(UPARAM(ref) FBPOpenXRActionSkeletalData& SkeletalAction, FOpenXRGesture & GestureOut)
+namespace OpenXRGestures
 {
-	if (!GesturesDB || GesturesDB->Gestures.Num() < 1)
-		return false;
-
-	int32 FingerMap[5] =
+	static const int32 FingerMap[5] =
 	{
 		(int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_TIP_EXT,
 		(int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_TIP_EXT,
@@ -293,141 +296,235 @@ bool UOpenXRHandPoseComponent::K2_DetectCurrentPose(UPARAM(ref) FBPOpenXRActionS
 		(int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_TIP_EXT
 	};
 
-	FVector WristLoc = FVector::ZeroVector;
+	// Tips relative to the wrist, left hands are mirrored into right hand space like the recorded gestures are
+	static void GetCurrentTips(const FBPOpenXRActionSkeletalData& SkeletalAction, FVector3f OutTips[5])
+	{
+		const bool bMirror = SkeletalAction.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left;
+		const FVector WristLoc = SkeletalAction.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT].GetLocation();
+
+		for (int i = 0; i < 5; ++i)
+		{
+			FVector Tip = SkeletalAction.SkeletalTransforms[FingerMap[i]].GetLocation() - WristLoc;
+			if (bMirror)
+				Tip = Tip.MirrorByVector(FVector::RightVector);
+
+			OutTips[i] = FVector3f(Tip);
+		}
+	}
+}
 
-	if (SkeletalAction.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
+void FOpenXRCompiledGestureTable::Compile(const TArray<FOpenXRGesture>& Gestures)
+{
+	NumGestures = Gestures.Num();
+	NumPadded = Align(NumGestures, 4);
+
+	for (int32 Stream = 0; Stream < 15; ++Stream)
 	{
-		WristLoc = SkeletalAction.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT].GetLocation().MirrorByVector(FVector::RightVector);
+		Targets[Stream].Reset(NumPadded);
+		Targets[Stream].AddZeroed(NumPadded);
 	}
-	else
+
+	for (int32 Finger = 0; Finger < 5; ++Finger)
 	{
-		WristLoc = SkeletalAction.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT].GetLocation();
+		InvThresholds[Finger].Reset(NumPadded);
+		InvThresholds[Finger].AddZeroed(NumPadded);
 	}
 
-	// Early fill in an array to keep from performing math for each gesture
-	TArray<FVector> CurrentTips;
-	CurrentTips.AddUninitialized(5);
-	for (int i = 0; i < 5; ++i)
+	BaseScores.Reset(NumPadded);
+	BaseScores.Init(MAX_flt, NumPadded);
+
+	for (int32 GestureIndex = 0; GestureIndex < NumGestures; ++GestureIndex)
 	{
-		if (SkeletalAction.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
+		const FOpenXRGesture& Gesture = Gestures[GestureIndex];
+
+		// If not enough indexs to match finger values then it keeps the max score and never matches
+		if (Gesture.FingerValues.Num() < 5)
+			continue;
+
+		BaseScores[GestureIndex] = 0.0f;
+
+		for (int32 Finger = 0; Finger < 5; ++Finger)
 		{
-			CurrentTips[i] = SkeletalAction.SkeletalTransforms[FingerMap[i]].GetLocation().MirrorByVector(FVector::RightVector) - WristLoc;
+			const FOpenXRGestureFingerPosition& FingerValue = Gesture.FingerValues[Finger];
+			InvThresholds[Finger][GestureIndex] = FingerValue.Threshold > 0.0f ? 1.0f / FingerValue.Threshold : 0.0f;
+
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Targets[Finger * 3 + Axis][GestureIndex] = (float)FingerValue.Value[Axis];
+			}
 		}
-		else
+	}
+}
+
+float FOpenXRCompiledGestureTable::ScoreGesture(int32 GestureIndex, const FVector3f Tips[5]) const
+{
+	if (GestureIndex < 0 || GestureIndex >= NumGestures)
+		return MAX_flt;
+
+	float Score = BaseScores[GestureIndex];
+	for (int32 Finger = 0; Finger < 5; ++Finger)
+	{
+		const float InvThreshold = InvThresholds[Finger][GestureIndex];
+		for (int32 Axis = 0; Axis < 3; ++Axis)
 		{
-			CurrentTips[i] = SkeletalAction.SkeletalTransforms[FingerMap[i]].GetLocation() - WristLoc;
+			Score = FMath::Max(Score, FMath::Abs(Targets[Finger * 3 + Axis][GestureIndex] - Tips[Finger][Axis]) * InvThreshold);
 		}
 	}
 
-	for (const FOpenXRGesture& Gesture : GesturesDB->Gestures)
+	return Score;
+}
+
+int32 FOpenXRCompiledGestureTable::FindBestMatch(const FVector3f Tips[5], float& OutScore) const
+{
+	int32 BestIndex = INDEX_NONE;
+	OutScore = MAX_flt;
+
+	VectorRegister4Float TipValues[15];
+	for (int32 Finger = 0; Finger < 5; ++Finger)
 	{
-		// If not enough indexs to match curl values, or if this gesture requires finger splay and the controller can't do it
-		if (Gesture.FingerValues.Num() < 5 || SkeletalAction.SkeletalTransforms.Num() < EHandKeypointCount)
-			continue;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			TipValues[Finger * 3 + Axis] = VectorSetFloat1(Tips[Finger][Axis]);
+		}
+	}
 
-		bool bDetectedPose = true;
-		for (int i = 0; i < 5; ++i)
+	for (int32 Base = 0; Base < NumPadded; Base += 4)
+	{
+		VectorRegister4Float Score = VectorLoadAligned(&BaseScores[Base]);
+
+		for (int32 Finger = 0; Finger < 5; ++Finger)
 		{
-			FVector GestureV = Gesture.FingerValues[i].Value;
-			FVector CurrentV = CurrentTips[i];
-			FVector Difference = GestureV - CurrentV;
+			const VectorRegister4Float InvThreshold = VectorLoadAligned(&InvThresholds[Finger][Base]);
 
-			if (!Gesture.FingerValues[i].Value.Equals(CurrentTips[i], Gesture.FingerValues[i].Threshold))
+			for (int32 Axis = 0; Axis < 3; ++Axis)
 			{
-				bDetectedPose = false;
-				break;
+				const int32 Stream = Finger * 3 + Axis;
+				const VectorRegister4Float Offset = VectorAbs(VectorSubtract(VectorLoadAligned(&Targets[Stream][Base]), TipValues[Stream]));
+				Score = VectorMax(Score, VectorMultiply(Offset, InvThreshold));
 			}
 		}
 
-		if (bDetectedPose)
+		// Most blocks won't have anything in range
+		if (!VectorMaskBits(VectorCompareLE(Score, GlobalVectorConstants::FloatOne)))
+			continue;
+
+		alignas(16) float Scores[4];
+		VectorStoreAligned(Score, Scores);
+
+		for (int32 i = 0; i < 4; ++i)
 		{
-			GestureOut = Gesture;
-			return true;
+			if (Scores[i] <= 1.0f && Scores[i] < OutScore)
+			{
+				OutScore = Scores[i];
+				BestIndex = Base + i;
+			}
 		}
 	}
 
-	return false;
+	return BestIndex;
 }
 
-bool UOpenXRHandPoseComponent::DetectCurrentPose(FBPOpenXRActionSkeletalData &SkeletalAction)
+void UOpenXRGestureDatabase::RecompileGestures()
+{
+	CompiledGestures.Compile(Gestures);
+}
+
+const FOpenXRCompiledGestureTable& UOpenXRGestureDatabase::GetCompiledGestures()
+{
+	if (CompiledGestures.NumGestures != Gestures.Num())
+	{
+		RecompileGestures();
+	}
+
+	return CompiledGestures;
+}
+
+void UOpenXRGestureDatabase::PostLoad()
+{
+	Super::PostLoad();
+	RecompileGestures();
+}
+
+#if WITH_EDITOR
+void UOpenXRGestureDatabase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	RecompileGestures();
+}
+#endif
+
+bool UOpenXRHandPoseComponent::FindBestGestureMatch(const FBPOpenXRActionSkeletalData& SkeletalAction, int32& GestureIndex, float& Score)
 {
+	GestureIndex = INDEX_NONE;
+	Score = MAX_flt;
+
 	if (!GesturesDB || GesturesDB->Gestures.Num() < 1 || SkeletalAction.SkeletalTransforms.Num() < EHandKeypointCount)
 		return false;
 
-	FTransform BoneTransform = FTransform::Identity;
+	FVector3f CurrentTips[5];
+	OpenXRGestures::GetCurrentTips(SkeletalAction, CurrentTips);
 
-	int32 FingerMap[5] =
-	{
-		(int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_TIP_EXT,
-		(int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_TIP_EXT,
-		(int32)EXRHandJointType::OXR_HAND_JOINT_MIDDLE_TIP_EXT,
-		(int32)EXRHandJointType::OXR_HAND_JOINT_RING_TIP_EXT,
-		(int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_TIP_EXT
-	};
+	GestureIndex = GesturesDB->GetCompiledGestures().FindBestMatch(CurrentTips, Score);
+	return GestureIndex != INDEX_NONE;
+}
 
-	FVector WristLoc = FVector::ZeroVector;
+bool UOpenXRHandPoseComponent::K2_DetectCurrentPose(UPARAM(ref) FBPOpenXRActionSkeletalData& SkeletalAction, FOpenXRGesture & GestureOut)
+{
+	int32 GestureIndex = INDEX_NONE;
+	float Score = 0.0f;
 
-	if (SkeletalAction.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
-	{
-		WristLoc = SkeletalAction.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT].GetLocation().MirrorByVector(FVector::RightVector);
-	}
-	else
+	if (FindBestGestureMatch(SkeletalAction, GestureIndex, Score))
 	{
-		WristLoc = SkeletalAction.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT].GetLocation();
+		GestureOut = GesturesDB->Gestures[GestureIndex];
+		return true;
 	}
 
-	// Early fill in an array to keep from performing math for each gesture
-	TArray<FVector> CurrentTips;
-	CurrentTips.AddUninitialized(5);
-	for (int i = 0; i < 5; ++i)
+	return false;
+}
+
+bool UOpenXRHandPoseComponent::DetectCurrentPose(FBPOpenXRActionSkeletalData &SkeletalAction)
+{
+	if (!GesturesDB || GesturesDB->Gestures.Num() < 1 || SkeletalAction.SkeletalTransforms.Num() < EHandKeypointCount)
+		return false;
+
+	const FOpenXRCompiledGestureTable& CompiledGestures = GesturesDB->GetCompiledGestures();
+
+	FVector3f CurrentTips[5];
+	OpenXRGestures::GetCurrentTips(SkeletalAction, CurrentTips);
+
+	// Stay on the current gesture while it is still in range, this skips checking the rest of the database
+	if (SkeletalAction.LastHandGesture != NAME_None && GesturesDB->Gestures.IsValidIndex(SkeletalAction.LastHandGestureIndex) &&
+		GesturesDB->Gestures[SkeletalAction.LastHandGestureIndex].Name == SkeletalAction.LastHandGesture)
 	{
-		if (SkeletalAction.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
-		{
-			CurrentTips[i] = SkeletalAction.SkeletalTransforms[FingerMap[i]].GetLocation().MirrorByVector(FVector::RightVector) - WristLoc;
-		}
-		else
+		const float CurrentScore = CompiledGestures.ScoreGesture(SkeletalAction.LastHandGestureIndex, CurrentTips);
+		if (CurrentScore <= 1.0f + GestureHysteresis)
 		{
-			CurrentTips[i] = SkeletalAction.SkeletalTransforms[FingerMap[i]].GetLocation() - WristLoc;
+			SkeletalAction.LastHandGestureScore = CurrentScore;
+			return false; // Same gesture
 		}
 	}
 
-	for (auto GestureIterator = GesturesDB->Gestures.CreateConstIterator(); GestureIterator; ++GestureIterator)
-	{
-		const FOpenXRGesture &Gesture = *GestureIterator;
-
-		// If not enough indexs to match curl values, or if this gesture requires finger splay and the controller can't do it
-		if (Gesture.FingerValues.Num() < 5 || SkeletalAction.SkeletalTransforms.Num() < EHandKeypointCount)
-			continue;
-
-		bool bDetectedPose = true;
-		for (int i = 0; i < 5; ++i)
-		{
-			if (Gesture.FingerValues[i].Threshold <= 0.0f)
-				continue;
+	float BestScore = MAX_flt;
+	const int32 BestIndex = CompiledGestures.FindBestMatch(CurrentTips, BestScore);
 
-			if (!Gesture.FingerValues[i].Value.Equals(CurrentTips[i], Gesture.FingerValues[i].Threshold))
-			{
-				bDetectedPose = false;
-				break;
-			}
-		}
+	if (BestIndex != INDEX_NONE)
+	{
+		const FOpenXRGesture& Gesture = GesturesDB->Gestures[BestIndex];
+		SkeletalAction.LastHandGestureScore = BestScore;
 
-		if (bDetectedPose)
+		if (SkeletalAction.LastHandGesture != Gesture.Name)
 		{
-			if (SkeletalAction.LastHandGesture != Gesture.Name)
-			{
-				if (SkeletalAction.LastHandGesture != NAME_None)
-					OnGestureEnded.Broadcast(SkeletalAction.LastHandGesture, SkeletalAction.LastHandGestureIndex, SkeletalAction.TargetHand);
+			if (SkeletalAction.LastHandGesture != NAME_None)
+				OnGestureEnded.Broadcast(SkeletalAction.LastHandGesture, SkeletalAction.LastHandGestureIndex, SkeletalAction.TargetHand);
 
-				SkeletalAction.LastHandGesture = Gesture.Name;
-				SkeletalAction.LastHandGestureIndex = GestureIterator.GetIndex();
-				OnNewGestureDetected.Broadcast(SkeletalAction.LastHandGesture, SkeletalAction.LastHandGestureIndex, SkeletalAction.TargetHand);
+			SkeletalAction.LastHandGesture = Gesture.Name;
+			SkeletalAction.LastHandGestureIndex = BestIndex;
+			OnNewGestureDetected.Broadcast(SkeletalAction.LastHandGesture, SkeletalAction.LastHandGestureIndex, SkeletalAction.TargetHand);
 
-				return true;
-			}
-			else
-				return false; // Same gesture
+			return true;
 		}
+		else
+			return false; // Same gesture
 	}
 
 	if (SkeletalAction.LastHandGesture != NAME_None)
@@ -435,6 +532,7 @@ bool UOpenXRHandPoseComponent::DetectCurrentPose(FBPOpenXRActionSkeletalData &Sk
 		OnGestureEnded.Broadcast(SkeletalAction.LastHandGesture, SkeletalAction.LastHandGestureIndex, SkeletalAction.TargetHand);
 		SkeletalAction.LastHandGesture = NAME_None;
 		SkeletalAction.LastHandGestureIndex = INDEX_NONE;
+		SkeletalAction.LastHandGestureScore = 0.0f;
 	}
 
 	return false;
@@ -444,134 +542,147 @@ UOpenXRHandPoseComponent::FTransformLerpManager::FTransformLerpManager()
 {
 	bReplicatedOnce = false;
 	bLerping = false;
-	UpdateCount = 0.0f;
-	UpdateRate = 0.0f;
+	NewestSnapshot = 0;
+	NumSnapshots = 0;
+	MeanUpdateInterval = 0.0;
 }
 
 void UOpenXRHandPoseComponent::FTransformLerpManager::PreCopyNewData(FBPOpenXRActionSkeletalData& ActionInfo, int NetUpdateRate, bool bExponentialSmoothing)
 {
-	if (!bExponentialSmoothing)
-	{
-		if (ActionInfo.SkeletalTransforms.Num())
-		{
-			OldTransforms = ActionInfo.SkeletalTransforms;
-		}
-	}
+	// Keep the pose we are rendering, the new data is copied into the spare array instead
+	Swap(ActionInfo.SkeletalTransforms, RenderedTransforms);
 }
 
-void UOpenXRHandPoseComponent::FTransformLerpManager::NotifyNewData(FBPOpenXRActionSkeletalData& ActionInfo, int NetUpdateRate, bool bExponentialSmoothing)
+void UOpenXRHandPoseComponent::FTransformLerpManager::NotifyNewData(FBPOpenXRActionSkeletalData& ActionInfo, int NetUpdateRate, bool bExponentialSmoothing, double TimeStamp)
 {
-	UpdateRate = (1.0f / NetUpdateRate);
+	if (ActionInfo.SkeletalTransforms.Num() != EHandKeypointCount)
+	{
+		// Invalid data, start over with the next valid pose
+		NumSnapshots = 0;
+		bReplicatedOnce = false;
+		bLerping = false;
+		return;
+	}
 
-	if (bReplicatedOnce)
+	if (NumSnapshots > 0)
 	{
-		bLerping = true;
-		UpdateCount = 0.0f;
-		NewTransforms = ActionInfo.SkeletalTransforms;
+		const double Interval = FMath::Clamp(TimeStamp - GetSnapshot(0).TimeStamp, 0.005, 1.0);
+		MeanUpdateInterval = FMath::Lerp(MeanUpdateInterval, Interval, 0.1);
+	}
+	else
+	{
+		MeanUpdateInterval = 1.0 / FMath::Max(NetUpdateRate, 1);
+	}
+
+	NewestSnapshot = (NewestSnapshot + 1) % SnapshotBufferSize;
+	NumSnapshots = FMath::Min(NumSnapshots + 1, SnapshotBufferSize);
 
-		ActionInfo.SkeletalTransforms = OldTransforms;
+	FHandSnapshot& Snapshot = Snapshots[NewestSnapshot];
+	Snapshot.TimeStamp = TimeStamp;
+	Swap(Snapshot.Transforms, ActionInfo.SkeletalTransforms);
 
+	if (bReplicatedOnce && RenderedTransforms.Num() == EHandKeypointCount)
+	{
+		// Back to the rendered pose, the evicted snapshots array becomes the spare
+		Swap(ActionInfo.SkeletalTransforms, RenderedTransforms);
+		bLerping = true;
 	}
 	else
 	{
-		if (bExponentialSmoothing)
-		{
-			OldTransforms = ActionInfo.SkeletalTransforms;
-		}
-
+		ActionInfo.SkeletalTransforms = Snapshot.Transforms;
 		bReplicatedOnce = true;
 	}
 }
 
 void UOpenXRHandPoseComponent::FTransformLerpManager::UpdateManager(float DeltaTime, FBPOpenXRActionSkeletalData& ActionInfo, UOpenXRHandPoseComponent* ParentComp)
 {
-	if (!ActionInfo.bHasValidData || !OldTransforms.Num())
+	if (!ActionInfo.bHasValidData || !NumSnapshots || !bLerping || ActionInfo.SkeletalTransforms.Num() != EHandKeypointCount)
 		return;
 
-	if (bLerping)
-	{	
-		bool bExponentialSmoothing = ParentComp->bUseExponentialSmoothing;
-		float LerpVal = 0.0f;
+	const TArray<FTransform>* From = &GetSnapshot(0).Transforms;
+	const TArray<FTransform>* To = From;
+	float LerpVal = 1.0f;
 
-		if (!bExponentialSmoothing || ParentComp->InterpolationSpeed <= 0.f)
-		{
-			UpdateCount += DeltaTime;
+	bool bExponentialSmoothing = ParentComp->bUseExponentialSmoothing;
 
-			// Keep LerpVal
-			LerpVal = FMath::Clamp(UpdateCount / UpdateRate, 0.0f, 1.0f);
-		}
-		else
-		{
-			LerpVal = FMath::Clamp(DeltaTime * ParentComp->InterpolationSpeed, 0.f, 1.f);
-		}
+	if (bExponentialSmoothing && ParentComp->InterpolationSpeed > 0.f)
+	{
+		// Smooth from wherever we currently are towards the newest pose
+		From = &ActionInfo.SkeletalTransforms;
+		LerpVal = FMath::Clamp(DeltaTime * ParentComp->InterpolationSpeed, 0.f, 1.f);
+	}
+	else
+	{
+		const double BufferDelay = ParentComp->InterpolationBufferDelay > 0.0f ? (double)ParentComp->InterpolationBufferDelay : MeanUpdateInterval * 1.5;
+		const double RenderTime = ParentComp->GetWorld()->GetRealTimeSeconds() - BufferDelay;
 
-		if (!bExponentialSmoothing && LerpVal >= 1.0f)
+		if (RenderTime >= GetSnapshot(0).TimeStamp)
 		{
+			// Caught up to the newest pose, set it and hold it until the next one comes in
 			bLerping = false;
-			UpdateCount = 0.0f;
-			ActionInfo.SkeletalTransforms = NewTransforms;
 		}
 		else
 		{
-			int32 BoneCountAdjustment = 6 + (ActionInfo.bEnableUE4HandRepSavings ? 4 : 0);
-			if ((NewTransforms.Num() < (EHandKeypointCount - BoneCountAdjustment)) || (NewTransforms.Num() != ActionInfo.SkeletalTransforms.Num()))
+			// Find the two poses around the render time, or hold the oldest one if we are behind the whole buffer
+			int32 Age = 1;
+			for (; Age < NumSnapshots; ++Age)
 			{
-				return;
+				if (GetSnapshot(Age).TimeStamp <= RenderTime)
+					break;
 			}
 
-			ActionInfo.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_PALM_EXT] = FTransform::Identity;
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
+			const FHandSnapshot& ToSnapshot = GetSnapshot(Age - 1);
+			const FHandSnapshot& FromSnapshot = GetSnapshot(FMath::Min(Age, NumSnapshots - 1));
+			From = &FromSnapshot.Transforms;
+			To = &ToSnapshot.Transforms;
 
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_METACARPAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_PROXIMAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_DISTAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			//BlendBone((uint8)EVROpenXRBones::eBone_Thumb3, ActionInfo, LerpVal); // Technically can be projected instead of blended
+			const double Span = ToSnapshot.TimeStamp - FromSnapshot.TimeStamp;
+			LerpVal = Span > UE_SMALL_NUMBER ? (float)FMath::Clamp((RenderTime - FromSnapshot.TimeStamp) / Span, 0.0, 1.0) : 0.0f;
+		}
+	}
 
-			if (!ActionInfo.bEnableUE4HandRepSavings)
-			{
-				BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_METACARPAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			}
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_PROXIMAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_INTERMEDIATE_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_DISTAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			//BlendBone((uint8)EVROpenXRBones::eBone_IndexFinger4, ActionInfo, LerpVal); // Technically can be projected instead of blended
+	if (From->Num() != EHandKeypointCount || To->Num() != EHandKeypointCount)
+		return;
 
-			if (!ActionInfo.bEnableUE4HandRepSavings)
-			{
-				BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_MIDDLE_METACARPAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			}
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_MIDDLE_PROXIMAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_MIDDLE_INTERMEDIATE_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_MIDDLE_DISTAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			//BlendBone((uint8)EVROpenXRBones::eBone_IndexFinger4, ActionInfo, LerpVal); // Technically can be projected instead of blended
+	// Only the bones that are replicated, the rest are identity
+	ActionInfo.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_PALM_EXT] = FTransform::Identity;
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT, ActionInfo, *From, *To, LerpVal);
 
-			if (!ActionInfo.bEnableUE4HandRepSavings)
-			{
-				BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_RING_METACARPAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			}
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_RING_PROXIMAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_RING_INTERMEDIATE_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_RING_DISTAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			//BlendBone((uint8)EVROpenXRBones::eBone_IndexFinger4, ActionInfo, LerpVal); // Technically can be projected instead of blended
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_METACARPAL_EXT, ActionInfo, *From, *To, LerpVal);
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_PROXIMAL_EXT, ActionInfo, *From, *To, LerpVal);
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_DISTAL_EXT, ActionInfo, *From, *To, LerpVal);
 
-			if (!ActionInfo.bEnableUE4HandRepSavings)
-			{
-				BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_METACARPAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			}
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_PROXIMAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_INTERMEDIATE_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_DISTAL_EXT, ActionInfo, LerpVal, bExponentialSmoothing);
-			//BlendBone((uint8)EVROpenXRBones::eBone_IndexFinger4, ActionInfo, LerpVal); // Technically can be projected instead of blended
+	if (!ActionInfo.bEnableUE4HandRepSavings)
+	{
+		BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_METACARPAL_EXT, ActionInfo, *From, *To, LerpVal);
+	}
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_PROXIMAL_EXT, ActionInfo, *From, *To, LerpVal);
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_INTERMEDIATE_EXT, ActionInfo, *From, *To, LerpVal);
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_DISTAL_EXT, ActionInfo, *From, *To, LerpVal);
 
-			// These are copied from the 3rd joints as they use the same transform but a different root
-			// Don't want to waste cpu time blending these
-			//ActionInfo.SkeletalTransforms[(uint8)EVROpenXRBones::eBone_Aux_Thumb] = ActionInfo.SkeletalData.SkeletalTransforms[(uint8)EVROpenXRBones::eBone_Thumb2];
-			//ActionInfo.SkeletalTransforms[(uint8)EVROpenXRBones::eBone_Aux_IndexFinger] = ActionInfo.SkeletalData.SkeletalTransforms[(uint8)EVROpenXRBones::eBone_IndexFinger3];
-			//ActionInfo.SkeletalTransforms[(uint8)EVROpenXRBones::eBone_Aux_MiddleFinger] = ActionInfo.SkeletalData.SkeletalTransforms[(uint8)EVROpenXRBones::eBone_MiddleFinger3];
-			//ActionInfo.SkeletalTransforms[(uint8)EVROpenXRBones::eBone_Aux_RingFinger] = ActionInfo.SkeletalData.SkeletalTransforms[(uint8)EVROpenXRBones::eBone_RingFinger3];
-			//ActionInfo.SkeletalTransforms[(uint8)EVROpenXRBones::eBone_Aux_PinkyFinger] = ActionInfo.SkeletalData.SkeletalTransforms[(uint8)EVROpenXRBones::eBone_PinkyFinger3];
-		}
+	if (!ActionInfo.bEnableUE4HandRepSavings)
+	{
+		BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_MIDDLE_METACARPAL_EXT, ActionInfo, *From, *To, LerpVal);
+	}
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_MIDDLE_PROXIMAL_EXT, ActionInfo, *From, *To, LerpVal);
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_MIDDLE_INTERMEDIATE_EXT, ActionInfo, *From, *To, LerpVal);
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_MIDDLE_DISTAL_EXT, ActionInfo, *From, *To, LerpVal);
+
+	if (!ActionInfo.bEnableUE4HandRepSavings)
+	{
+		BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_RING_METACARPAL_EXT, ActionInfo, *From, *To, LerpVal);
+	}
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_RING_PROXIMAL_EXT, ActionInfo, *From, *To, LerpVal);
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_RING_INTERMEDIATE_EXT, ActionInfo, *From, *To, LerpVal);
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_RING_DISTAL_EXT, ActionInfo, *From, *To, LerpVal);
+
+	if (!ActionInfo.bEnableUE4HandRepSavings)
+	{
+		BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_METACARPAL_EXT, ActionInfo, *From, *To, LerpVal);
 	}
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_PROXIMAL_EXT, ActionInfo, *From, *To, LerpVal);
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_INTERMEDIATE_EXT, ActionInfo, *From, *To, LerpVal);
+	BlendBone((int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_DISTAL_EXT, ActionInfo, *From, *To, LerpVal);
 }
 
 void FBPXRSkeletalRepContainer::CopyForReplication(FBPOpenXRActionSkeletalData& Other)
@@ -583,6 +694,7 @@ void FBPXRSkeletalRepContainer::CopyForReplication(FBPOpenXRActionSkeletalData&
 
 	bAllowDeformingMesh = Other.bAllowDeformingMesh;
 	bEnableUE4HandRepSavings = Other.bEnableUE4HandRepSavings;
+	CopyEncodingSettings(Other);
 
 	// Instead of doing this, we likely need to lerp but this is for testing
 	//SkeletalTransforms = Other.SkeletalData.SkeletalTransforms;
@@ -730,6 +842,608 @@ void FBPXRSkeletalRepContainer::CopyReplicatedTo(const FBPXRSkeletalRepContainer
 	Other.bHasValidData = true;
 }
 
+void FBPXRSkeletalRepContainer::CopyEncodingSettings(const FBPOpenXRActionSkeletalData& Other)
+{
+	RepEncoding = Other.RepEncoding;
+	QuantizedRotationBits = Other.QuantizedRotationBits;
+	bAllowCurlOnlyUpdates = Other.bAllowCurlOnlyUpdates;
+	CurlOnlyAngleTolerance = Other.CurlOnlyAngleTolerance;
+	CurlOnlyPositionTolerance = Other.CurlOnlyPositionTolerance;
+}
+
+namespace OpenXRHandRep
+{
+	constexpr int32 MinRotationBits = 6;
+	constexpr int32 MaxRotationBits = 10;
+
+	// Positions are relative to the palm, 12 bits at 0.2mm covers +-40cm
+	constexpr int32 PositionBits = 12;
+	constexpr int32 PositionBias = 1 << (PositionBits - 1);
+	constexpr float PositionScale = 50.0f;
+
+	constexpr int32 CurlBits = 8;
+	constexpr float CurlScale = 255.0f;
+
+	// Must be a power of two, deltas are always against the pose right before them so this only needs to cover the poses that can be in flight
+	constexpr int32 ReceivedPoseHistory = 16;
+
+	enum class EHandPacketType : uint8
+	{
+		Full = 0,
+		Delta = 1,
+		CurlOnly = 2
+	};
+
+	// Degrees that each curling joint bends for a full 0-1 curl, the inverse of the mapping in GetCurlValueForBones
+	static const float ThumbCurlRanges[2] = { 42.0f, 64.0f };
+	static const float FingerCurlRanges[2] = { 100.0f, 60.0f };
+
+	class FXRSkeletalRepDeltaState : public INetDeltaBaseState
+	{
+	public:
+
+		bool bLegacy;
+		FXRQuantizedHandPose Pose;
+
+		// Legacy updates are sent in full, we only keep them around to skip unchanged ones
+		TArray<uint8> LegacyData;
+		int64 LegacyNumBits;
+
+		FXRSkeletalRepDeltaState() :
+			bLegacy(false),
+			LegacyNumBits(0)
+		{}
+
+		bool IsSameState(const FXRSkeletalRepDeltaState& Other) const
+		{
+			if (bLegacy != Other.bLegacy)
+				return false;
+
+			if (bLegacy)
+				return LegacyNumBits == Other.LegacyNumBits && LegacyData == Other.LegacyData;
+
+			return Pose.IsSamePose(Other.Pose);
+		}
+
+		virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+		{
+			return OtherState && IsSameState(*static_cast<FXRSkeletalRepDeltaState*>(OtherState));
+		}
+	};
+
+	FORCEINLINE int32 GetTransformCount(const FBPXRSkeletalRepContainer& Container)
+	{
+		return EHandKeypointCount - (6 + (Container.bEnableUE4HandRepSavings ? 4 : 0));
+	}
+
+	FORCEINLINE int32 GetRotationBits(const FBPXRSkeletalRepContainer& Container)
+	{
+		return FMath::Clamp((int32)Container.QuantizedRotationBits, MinRotationBits, MaxRotationBits);
+	}
+
+	static uint8 MakeHeader(const FBPXRSkeletalRepContainer& Container, bool bHasValidData)
+	{
+		uint8 Header = (uint8)Container.TargetHand & 1;
+		Header |= (Container.bAllowDeformingMesh ? 1 : 0) << 1;
+		Header |= (Container.bEnableUE4HandRepSavings ? 1 : 0) << 2;
+		Header |= (bHasValidData ? 1 : 0) << 3;
+		Header |= ((Container.RepEncoding == EXRHandRepEncoding::OXR_HandRep_Quantized) ? 1 : 0) << 4;
+		Header |= ((GetRotationBits(Container) - MinRotationBits) & 7) << 5;
+		return Header;
+	}
+
+	static void ApplyHeader(FBPXRSkeletalRepContainer& Container, uint8 Header, bool& bOutHasValidData)
+	{
+		Container.TargetHand = (EVRSkeletalHandIndex)(Header & 1);
+		Container.bAllowDeformingMesh = (Header & (1 << 1)) != 0;
+		Container.bEnableUE4HandRepSavings = (Header & (1 << 2)) != 0;
+		bOutHasValidData = (Header & (1 << 3)) != 0;
+		Container.RepEncoding = (Header & (1 << 4)) ? EXRHandRepEncoding::OXR_HandRep_Quantized : EXRHandRepEncoding::OXR_HandRep_Legacy;
+		Container.QuantizedRotationBits = (uint8)(((Header >> 5) & 7) + MinRotationBits);
+	}
+
+	// Smallest three, the largest component is dropped and rebuilt from the other three which are all within +-1/sqrt(2)
+	static uint32 QuantizeRotation(const FQuat& InRotation, int32 Bits)
+	{
+		const FQuat Rotation = InRotation.GetNormalized();
+		const float Components[4] = { (float)Rotation.X, (float)Rotation.Y, (float)Rotation.Z, (float)Rotation.W };
+
+		int32 Largest = 0;
+		for (int32 i = 1; i < 4; ++i)
+		{
+			if (FMath::Abs(Components[i]) > FMath::Abs(Components[Largest]))
+				Largest = i;
+		}
+
+		// q and -q are the same rotation, flip so that the dropped component is always positive
+		const float Sign = Components[Largest] < 0.0f ? -1.0f : 1.0f;
+		const uint32 MaxValue = (1u << Bits) - 1;
+
+		uint32 Packed = (uint32)Largest;
+		int32 Shift = 2;
+		for (int32 i = 0; i < 4; ++i)
+		{
+			if (i == Largest)
+				continue;
+
+			const float Normalized = FMath::Clamp((Components[i] * Sign * UE_SQRT_2 + 1.0f) * 0.5f, 0.0f, 1.0f);
+			Packed |= ((uint32)FMath::RoundToInt(Normalized * MaxValue)) << Shift;
+			Shift += Bits;
+		}
+
+		return Packed;
+	}
+
+	static FQuat DequantizeRotation(uint32 Packed, int32 Bits)
+	{
+		const uint32 MaxValue = (1u << Bits) - 1;
+		const int32 Largest = Packed & 3;
+
+		float Components[4];
+		float SumSquared = 0.0f;
+		int32 Shift = 2;
+		for (int32 i = 0; i < 4; ++i)
+		{
+			if (i == Largest)
+				continue;
+
+			const uint32 Value = (Packed >> Shift) & MaxValue;
+			Components[i] = (((float)Value / MaxValue) * 2.0f - 1.0f) * UE_INV_SQRT_2;
+			SumSquared += FMath::Square(Components[i]);
+			Shift += Bits;
+		}
+
+		Components[Largest] = FMath::Sqrt(FMath::Max(0.0f, 1.0f - SumSquared));
+		return FQuat(Components[0], Components[1], Components[2], Components[3]).GetNormalized();
+	}
+
+	static void QuantizePose(const TArray<FTransform>& Transforms, int32 TransformCount, int32 Bits, bool bDeform, FXRQuantizedHandPose& OutPose)
+	{
+		OutPose.Rotations.SetNumUninitialized(TransformCount);
+		OutPose.Positions.SetNumUninitialized(bDeform ? TransformCount * 3 : 0);
+
+		for (int32 i = 0; i < TransformCount; ++i)
+		{
+			OutPose.Rotations[i] = QuantizeRotation(Transforms[i].GetRotation(), Bits);
+
+			if (bDeform)
+			{
+				const FVector Location = Transforms[i].GetLocation();
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					OutPose.Positions[i * 3 + Axis] = (int16)FMath::Clamp(FMath::RoundToInt(Location[Axis] * PositionScale), -PositionBias, PositionBias - 1);
+				}
+			}
+		}
+	}
+
+	static void DequantizePose(const FXRQuantizedHandPose& Pose, int32 Bits, bool bDeform, TArray<FTransform>& OutTransforms)
+	{
+		const int32 TransformCount = Pose.Rotations.Num();
+		OutTransforms.Reset(TransformCount);
+
+		for (int32 i = 0; i < TransformCount; ++i)
+		{
+			FVector Location = FVector::ZeroVector;
+			if (bDeform && Pose.Positions.Num() >= (i + 1) * 3)
+			{
+				Location = FVector(Pose.Positions[i * 3], Pose.Positions[i * 3 + 1], Pose.Positions[i * 3 + 2]) / PositionScale;
+			}
+
+			OutTransforms.Add(FTransform(DequantizeRotation(Pose.Rotations[i], Bits), Location));
+		}
+	}
+
+	static void SerializeJoint(FArchive& Ar, FXRQuantizedHandPose& Pose, int32 Index, int32 Bits, bool bDeform)
+	{
+		uint32 Packed = Ar.IsSaving() ? Pose.Rotations[Index] : 0;
+		Ar.SerializeBits(&Packed, 2 + (3 * Bits));
+
+		if (Ar.IsLoading())
+			Pose.Rotations[Index] = Packed;
+
+		if (bDeform)
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				uint16 Biased = Ar.IsSaving() ? (uint16)(Pose.Positions[Index * 3 + Axis] + PositionBias) : 0;
+				Ar.SerializeBits(&Biased, PositionBits);
+
+				if (Ar.IsLoading())
+					Pose.Positions[Index * 3 + Axis] = (int16)((int32)Biased - PositionBias);
+			}
+		}
+	}
+
+	// With bIsDelta each joint gets an unchanged bit and unchanged joints are taken from the baseline (if we have it when loading)
+	static void SerializeJoints(FArchive& Ar, FXRQuantizedHandPose& Pose, int32 TransformCount, int32 Bits, bool bDeform, bool bIsDelta, const FXRQuantizedHandPose* Baseline)
+	{
+		if (Ar.IsLoading())
+		{
+			Pose.Rotations.SetNumZeroed(TransformCount);
+			Pose.Positions.SetNumZeroed(bDeform ? TransformCount * 3 : 0);
+		}
+
+		for (int32 i = 0; i < TransformCount; ++i)
+		{
+			bool bChanged = true;
+
+			if (bIsDelta)
+			{
+				if (Ar.IsSaving())
+				{
+					bChanged = Pose.Rotations[i] != Baseline->Rotations[i];
+					for (int32 Axis = 0; bDeform && !bChanged && Axis < 3; ++Axis)
+					{
+						bChanged = Pose.Positions[i * 3 + Axis] != Baseline->Positions[i * 3 + Axis];
+					}
+				}
+
+				Ar.SerializeBits(&bChanged, 1);
+			}
+
+			if (bChanged)
+			{
+				SerializeJoint(Ar, Pose, i, Bits, bDeform);
+			}
+			else if (Ar.IsLoading() && Baseline)
+			{
+				Pose.Rotations[i] = Baseline->Rotations[i];
+				for (int32 Axis = 0; bDeform && Axis < 3; ++Axis)
+				{
+					Pose.Positions[i * 3 + Axis] = Baseline->Positions[i * 3 + Axis];
+				}
+			}
+		}
+	}
+
+	// Compact indices of the three curling bones of each finger, thumb first
+	static void GetFingerChains(bool bEnableUE4HandRepSavings, int32 OutChains[5][3])
+	{
+		OutChains[0][0] = 1;
+		OutChains[0][1] = 2;
+		OutChains[0][2] = 3;
+
+		for (int32 Finger = 1; Finger < 5; ++Finger)
+		{
+			// Skipping the metacarpal, it isn't sent at all with the UE4 savings
+			const int32 Root = bEnableUE4HandRepSavings ? (3 * Finger + 1) : (4 * Finger + 1);
+			OutChains[Finger][0] = Root;
+			OutChains[Finger][1] = Root + 1;
+			OutChains[Finger][2] = Root + 2;
+		}
+	}
+
+	static void GetCurls(const TArray<FTransform>& Transforms, bool bEnableUE4HandRepSavings, float OutCurls[5])
+	{
+		int32 Chains[5][3];
+		GetFingerChains(bEnableUE4HandRepSavings, Chains);
+
+		for (int32 Finger = 0; Finger < 5; ++Finger)
+		{
+			OutCurls[Finger] = UOpenXRExpansionFunctionLibrary::GetCurlValueForBones(
+				Transforms[Chains[Finger][0]].GetRotation(),
+				Transforms[Chains[Finger][1]].GetRotation(),
+				Transforms[Chains[Finger][2]].GetRotation(),
+				Finger == 0);
+		}
+	}
+
+	// Bends the last two bones of each finger by the change in curl, the first bone and the finger lengths are kept from the baseline
+	static void ApplyCurlModel(TArray<FTransform>& Transforms, const float BaseCurls[5], const float NewCurls[5], bool bEnableUE4HandRepSavings, bool bLeftHand)
+	{
+		int32 Chains[5][3];
+		GetFingerChains(bEnableUE4HandRepSavings, Chains);
+
+		for (int32 Finger = 0; Finger < 5; ++Finger)
+		{
+			const float CurlDelta = NewCurls[Finger] - BaseCurls[Finger];
+			if (FMath::IsNearlyZero(CurlDelta))
+				continue;
+
+			const bool bIsThumb = Finger == 0;
+			const float* Ranges = bIsThumb ? ThumbCurlRanges : FingerCurlRanges;
+			const FVector Axis = bIsThumb ? FVector::UpVector : FVector::RightVector;
+
+			FTransform& Root = Transforms[Chains[Finger][0]];
+			FTransform& Middle = Transforms[Chains[Finger][1]];
+			FTransform& End = Transforms[Chains[Finger][2]];
+
+			// Keep bending the way that the finger is already bent, a straight finger uses the default flex direction
+			float Sign = (bIsThumb && bLeftHand) ? -1.0f : 1.0f;
+			const FVector Bend = FVector::CrossProduct(
+				FVector::VectorPlaneProject(Root.GetRotation().GetForwardVector(), Axis),
+				FVector::VectorPlaneProject(Middle.GetRotation().GetForwardVector(), Axis));
+
+			if (Bend.SizeSquared() > UE_KINDA_SMALL_NUMBER)
+			{
+				Sign = FVector::DotProduct(Bend, Axis) >= 0.0f ? 1.0f : -1.0f;
+			}
+
+			const FQuat MiddleDelta(Axis * Sign, FMath::DegreesToRadians(Ranges[0] * CurlDelta));
+			const FQuat EndDelta(Axis * Sign, FMath::DegreesToRadians((Ranges[0] + Ranges[1]) * CurlDelta));
+
+			const FVector EndOffset = End.GetLocation() - Middle.GetLocation();
+			Middle.SetRotation((MiddleDelta * Middle.GetRotation()).GetNormalized());
+			End.SetRotation((EndDelta * End.GetRotation()).GetNormalized());
+			End.SetLocation(Middle.GetLocation() + MiddleDelta.RotateVector(EndOffset));
+		}
+	}
+
+	// Same on both ends so that the sender can use the result as the next baseline
+	static void RebuildFromCurls(const FXRQuantizedHandPose& Baseline, const FXRQuantizedHandPose& Wrist, const uint8 Curls[5], int32 Bits, bool bDeform, bool bEnableUE4HandRepSavings, bool bLeftHand, FXRQuantizedHandPose& OutPose)
+	{
+		TArray<FTransform> Transforms;
+		DequantizePose(Baseline, Bits, bDeform, Transforms);
+
+		float BaseCurls[5];
+		float NewCurls[5];
+		GetCurls(Transforms, bEnableUE4HandRepSavings, BaseCurls);
+
+		for (int32 Finger = 0; Finger < 5; ++Finger)
+		{
+			NewCurls[Finger] = Curls[Finger] / CurlScale;
+		}
+
+		ApplyCurlModel(Transforms, BaseCurls, NewCurls, bEnableUE4HandRepSavings, bLeftHand);
+		QuantizePose(Transforms, Transforms.Num(), Bits, bDeform, OutPose);
+
+		// The wrist is sent as is
+		OutPose.Rotations[0] = Wrist.Rotations[0];
+		for (int32 Axis = 0; bDeform && Axis < 3; ++Axis)
+		{
+			OutPose.Positions[Axis] = Wrist.Positions[Axis];
+		}
+	}
+
+	static bool IsWithinTolerance(const TArray<FTransform>& Rebuilt, const TArray<FTransform>& Actual, int32 TransformCount, float AngleTolerance, float PositionTolerance, bool bDeform)
+	{
+		const float AngleToleranceRad = FMath::DegreesToRadians(AngleTolerance);
+		const float PositionToleranceSq = FMath::Square(PositionTolerance);
+
+		for (int32 i = 0; i < TransformCount; ++i)
+		{
+			if (Rebuilt[i].GetRotation().AngularDistance(Actual[i].GetRotation()) > AngleToleranceRad)
+				return false;
+
+			if (bDeform && FVector::DistSquared(Rebuilt[i].GetLocation(), Actual[i].GetLocation()) > PositionToleranceSq)
+				return false;
+		}
+
+		return true;
+	}
+
+	static const FXRQuantizedHandPose* FindReceivedPose(const FBPXRSkeletalRepContainer& Container, uint8 PoseId, uint8 Header)
+	{
+		const int32 Slot = PoseId & (ReceivedPoseHistory - 1);
+		if (Container.ReceivedPoses.IsValidIndex(Slot))
+		{
+			const FXRQuantizedHandPose& Pose = Container.ReceivedPoses[Slot];
+			if (Pose.PoseId == PoseId && Pose.Header == Header && Pose.Rotations.Num() > 0)
+				return &Pose;
+		}
+
+		return nullptr;
+	}
+
+	static bool DeltaWrite(FBPXRSkeletalRepContainer& Container, FNetDeltaSerializeInfo& DeltaParms)
+	{
+		FBitWriter& Writer = *DeltaParms.Writer;
+		const FXRSkeletalRepDeltaState* OldState = static_cast<const FXRSkeletalRepDeltaState*>(DeltaParms.OldState);
+
+		TSharedPtr<FXRSkeletalRepDeltaState> NewState = MakeShared<FXRSkeletalRepDeltaState>();
+		*DeltaParms.NewState = NewState;
+
+		bool bQuantized = Container.RepEncoding == EXRHandRepEncoding::OXR_HandRep_Quantized;
+
+		if (!bQuantized)
+		{
+			FBitWriter LegacyWriter(0, true);
+			bool bSuccess = true;
+			Container.NetSerialize(LegacyWriter, DeltaParms.Map, bSuccess);
+
+			NewState->bLegacy = true;
+			NewState->LegacyNumBits = LegacyWriter.GetNumBits();
+			NewState->LegacyData = *LegacyWriter.GetBuffer();
+
+			if (OldState && OldState->IsSameState(*NewState))
+				return false;
+
+			Writer.SerializeBits(&bQuantized, 1);
+			Writer.SerializeBits(LegacyWriter.GetData(), LegacyWriter.GetNumBits());
+			return true;
+		}
+
+		const int32 TransformCount = GetTransformCount(Container);
+		const int32 Bits = GetRotationBits(Container);
+		const bool bDeform = Container.bAllowDeformingMesh;
+		const bool bHasValidData = Container.SkeletalTransforms.Num() >= TransformCount;
+
+		FXRQuantizedHandPose& Pose = NewState->Pose;
+		Pose.Header = MakeHeader(Container, bHasValidData);
+
+		if (bHasValidData)
+		{
+			QuantizePose(Container.SkeletalTransforms, TransformCount, Bits, bDeform, Pose);
+		}
+
+		if (OldState && OldState->IsSameState(*NewState))
+		{
+			// Keep the old id, the receiver already has this pose
+			Pose.PoseId = OldState->Pose.PoseId;
+			return false;
+		}
+
+		Pose.PoseId = OldState ? (uint8)(OldState->Pose.PoseId + 1) : 0;
+
+		// Deltas are against the last sent pose, the net driver only rolls the old state back when a packet is NAKed so
+		// deltas already in flight behind a lost one arrive without their baseline and are dropped by the receiver
+		const FXRQuantizedHandPose* Baseline = (bHasValidData && OldState && !OldState->bLegacy && OldState->Pose.Header == Pose.Header) ? &OldState->Pose : nullptr;
+
+		EHandPacketType PacketType = Baseline ? EHandPacketType::Delta : EHandPacketType::Full;
+		uint8 Curls[5];
+
+		if (Baseline && Container.bAllowCurlOnlyUpdates)
+		{
+			float ActualCurls[5];
+			GetCurls(Container.SkeletalTransforms, Container.bEnableUE4HandRepSavings, ActualCurls);
+
+			for (int32 Finger = 0; Finger < 5; ++Finger)
+			{
+				Curls[Finger] = (uint8)FMath::RoundToInt(FMath::Clamp(ActualCurls[Finger], 0.0f, 1.0f) * CurlScale);
+			}
+
+			FXRQuantizedHandPose RebuiltPose;
+			RebuildFromCurls(*Baseline, Pose, Curls, Bits, bDeform, Container.bEnableUE4HandRepSavings, Container.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left, RebuiltPose);
+
+			TArray<FTransform> RebuiltTransforms;
+			DequantizePose(RebuiltPose, Bits, bDeform, RebuiltTransforms);
+
+			if (IsWithinTolerance(RebuiltTransforms, Container.SkeletalTransforms, TransformCount, Container.CurlOnlyAngleTolerance, Container.CurlOnlyPositionTolerance, bDeform))
+			{
+				// The receiver ends up with the rebuilt pose, so that is our next baseline
+				RebuiltPose.PoseId = Pose.PoseId;
+				RebuiltPose.Header = Pose.Header;
+				Pose = MoveTemp(RebuiltPose);
+				PacketType = EHandPacketType::CurlOnly;
+			}
+		}
+
+		Writer.SerializeBits(&bQuantized, 1);
+		Writer.SerializeBits(&Pose.Header, 8);
+		Writer.SerializeBits(&Pose.PoseId, 8);
+
+		if (!bHasValidData)
+			return true;
+
+		uint8 PacketTypeBits = (uint8)PacketType;
+		Writer.SerializeBits(&PacketTypeBits, 2);
+
+		switch (PacketType)
+		{
+		case EHandPacketType::Full:
+		{
+			SerializeJoints(Writer, Pose, TransformCount, Bits, bDeform, false, nullptr);
+		}break;
+		case EHandPacketType::Delta:
+		{
+			SerializeJoints(Writer, Pose, TransformCount, Bits, bDeform, true, Baseline);
+		}break;
+		case EHandPacketType::CurlOnly:
+		{
+			SerializeJoint(Writer, Pose, 0, Bits, bDeform);
+			for (int32 Finger = 0; Finger < 5; ++Finger)
+			{
+				Writer.SerializeBits(&Curls[Finger], CurlBits);
+			}
+		}break;
+		}
+
+		return true;
+	}
+
+	static bool DeltaRead(FBPXRSkeletalRepContainer& Container, FNetDeltaSerializeInfo& DeltaParms)
+	{
+		FBitReader& Reader = *DeltaParms.Reader;
+
+		bool bQuantized = false;
+		Reader.SerializeBits(&bQuantized, 1);
+
+		if (!bQuantized)
+		{
+			// Anything after this is a full update again
+			Container.ReceivedPoses.Reset();
+
+			bool bSuccess = true;
+			Container.NetSerialize(Reader, DeltaParms.Map, bSuccess);
+			return bSuccess && !Reader.IsError();
+		}
+
+		FXRQuantizedHandPose Pose;
+		Reader.SerializeBits(&Pose.Header, 8);
+		Reader.SerializeBits(&Pose.PoseId, 8);
+
+		bool bHasValidData = false;
+		ApplyHeader(Container, Pose.Header, bHasValidData);
+
+		if (!bHasValidData)
+		{
+			Container.SkeletalTransforms.Reset();
+			return !Reader.IsError();
+		}
+
+		const int32 TransformCount = GetTransformCount(Container);
+		const int32 Bits = GetRotationBits(Container);
+		const bool bDeform = Container.bAllowDeformingMesh;
+
+		uint8 PacketTypeBits = 0;
+		Reader.SerializeBits(&PacketTypeBits, 2);
+		const EHandPacketType PacketType = (EHandPacketType)PacketTypeBits;
+
+		const FXRQuantizedHandPose* Baseline = nullptr;
+		if (PacketType != EHandPacketType::Full)
+		{
+			Baseline = FindReceivedPose(Container, (uint8)(Pose.PoseId - 1), Pose.Header);
+		}
+
+		switch (PacketType)
+		{
+		case EHandPacketType::Full:
+		{
+			SerializeJoints(Reader, Pose, TransformCount, Bits, bDeform, false, nullptr);
+		}break;
+		case EHandPacketType::Delta:
+		{
+			SerializeJoints(Reader, Pose, TransformCount, Bits, bDeform, true, Baseline);
+		}break;
+		case EHandPacketType::CurlOnly:
+		{
+			FXRQuantizedHandPose Wrist;
+			Wrist.Rotations.SetNumZeroed(1);
+			Wrist.Positions.SetNumZeroed(bDeform ? 3 : 0);
+			SerializeJoint(Reader, Wrist, 0, Bits, bDeform);
+
+			uint8 Curls[5] = { 0, 0, 0, 0, 0 };
+			for (int32 Finger = 0; Finger < 5; ++Finger)
+			{
+				Reader.SerializeBits(&Curls[Finger], CurlBits);
+			}
+
+			if (Baseline)
+			{
+				const uint8 PoseId = Pose.PoseId;
+				RebuildFromCurls(*Baseline, Wrist, Curls, Bits, bDeform, Container.bEnableUE4HandRepSavings, Container.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left, Pose);
+				Pose.PoseId = PoseId;
+			}
+		}break;
+		default:
+		{
+			Reader.SetError();
+		}break;
+		}
+
+		if (Reader.IsError())
+			return false;
+
+		if (PacketType != EHandPacketType::Full && !Baseline)
+		{
+			// The baseline was in a lost packet, keep the last pose until the sender rolls back to one we have
+			UE_LOG(OpenXRExpansionFunctionLibraryLog, Verbose, TEXT("FBPXRSkeletalRepContainer received a delta against pose %d which we don't have, skipping it."), (int32)(uint8)(Pose.PoseId - 1));
+			return true;
+		}
+
+		DequantizePose(Pose, Bits, bDeform, Container.SkeletalTransforms);
+
+		if (Container.ReceivedPoses.Num() != ReceivedPoseHistory)
+		{
+			Container.ReceivedPoses.SetNum(ReceivedPoseHistory);
+		}
+
+		Container.ReceivedPoses[Pose.PoseId & (ReceivedPoseHistory - 1)] = MoveTemp(Pose);
+		return true;
+	}
+}
+
 bool FBPXRSkeletalRepContainer::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
 	bOutSuccess = true;
@@ -744,6 +1458,51 @@ bool FBPXRSkeletalRepContainer::NetSerialize(FArchive& Ar, class UPackageMap* Ma
 	bool bHasValidData = SkeletalTransforms.Num() >= TransformCount;
 	Ar.SerializeBits(&bHasValidData, 1);
 
+	bool bQuantized = RepEncoding == EXRHandRepEncoding::OXR_HandRep_Quantized;
+	Ar.SerializeBits(&bQuantized, 1);
+
+	if (bQuantized)
+	{
+		// No acked baseline for the RPC, so this is always the full pose
+		uint8 RotationBits = (uint8)(OpenXRHandRep::GetRotationBits(*this) - OpenXRHandRep::MinRotationBits);
+		Ar.SerializeBits(&RotationBits, 3);
+
+		if (Ar.IsLoading())
+		{
+			RepEncoding = EXRHandRepEncoding::OXR_HandRep_Quantized;
+			QuantizedRotationBits = RotationBits + OpenXRHandRep::MinRotationBits;
+		}
+
+		const int32 Bits = OpenXRHandRep::GetRotationBits(*this);
+
+		if (!bHasValidData)
+		{
+			if (Ar.IsLoading())
+				SkeletalTransforms.Reset();
+
+			return bOutSuccess;
+		}
+
+		FXRQuantizedHandPose Pose;
+		if (Ar.IsSaving())
+		{
+			OpenXRHandRep::QuantizePose(SkeletalTransforms, TransformCount, Bits, bAllowDeformingMesh, Pose);
+		}
+
+		OpenXRHandRep::SerializeJoints(Ar, Pose, TransformCount, Bits, bAllowDeformingMesh, false, nullptr);
+
+		if (Ar.IsLoading())
+		{
+			OpenXRHandRep::DequantizePose(Pose, Bits, bAllowDeformingMesh, SkeletalTransforms);
+		}
+
+		return bOutSuccess;
+	}
+	else if (Ar.IsLoading())
+	{
+		RepEncoding = EXRHandRepEncoding::OXR_HandRep_Legacy;
+	}
+
 	//Ar << TransformCount;
 
 	if (Ar.IsLoading())
@@ -784,6 +1543,24 @@ bool FBPXRSkeletalRepContainer::NetSerialize(FArchive& Ar, class UPackageMap* Ma
 	return bOutSuccess;
 }
 
+bool FBPXRSkeletalRepContainer::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	// Nothing in here references objects
+	if (DeltaParms.GatherGuidReferences || DeltaParms.MoveGuidToUnmapped || DeltaParms.bUpdateUnmappedObjects)
+		return false;
+
+	if (DeltaParms.Writer)
+	{
+		return OpenXRHandRep::DeltaWrite(*this, DeltaParms);
+	}
+	else if (DeltaParms.Reader)
+	{
+		return OpenXRHandRep::DeltaRead(*this, DeltaParms);
+	}
+
+	return false;
+}
+
 void UOpenXRAnimInstance::NativeBeginPlay()
 {
 	Super::NativeBeginPlay();
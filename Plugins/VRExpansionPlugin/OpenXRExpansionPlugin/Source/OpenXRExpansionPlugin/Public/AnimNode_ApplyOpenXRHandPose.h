@@ -10,6 +10,20 @@
 #include "AnimNode_ApplyOpenXRHandPose.generated.h"
 
 
+// A mapped bone resolved against the current required bones
+struct FOpenXRHandBoneRemap
+{
+	FCompactPoseBoneIndex BoneIndex;
+	FCompactPoseBoneIndex ParentIndex;
+	uint8 OpenXRBone;
+
+	FOpenXRHandBoneRemap(FCompactPoseBoneIndex InBoneIndex, FCompactPoseBoneIndex InParentIndex, uint8 InOpenXRBone) :
+		BoneIndex(InBoneIndex),
+		ParentIndex(InParentIndex),
+		OpenXRBone(InOpenXRBone)
+	{}
+};
+
 USTRUCT()
 struct OPENXREXPANSIONPLUGIN_API FAnimNode_ApplyOpenXRHandPose : public FAnimNode_SkeletalControlBase
 {
@@ -44,7 +58,11 @@ public:
 
 	bool bIsOpenInputAnimationInstance;
 
-	void ConvertHandTransformsSpace(TArray<FTransform>& OutTransforms, const TArray<FTransform>& WorldTransforms, FTransform AddTrans, bool bMirrorLeftRight, bool bMergeMissingUE4Bones);
+	// JointMask limits the conversion to the set bits, parents of converted joints need to be in it as well
+	void ConvertHandTransformsSpace(TArray<FTransform>& OutTransforms, const TArray<FTransform>& WorldTransforms, FTransform AddTrans, bool bMirrorLeftRight, bool bMergeMissingUE4Bones, uint32 JointMask = MAX_uint32);
+
+	// Rebuilds BoneRemap from MappedBonePairs, needs to run whenever the required bones change
+	void RebuildBoneRemap(const FBoneContainer& RequiredBones);
 
 	void CalculateSkeletalAdjustment(USkeleton* AssetSkeleton);
 	void CalculateOpenXRAdjustment();
@@ -116,5 +134,16 @@ protected:
 	bool WorldIsGame;
 	AActor* OwningActor;
 
+	// Mapped bones that are in the current required bones, in mapping order so that parents come first
+	TArray<FOpenXRHandBoneRemap> BoneRemap;
+
+	// Joints that have to be converted for the remapped bones, including the ones they are relative to
+	uint32 RequiredJointMask;
+
+	// Kept between evaluations so that we aren't allocating every frame
+	TArray<FTransform> ScratchWorldTransforms;
+	TArray<FTransform> ScratchHandTransforms;
+	TArray<FBoneTransform> ScratchBoneTransforms;
+
 private:
 };
\ No newline at end of file
@@ -89,6 +89,9 @@ public:
 
 	static float GetCurlValueForBoneRoot(TArray<FTransform>& TransformArray, EHandKeypoint RootBone);
 
+	// Curl of a single finger from the rotations of its three curling bones (metacarpal, proximal and distal for the thumb)
+	static float GetCurlValueForBones(const FQuat& ProxRot, const FQuat& InterRot, const FQuat& DistalRot, bool bIsThumb);
+
 	//UFUNCTION(BlueprintCallable, Category = "VRExpansionFunctions|OpenXR", meta = (bIgnoreSelf = "true"))
 	static void ConvertHandTransformsSpaceAndBack(TArray<FTransform>& OutTransforms, const TArray<FTransform>& WorldTransforms);
 
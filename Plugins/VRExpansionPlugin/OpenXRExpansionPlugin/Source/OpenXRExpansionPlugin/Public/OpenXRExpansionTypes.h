@@ -85,6 +85,16 @@ enum class EVROpenXRSkeletonType : uint8
 	OXR_SkeletonType_Custom
 };
 
+UENUM(BlueprintType)
+enum class EXRHandRepEncoding : uint8
+{
+	// Compressed rotators for every bone (and packed positions if deforming) on every update
+	OXR_HandRep_Legacy,
+	// Smallest three quaternions with configurable precision
+	// Replicated property updates only send the bones that changed since the last acked pose and can fall back to only sending finger curls
+	OXR_HandRep_Quantized
+};
+
 
 
 USTRUCT(BlueprintType, Category = "VRExpansionFunctions|OpenXR|HandSkeleton")
@@ -119,6 +129,26 @@ public:
 	UPROPERTY(EditAnywhere, NotReplicated, BlueprintReadWrite, Category = Default)
 		bool bEnableUE4HandRepSavings;
 
+	// How this hand is encoded when it is replicated
+	UPROPERTY(EditAnywhere, NotReplicated, BlueprintReadWrite, Category = Default)
+		EXRHandRepEncoding RepEncoding;
+
+	// Bits per quaternion component when using the quantized encoding, 2 extra bits per bone select the dropped component
+	UPROPERTY(EditAnywhere, NotReplicated, BlueprintReadWrite, Category = Default, meta = (ClampMin = "6", ClampMax = "10", UIMin = "6", UIMax = "10"))
+		uint8 QuantizedRotationBits;
+
+	// If true then replicated updates that can be rebuilt from the last acked pose and the finger curls within tolerance only send the wrist and the curls
+	UPROPERTY(EditAnywhere, NotReplicated, BlueprintReadWrite, Category = Default)
+		bool bAllowCurlOnlyUpdates;
+
+	// Max rotation error in degrees of any bone for a curl only update
+	UPROPERTY(EditAnywhere, NotReplicated, BlueprintReadWrite, Category = Default, meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float CurlOnlyAngleTolerance;
+
+	// Max position error in cm of any bone for a curl only update, only used with bAllowDeformingMesh
+	UPROPERTY(EditAnywhere, NotReplicated, BlueprintReadWrite, Category = Default, meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float CurlOnlyPositionTolerance;
+
 	//UPROPERTY(BlueprintReadOnly, NotReplicated, Transient, Category = Default)
 		//TArray<FTransform> OldSkeletalTransforms;
 
@@ -133,6 +163,7 @@ public:
 
 	FName LastHandGesture;
 	int32 LastHandGestureIndex;
+	float LastHandGestureScore;
 
 	FBPOpenXRActionSkeletalData()
 	{
@@ -142,10 +173,16 @@ public:
 		bAllowDeformingMesh = true;
 		bMirrorLeftRight = false;
 		bEnableUE4HandRepSavings = false;
+		RepEncoding = EXRHandRepEncoding::OXR_HandRep_Legacy;
+		QuantizedRotationBits = 9;
+		bAllowCurlOnlyUpdates = false;
+		CurlOnlyAngleTolerance = 4.0f;
+		CurlOnlyPositionTolerance = 0.3f;
 		TargetHand = EVRSkeletalHandIndex::EActionHandIndex_Right;
 		bHasValidData = false;
 		LastHandGestureIndex = INDEX_NONE;
 		LastHandGesture = NAME_None;
+		LastHandGestureScore = 0.0f;
 	}
 };
 
@@ -14,6 +14,34 @@
 
 #include "OpenXRHandPoseComponent.generated.h"
 
+struct FNetDeltaSerializeInfo;
+
+// Hand pose quantized with the EXRHandRepEncoding::OXR_HandRep_Quantized encoding, used as the baseline for delta updates
+struct OPENXREXPANSIONPLUGIN_API FXRQuantizedHandPose
+{
+	// Rolling id of this pose, deltas are always against the pose before them
+	uint8 PoseId;
+
+	// Packed header bits (hand, flags, encoding, precision), baselines are only valid with the same header
+	uint8 Header;
+
+	// Smallest three rotations, 2 bits for the dropped component and then 3 * QuantizedRotationBits
+	TArray<uint32> Rotations;
+
+	// X,Y,Z per bone, only filled in with bAllowDeformingMesh
+	TArray<int16> Positions;
+
+	FXRQuantizedHandPose() :
+		PoseId(0),
+		Header(0)
+	{}
+
+	bool IsSamePose(const FXRQuantizedHandPose& Other) const
+	{
+		return Header == Other.Header && Rotations == Other.Rotations && Positions == Other.Positions;
+	}
+};
+
 USTRUCT(BlueprintType, Category = "VRExpansionFunctions|OpenXR|HandSkeleton")
 struct OPENXREXPANSIONPLUGIN_API FBPXRSkeletalRepContainer
 {
@@ -37,6 +65,24 @@ public:
 	UPROPERTY(Transient, NotReplicated)
 		uint8 BoneCount;
 
+	UPROPERTY(Transient, NotReplicated)
+		EXRHandRepEncoding RepEncoding;
+
+	UPROPERTY(Transient, NotReplicated)
+		uint8 QuantizedRotationBits;
+
+	// Curl only settings are only needed by the sender, they are not serialized
+	UPROPERTY(Transient, NotReplicated)
+		bool bAllowCurlOnlyUpdates;
+
+	UPROPERTY(Transient, NotReplicated)
+		float CurlOnlyAngleTolerance;
+
+	UPROPERTY(Transient, NotReplicated)
+		float CurlOnlyPositionTolerance;
+
+	// Last poses received as a replicated property, indexed by PoseId, delta updates are rebuilt from these
+	TArray<FXRQuantizedHandPose> ReceivedPoses;
 
 	FBPXRSkeletalRepContainer()
 	{
@@ -44,6 +90,11 @@ public:
 		bAllowDeformingMesh = false;
 		bEnableUE4HandRepSavings = false;
 		BoneCount = 0;
+		RepEncoding = EXRHandRepEncoding::OXR_HandRep_Legacy;
+		QuantizedRotationBits = 9;
+		bAllowCurlOnlyUpdates = false;
+		CurlOnlyAngleTolerance = 4.0f;
+		CurlOnlyPositionTolerance = 0.3f;
 	}
 
 	bool bHasValidData()
@@ -54,15 +105,25 @@ public:
 	void CopyForReplication(FBPOpenXRActionSkeletalData& Other);
 	static void CopyReplicatedTo(const FBPXRSkeletalRepContainer& Container, FBPOpenXRActionSkeletalData& Other);
 
+	// Copies the encoding settings of the hand, the server calls this after receiving the hand from the owner
+	void CopyEncodingSettings(const FBPOpenXRActionSkeletalData& Other);
+
+	// Used for the RPC, always sends the full pose
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	// Used for the replicated property, with the quantized encoding only sends bones that changed since the last sent pose
+	// The legacy encoding also goes through here, it is sent in full but skipped when it matches the last sent state
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
 };
 
+// WithNetDeltaSerializer applies to every encoding, so the default legacy one replicates through NetDeltaSerialize as well
 template<>
 struct TStructOpsTypeTraits< FBPXRSkeletalRepContainer > : public TStructOpsTypeTraitsBase2<FBPXRSkeletalRepContainer>
 {
 	enum
 	{
-		WithNetSerializer = true
+		WithNetSerializer = true,
+		WithNetDeltaSerializer = true
 	};
 };
 
@@ -128,6 +189,37 @@ public:
 	}
 };
 
+// Gesture finger targets packed per finger and axis so that the matcher can test four gestures at a time
+struct OPENXREXPANSIONPLUGIN_API FOpenXRCompiledGestureTable
+{
+	// Number of gestures compiled, the streams are padded to a multiple of 4 with gestures that never match
+	int32 NumGestures;
+	int32 NumPadded;
+
+	// Finger tip target per [Finger * 3 + Axis][Gesture]
+	TArray<float, TAlignedHeapAllocator<16>> Targets[15];
+
+	// 1 / Threshold per [Finger][Gesture], 0 for fingers that are ignored (threshold of 0)
+	TArray<float, TAlignedHeapAllocator<16>> InvThresholds[5];
+
+	// Starting score per gesture, MAX_flt for gestures that can't be matched
+	TArray<float, TAlignedHeapAllocator<16>> BaseScores;
+
+	FOpenXRCompiledGestureTable() :
+		NumGestures(0),
+		NumPadded(0)
+	{}
+
+	void Compile(const TArray<FOpenXRGesture>& Gestures);
+
+	// Score is the largest finger offset relative to its threshold, so <= 1.0 is within all of the gestures thresholds
+	// Tips are relative to the wrist and in right hand space
+	float ScoreGesture(int32 GestureIndex, const FVector3f Tips[5]) const;
+
+	// Returns the matching gesture with the lowest score or INDEX_NONE
+	int32 FindBestMatch(const FVector3f Tips[5], float& OutScore) const;
+};
+
 /**
 * Items Database DataAsset, here we can save all of our game items
 */
@@ -144,6 +236,23 @@ public:
 	UOpenXRGestureDatabase()
 	{
 	}
+
+	// Rebuilds the table used for matching, needs to be called if gesture values are changed at runtime
+	// Adding and removing gestures is picked up automatically
+	UFUNCTION(BlueprintCallable, Category = "VRGestures")
+		void RecompileGestures();
+
+	const FOpenXRCompiledGestureTable& GetCompiledGestures();
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+
+	FOpenXRCompiledGestureTable CompiledGestures;
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOpenXRGestureDetected, const FName &, GestureDetected, int32, GestureIndex, EVRSkeletalHandIndex, ActionHandType);
@@ -180,9 +289,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "VRGestures")
 		bool SaveCurrentPose(FName RecordingName, EVRSkeletalHandIndex HandToSave = EVRSkeletalHandIndex::EActionHandIndex_Right);
 
+	// Scales the thresholds of the currently detected gesture by 1 + this, so that a gesture has to be left by a bit more than it was entered by
+	// While the current gesture is still in range the other gestures are not checked
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "1.0"))
+		float GestureHysteresis;
+
 	UFUNCTION(BlueprintCallable, Category = "VRGestures", meta = (DisplayName = "DetectCurrentPose"))
 		bool K2_DetectCurrentPose(UPARAM(ref) FBPOpenXRActionSkeletalData& SkeletalAction, FOpenXRGesture & GestureOut);
 
+	// Finds the closest matching gesture, Score is 0 for an exact match and 1 at the edge of the gestures thresholds
+	UFUNCTION(BlueprintCallable, Category = "VRGestures")
+		bool FindBestGestureMatch(const FBPOpenXRActionSkeletalData& SkeletalAction, int32& GestureIndex, float& Score);
+
 	// This version throws events
 	bool DetectCurrentPose(FBPOpenXRActionSkeletalData& SkeletalAction);
 
@@ -228,26 +346,52 @@ public:
 
 	struct FTransformLerpManager
 	{
+		// A received hand pose and the time that it arrived at
+		struct FHandSnapshot
+		{
+			double TimeStamp;
+			TArray<FTransform> Transforms;
+
+			FHandSnapshot() :
+				TimeStamp(0.0)
+			{}
+		};
+
+		static constexpr int32 SnapshotBufferSize = 8;
+
 		bool bReplicatedOnce;
 		bool bLerping;
-		float UpdateCount;
-		float UpdateRate;
-		TArray<FTransform> OldTransforms;
-		TArray<FTransform> NewTransforms;
+
+		// Ring buffer of received poses, the arrays are swapped in and out and never reallocated once filled
+		FHandSnapshot Snapshots[SnapshotBufferSize];
+		int32 NewestSnapshot;
+		int32 NumSnapshots;
+
+		// Holds the rendered pose while a new one is being copied in, and the array of the evicted snapshot after
+		TArray<FTransform> RenderedTransforms;
+
+		// Running average of the time between received poses, used for the automatic interpolation delay
+		double MeanUpdateInterval;
 
 		FTransformLerpManager();
 		void PreCopyNewData(FBPOpenXRActionSkeletalData& ActionInfo, int NetUpdateRate, bool bExponentialSmoothing);
-		void NotifyNewData(FBPOpenXRActionSkeletalData& ActionInfo, int NetUpdateRate, bool bExponentialSmoothing);
+		void NotifyNewData(FBPOpenXRActionSkeletalData& ActionInfo, int NetUpdateRate, bool bExponentialSmoothing, double TimeStamp);
 
-		FORCEINLINE void BlendBone(uint8 BoneToBlend, FBPOpenXRActionSkeletalData& ActionInfo, float& LerpVal, bool bExponentialSmoothing)
+		FORCEINLINE const FHandSnapshot& GetSnapshot(int32 Age) const
 		{
-			ActionInfo.SkeletalTransforms[BoneToBlend].Blend(OldTransforms[BoneToBlend], NewTransforms[BoneToBlend], LerpVal);
+			return Snapshots[(NewestSnapshot - Age + SnapshotBufferSize) % SnapshotBufferSize];
+		}
 
-			if (bExponentialSmoothing)
-			{
-				// Saving base back out for exponential
-				OldTransforms[BoneToBlend] = ActionInfo.SkeletalTransforms[BoneToBlend];
-			}
+		FORCEINLINE void BlendBone(uint8 BoneToBlend, FBPOpenXRActionSkeletalData& ActionInfo, const TArray<FTransform>& From, const TArray<FTransform>& To, float LerpVal)
+		{
+			// From can be the output for exponential smoothing
+			const FTransform A = From[BoneToBlend];
+			const FTransform& B = To[BoneToBlend];
+			FTransform& Out = ActionInfo.SkeletalTransforms[BoneToBlend];
+
+			Out.SetRotation(FQuat::Slerp(A.GetRotation(), B.GetRotation(), LerpVal));
+			Out.SetTranslation(FMath::Lerp(A.GetTranslation(), B.GetTranslation(), LerpVal));
+			Out.SetScale3D(FMath::Lerp(A.GetScale3D(), B.GetScale3D(), LerpVal));
 		}
 
 		void UpdateManager(float DeltaTime, FBPOpenXRActionSkeletalData& ActionInfo, UOpenXRHandPoseComponent * ParentComp);
@@ -273,7 +417,7 @@ public:
 				
 				if (bSmoothReplicatedSkeletalData)
 				{
-					LeftHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations, bUseExponentialSmoothing);
+					LeftHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations, bUseExponentialSmoothing, GetWorld()->GetRealTimeSeconds());
 				}
 
 				break;
@@ -297,7 +441,7 @@ public:
 				
 				if (bSmoothReplicatedSkeletalData)
 				{
-					RightHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations, bUseExponentialSmoothing);
+					RightHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations, bUseExponentialSmoothing, GetWorld()->GetRealTimeSeconds());
 				}
 				break;
 			}
@@ -319,6 +463,11 @@ public:
 	// Timestep of smoothing translation
 	UPROPERTY(EditAnywhere, Category = "SkeletalData", meta = (editcondition = "bUseExponentialSmoothing"))
 		float InterpolationSpeed = 25.0f;
+
+	// How far behind the newest received pose remote hands are rendered, in seconds, so that there is always a pose to interpolate to
+	// 0 uses 1.5x the measured time between updates, which lets ReplicationRateForSkeletalAnimations be lowered without changing this
+	UPROPERTY(EditAnywhere, Category = "SkeletalData", meta = (editcondition = "bSmoothReplicatedSkeletalData", ClampMin = "0.0", UIMin = "0.0", UIMax = "0.5"))
+		float InterpolationBufferDelay = 0.0f;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SkeletalData)
 		float ReplicationRateForSkeletalAnimations;
@@ -13,6 +13,80 @@
 #include "VRBaseCharacter.h"
 #include "VRRootComponent.h"
 #include "VRPlayerController.h"
+#include "Serialization/BitWriter.h"
+
+namespace VRMoveRepStatics
+{
+	static int32 LogMoveRepBitReport = 0;
+	FAutoConsoleVariableRef CVarLogMoveRepBitReport(
+		TEXT("vre.LogMoveRepBitReport"),
+		LogMoveRepBitReport,
+		TEXT("When on, outgoing VR moves measure how many bits each VR field costs and log the averages every few seconds.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+
+	static const double BitReportInterval = 5.0;
+
+	enum EBitReportField
+	{
+		Field_VRCapsule,
+		Field_LFDiff,
+		Field_CapsuleHeight,
+		Field_CustomVRInput,
+		Field_RequestedVelocity,
+		Field_MoveActions,
+		Field_Count
+	};
+
+	struct FMoveRepBitReport
+	{
+		uint64 Bits[Field_Count] = {};
+		uint32 NumMoves = 0;
+		uint32 NumDeltaMoves = 0;
+		double LastLogTime = 0.0;
+	};
+
+	static FMoveRepBitReport BitReport;
+
+	static int64 MeasureBits(TFunctionRef<void(FArchive&)> SerializeFunc)
+	{
+		FBitWriter Writer(0, true);
+		SerializeFunc(Writer);
+		return Writer.GetNumBits();
+	}
+
+	static void SerializeLFDiff(FVector& LFDiff, const ACharacter* CharacterOwner, FArchive& Ar)
+	{
+		const AVRBaseCharacter* VRChar = Cast<AVRBaseCharacter>(CharacterOwner);
+		if (VRChar && !VRChar->bRetainRoomscale)
+		{
+			SerializePackedVector<10000, 32>(LFDiff, Ar);
+		}
+		else
+		{
+			SerializePackedVector<100, 30>(LFDiff, Ar);
+		}
+	}
+
+	static void SerializeCapsuleHeight(float& CapsuleHeight, FArchive& Ar)
+	{
+		bool bHasCapsuleHeight = CapsuleHeight > 0.f;
+		Ar.SerializeBits(&bHasCapsuleHeight, 1);
+
+		if (bHasCapsuleHeight)
+		{
+			// This is 0.0 - 512.0, using compression to get it smaller, 8 bits = max 256 + 1 bit for sign and 7 bits precision for 128 / full 2 digit precision
+			if (Ar.IsSaving())
+			{
+				WriteFixedCompressedFloat<1024, 18>(CapsuleHeight, Ar);
+			}
+			else
+			{
+				ReadFixedCompressedFloat<1024, 18>(CapsuleHeight, Ar);
+			}
+		}
+	}
+}
 	
 FSavedMove_VRBaseCharacter::FSavedMove_VRBaseCharacter() : FSavedMove_Character()
 {
@@ -20,6 +94,8 @@ FSavedMove_VRBaseCharacter::FSavedMove_VRBaseCharacter() : FSavedMove_Character(
 	LFDiff = FVector::ZeroVector;
 	VRCapsuleRotation = FRotator::ZeroRotator;
 	VRReplicatedMovementMode = EVRConjoinedMovementModes::C_MOVE_MAX;// _None;
+	VRMoveSequence = 0;
+	VRCapsuleBaselineAge = 0;
 }
 
 uint8 FSavedMove_VRBaseCharacter::GetCompressedFlags() const
@@ -55,18 +131,53 @@ bool FSavedMove_VRBaseCharacter::CanCombineWith(const FSavedMovePtr& NewMove, AC
 	if (!ConditionalValues.MoveActionArray.CanCombine() || !nMove->ConditionalValues.MoveActionArray.CanCombine())
 		return false;
 
-	if (!ConditionalValues.CustomVRInputVector.IsZero() || !nMove->ConditionalValues.CustomVRInputVector.IsZero())
-		return false;
-
-	if (!ConditionalValues.RequestedVelocity.IsZero() || !nMove->ConditionalValues.RequestedVelocity.IsZero())
-		return false;
-
 	// Hate this but we really can't combine if I am sending a new capsule height
 	if (!FMath::IsNearlyEqual(CapsuleHeight, nMove->CapsuleHeight))
 		return false;
 
-	if (!LFDiff.IsZero() && !nMove->LFDiff.IsZero() && !FVector::Coincident(LFDiff.GetSafeNormal(), nMove->LFDiff.GetSafeNormal(), AccelDotThresholdCombine))
-		return false;
+	const UVRBaseCharacterMovementComponent* MoveComp = Character ? Cast<UVRBaseCharacterMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+
+	if (MoveComp && MoveComp->bCombineVRMoves)
+	{
+		// Both HMD deltas and custom input are displacements, the combined move replays the sum of them in one step.
+		// Keep the sum small and roughly in one direction so that sweeping it as a single delta doesn't change the collision result.
+		auto CanCombineDeltas = [MoveComp](const FVector& OldDelta, const FVector& NewDelta)
+		{
+			if ((OldDelta + NewDelta).SizeSquared() > FMath::Square(MoveComp->VRMoveCombineMaxDelta))
+				return false;
+
+			// Tiny deltas are mostly tracking jitter
+			if (OldDelta.SizeSquared() <= FMath::Square(MoveComp->VRMoveCombineMinDelta) || NewDelta.SizeSquared() <= FMath::Square(MoveComp->VRMoveCombineMinDelta))
+				return true;
+
+			return FVector::Coincident(OldDelta.GetSafeNormal(), NewDelta.GetSafeNormal(), AccelDotThresholdCombine);
+		};
+
+		if (!CanCombineDeltas(LFDiff, nMove->LFDiff))
+			return false;
+
+		if (!CanCombineDeltas(ConditionalValues.CustomVRInputVector, nMove->ConditionalValues.CustomVRInputVector))
+			return false;
+
+		// Requested velocity is applied as is over the combined time, so it has to match
+		if (!ConditionalValues.RequestedVelocity.Equals(nMove->ConditionalValues.RequestedVelocity, MoveComp->VRMoveCombineVelocityTolerance))
+			return false;
+
+		// The combined move uses the newest HMD yaw
+		if (FMath::Abs(FRotator::NormalizeAxis(VRCapsuleRotation.Yaw - nMove->VRCapsuleRotation.Yaw)) > MoveComp->VRMoveCombineMaxYawDelta)
+			return false;
+	}
+	else
+	{
+		if (!ConditionalValues.CustomVRInputVector.IsZero() || !nMove->ConditionalValues.CustomVRInputVector.IsZero())
+			return false;
+
+		if (!ConditionalValues.RequestedVelocity.IsZero() || !nMove->ConditionalValues.RequestedVelocity.IsZero())
+			return false;
+
+		if (!LFDiff.IsZero() && !nMove->LFDiff.IsZero() && !FVector::Coincident(LFDiff.GetSafeNormal(), nMove->LFDiff.GetSafeNormal(), AccelDotThresholdCombine))
+			return false;
+	}
 
 	return FSavedMove_Character::CanCombineWith(NewMove, Character, MaxDelta);
 }
@@ -166,6 +277,16 @@ void FSavedMove_VRBaseCharacter::CombineWith(const FSavedMove_Character* OldMove
 	{
 		LFDiff.X += BaseSavedMovePending->LFDiff.X;
 		LFDiff.Y += BaseSavedMovePending->LFDiff.Y;
+
+		// The pending moves custom input was reverted with its position, fold it into this frames input so the
+		// combined move (and the server replaying it) applies both in one step. PostUpdate records the summed value.
+		if (!BaseSavedMovePending->ConditionalValues.CustomVRInputVector.IsZero())
+		{
+			if (UVRBaseCharacterMovementComponent* BaseCharMove = Cast<UVRBaseCharacterMovementComponent>(CharMovement))
+			{
+				BaseCharMove->CustomVRInputVector += BaseSavedMovePending->ConditionalValues.CustomVRInputVector;
+			}
+		}
 	}
 
 	// Roll back jump force counters. SetInitialPosition() below will copy them to the saved move.
@@ -190,6 +311,31 @@ void FSavedMove_VRBaseCharacter::PostUpdate(ACharacter* C, EPostUpdateMode PostU
 		ConditionalValues.MoveActionArray = moveComp->MoveActionArray;
 		moveComp->MoveActionArray.Clear();
 
+		if (PostUpdateMode == PostUpdate_Record)
+		{
+			// Lock in the capsule state that gets sent for this move, it becomes the servers baseline once acknowledged
+			VRMoveSequence = moveComp->NextVRMoveSequence++;
+			QuantizedVRCapsuleState = VRMoveRepUtils::QuantizeCapsuleState(VRCapsuleLocation, VRCapsuleRotation.Yaw, moveComp->VRCapsuleLocationQuantization, moveComp->VRCapsuleRotationQuantization);
+			VRCapsuleBaselineState = FVRCapsuleRepState();
+			VRCapsuleBaselineAge = 0;
+
+			if (moveComp->bDeltaEncodeVRCapsule)
+			{
+				const FNetworkPredictionData_Client_Character* ClientData = moveComp->GetPredictionData_Client_Character();
+				const FSavedMove_VRBaseCharacter* AckedMove = ClientData ? (const FSavedMove_VRBaseCharacter*)ClientData->LastAckedMove.Get() : nullptr;
+
+				if (AckedMove && AckedMove->QuantizedVRCapsuleState.bIsValid)
+				{
+					const uint32 BaselineAge = VRMoveSequence - AckedMove->VRMoveSequence;
+					if (BaselineAge > 0 && BaselineAge <= VRMoveRepUtils::MaxBaselineAge)
+					{
+						VRCapsuleBaselineState = AckedMove->QuantizedVRCapsuleState;
+						VRCapsuleBaselineAge = (uint8)BaselineAge;
+					}
+				}
+			}
+		}
+
 		if (!moveComp->bUseClientControlRotation)
 		{
 			if (const USceneComponent* UpdatedComponent = moveComp->UpdatedComponent)
@@ -234,6 +380,11 @@ void FSavedMove_VRBaseCharacter::Clear()
 	LFDiff = FVector::ZeroVector;
 	CapsuleHeight = 0.0f;
 
+	VRMoveSequence = 0;
+	QuantizedVRCapsuleState = FVRCapsuleRepState();
+	VRCapsuleBaselineState = FVRCapsuleRepState();
+	VRCapsuleBaselineAge = 0;
+
 	ConditionalValues.CustomVRInputVector = FVector::ZeroVector;
 	ConditionalValues.RequestedVelocity = FVector::ZeroVector;
 	ConditionalValues.MoveActionArray.Clear();
@@ -305,6 +456,8 @@ FVRCharacterNetworkMoveData::FVRCharacterNetworkMoveData() : FCharacterNetworkMo
 	CapsuleHeight = 0.f;
 	VRCapsuleRotation = 0.f;
 	ReplicatedMovementMode = EVRConjoinedMovementModes::C_MOVE_MAX;
+	VRMoveId = 0;
+	VRCapsuleBaselineAge = 0;
 }
 
 FVRCharacterNetworkMoveData::~FVRCharacterNetworkMoveData()
@@ -326,7 +479,29 @@ void FVRCharacterNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Cha
 		VRCapsuleLocation = SavedMove->VRCapsuleLocation;
 		LFDiff = SavedMove->LFDiff;
 		CapsuleHeight = SavedMove->CapsuleHeight;
-		VRCapsuleRotation = FRotator::CompressAxisToShort(SavedMove->VRCapsuleRotation.Yaw);
+
+		VRMoveId = (uint8)(SavedMove->VRMoveSequence & VRMoveRepUtils::MoveIdMask);
+		QuantizedVRCapsuleState = SavedMove->QuantizedVRCapsuleState;
+
+		if (!QuantizedVRCapsuleState.bIsValid)
+		{
+			// Never recorded, send it at full precision
+			QuantizedVRCapsuleState = VRMoveRepUtils::QuantizeCapsuleState(SavedMove->VRCapsuleLocation, SavedMove->VRCapsuleRotation.Yaw, EVRVectorQuantization::RoundTwoDecimals, EVRRotationQuantization::RoundToShort);
+		}
+
+		VRCapsuleRotation = QuantizedVRCapsuleState.Yaw;
+
+		// Old moves are resends and always go out absolute
+		if (MoveType != ENetworkMoveType::OldMove && SavedMove->VRCapsuleBaselineAge > 0)
+		{
+			VRCapsuleBaselineAge = SavedMove->VRCapsuleBaselineAge;
+			VRCapsuleBaselineState = SavedMove->VRCapsuleBaselineState;
+		}
+		else
+		{
+			VRCapsuleBaselineAge = 0;
+			VRCapsuleBaselineState = FVRCapsuleRepState();
+		}
 	}
 }
 
@@ -424,8 +599,7 @@ bool FVRCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& Charact
 
 	SerializeOptionalValue<uint8>(bIsSaving, Ar, CompressedMoveFlags, 0);
 	SerializeOptionalValue<uint8>(bIsSaving, Ar, MovementMode, MOVE_Walking);
-	VRCapsuleLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
-	Ar << VRCapsuleRotation;
+	SerializeVRCapsuleState(CharacterMovement, Ar, bLocalSuccess);
 
 	// Location is only used for error checking, so only save for the final move.
 	//if (MoveType == ENetworkMoveType::NewMove)
@@ -454,42 +628,145 @@ bool FVRCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& Charact
 	ConditionalMoveReps.NetSerialize(Ar, PackageMap, bLocalSuccess);
 
 	//VRCapsuleLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
-	if (AVRBaseCharacter* VRChar = Cast<AVRBaseCharacter>(CharacterOwner))
+	VRMoveRepStatics::SerializeLFDiff(LFDiff, CharacterOwner, Ar);
+	VRMoveRepStatics::SerializeCapsuleHeight(CapsuleHeight, Ar);
+
+	//LFDiff.NetSerialize(Ar, PackageMap, bLocalSuccess);
+	//Ar << VRCapsuleRotation;
+
+	if (bIsSaving && VRMoveRepStatics::LogMoveRepBitReport > 0)
 	{
-		if (!VRChar->bRetainRoomscale)
+		AccumulateBitReport(CharacterMovement);
+	}
+
+	return !Ar.IsError();
+}
+
+void FVRCharacterNetworkMoveData::SerializeVRCapsuleState(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, bool& bOutSuccess)
+{
+	const bool bIsSaving = Ar.IsSaving();
+
+	Ar << VRMoveId;
+
+	bool bIsDelta = VRCapsuleBaselineAge > 0;
+	Ar.SerializeBits(&bIsDelta, 1);
+
+	if (bIsDelta)
+	{
+		uint32 BaselineAge = VRCapsuleBaselineAge;
+		Ar.SerializeInt(BaselineAge, VRMoveRepUtils::MaxBaselineAge + 1);
+
+		if (!bIsSaving)
 		{
-			SerializePackedVector<10000, 32>(LFDiff, Ar);
+			VRCapsuleBaselineAge = (uint8)BaselineAge;
+			const uint8 BaselineId = (uint8)((VRMoveId - BaselineAge) & VRMoveRepUtils::MoveIdMask);
+			UVRBaseCharacterMovementComponent* BaseMoveComp = Cast<UVRBaseCharacterMovementComponent>(&CharacterMovement);
+
+			if (!BaseMoveComp || !BaseMoveComp->GetVRCapsuleRepBaseline(BaselineId, VRCapsuleBaselineState))
+			{
+				// Can't happen with an intact move history, decode against zero and let the next absolute move fix it up
+				UE_LOG(LogVRBaseCharacterMovement, Warning, TEXT("Received a VR capsule delta against unknown move %u, decoding it as absolute"), BaselineId);
+				VRCapsuleBaselineState = FVRCapsuleRepState();
+			}
 		}
-		else
+
+		FIntVector LocationDelta = bIsSaving ? QuantizedVRCapsuleState.Location - VRCapsuleBaselineState.Location : FIntVector::ZeroValue;
+		VRMoveRepUtils::SerializeSteppedIntVector(LocationDelta, Ar, 10);
+
+		// Wrapped to the shortest way around
+		int32 YawDelta = bIsSaving ? (int32)(int16)(uint16)(QuantizedVRCapsuleState.Yaw - VRCapsuleBaselineState.Yaw) : 0;
+		VRMoveRepUtils::SerializeSteppedInt(YawDelta, Ar, 64);
+
+		if (!bIsSaving)
 		{
-			SerializePackedVector<100, 30>(LFDiff, Ar);
+			QuantizedVRCapsuleState.Location = VRCapsuleBaselineState.Location + LocationDelta;
+			QuantizedVRCapsuleState.Yaw = (uint16)(VRCapsuleBaselineState.Yaw + YawDelta);
 		}
 	}
 	else
 	{
-		SerializePackedVector<100, 30>(LFDiff, Ar);
-	}
+		if (!bIsSaving)
+		{
+			VRCapsuleBaselineAge = 0;
+		}
 
-	bool bHasCapsuleHeight = CapsuleHeight > 0.f;
-	Ar.SerializeBits(&bHasCapsuleHeight, 1);
+		VRMoveRepUtils::SerializeSteppedIntVector(QuantizedVRCapsuleState.Location, Ar, 10);
 
-	if (bHasCapsuleHeight)
-	{
-		// This is 0.0 - 512.0, using compression to get it smaller, 8 bits = max 256 + 1 bit for sign and 7 bits precision for 128 / full 2 digit precision
-		if (Ar.IsSaving())
+		// 10 bit yaws are stored in the top of the short
+		bool bIs10BitYaw = bIsSaving && (QuantizedVRCapsuleState.Yaw & 0x3F) == 0;
+		Ar.SerializeBits(&bIs10BitYaw, 1);
+
+		if (bIs10BitYaw)
 		{
-			WriteFixedCompressedFloat<1024, 18>(CapsuleHeight, Ar);
+			uint32 Yaw10 = QuantizedVRCapsuleState.Yaw >> 6;
+			Ar.SerializeInt(Yaw10, 1024);
+			QuantizedVRCapsuleState.Yaw = (uint16)(Yaw10 << 6);
 		}
 		else
 		{
-			ReadFixedCompressedFloat<1024, 18>(CapsuleHeight, Ar);
+			Ar << QuantizedVRCapsuleState.Yaw;
 		}
 	}
 
-	//LFDiff.NetSerialize(Ar, PackageMap, bLocalSuccess);
-	//Ar << VRCapsuleRotation;
+	if (!bIsSaving)
+	{
+		QuantizedVRCapsuleState.bIsValid = true;
+		VRCapsuleLocation = FVector(QuantizedVRCapsuleState.Location) / 100.0;
+		VRCapsuleRotation = QuantizedVRCapsuleState.Yaw;
 
-	return !Ar.IsError();
+		// Every decoded move is a possible baseline, old moves included since an acked move may only have arrived as one
+		if (UVRBaseCharacterMovementComponent* BaseMoveComp = Cast<UVRBaseCharacterMovementComponent>(&CharacterMovement))
+		{
+			BaseMoveComp->RecordVRCapsuleRepBaseline(VRMoveId, QuantizedVRCapsuleState);
+		}
+	}
+}
+
+void FVRCharacterNetworkMoveData::AccumulateBitReport(UCharacterMovementComponent& CharacterMovement)
+{
+	using namespace VRMoveRepStatics;
+
+	// Everything is measured from copies in a scratch writer, object and name references write nothing there so they aren't counted
+	BitReport.Bits[Field_VRCapsule] += MeasureBits([&](FArchive& Ar) { bool bSuccess = true; SerializeVRCapsuleState(CharacterMovement, Ar, bSuccess); });
+	BitReport.Bits[Field_LFDiff] += MeasureBits([&](FArchive& Ar) { FVector Diff = LFDiff; SerializeLFDiff(Diff, CharacterMovement.GetCharacterOwner(), Ar); });
+	BitReport.Bits[Field_CapsuleHeight] += MeasureBits([&](FArchive& Ar) { float Height = CapsuleHeight; SerializeCapsuleHeight(Height, Ar); });
+
+	if (!ConditionalMoveReps.CustomVRInputVector.IsZero())
+	{
+		BitReport.Bits[Field_CustomVRInput] += MeasureBits([&](FArchive& Ar) { FVector Input = ConditionalMoveReps.CustomVRInputVector; VRMoveRepUtils::SerializeAdaptivePackedVector(Input, Ar); });
+	}
+
+	if (!ConditionalMoveReps.RequestedVelocity.IsZero())
+	{
+		BitReport.Bits[Field_RequestedVelocity] += MeasureBits([&](FArchive& Ar) { FVector Velocity = ConditionalMoveReps.RequestedVelocity; VRMoveRepUtils::SerializeAdaptivePackedVector(Velocity, Ar); });
+	}
+
+	if (ConditionalMoveReps.MoveActionArray.MoveActions.Num() > 0)
+	{
+		BitReport.Bits[Field_MoveActions] += MeasureBits([&](FArchive& Ar) { bool bSuccess = true; FVRMoveActionArray Actions = ConditionalMoveReps.MoveActionArray; Actions.NetSerialize(Ar, nullptr, bSuccess); });
+	}
+
+	BitReport.NumMoves++;
+	BitReport.NumDeltaMoves += VRCapsuleBaselineAge > 0 ? 1 : 0;
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (CurrentTime - BitReport.LastLogTime >= BitReportInterval)
+	{
+		const double NumMoves = (double)BitReport.NumMoves;
+
+		UE_LOG(LogVRBaseCharacterMovement, Log, TEXT("VR move rep average bits over %u moves (%u delta encoded): VRCapsule %.1f, LFDiff %.1f, CapsuleHeight %.1f, CustomVRInput %.1f, RequestedVelocity %.1f, MoveActions %.1f"),
+			BitReport.NumMoves,
+			BitReport.NumDeltaMoves,
+			BitReport.Bits[Field_VRCapsule] / NumMoves,
+			BitReport.Bits[Field_LFDiff] / NumMoves,
+			BitReport.Bits[Field_CapsuleHeight] / NumMoves,
+			BitReport.Bits[Field_CustomVRInput] / NumMoves,
+			BitReport.Bits[Field_RequestedVelocity] / NumMoves,
+			BitReport.Bits[Field_MoveActions] / NumMoves);
+
+		BitReport = FMoveRepBitReport();
+		BitReport.LastLogTime = CurrentTime;
+	}
 }
 
 
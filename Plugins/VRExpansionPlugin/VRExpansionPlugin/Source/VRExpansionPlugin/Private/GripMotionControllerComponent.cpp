@@ -54,6 +54,7 @@
 #include "Chaos/PhysicsObjectInterface.h"
 
 #include "Misc/CollisionIgnoreSubsystem.h"
+#include "Misc/VRPushModelHelpers.h"
 
 #include "Features/IModularFeatures.h"
 
@@ -469,6 +470,7 @@ void UGripMotionControllerComponent::EndPlay(const EEndPlayReason::Type EndPlayR
 		}
 	}
 	GrippedObjects.Empty();
+	MarkGripArrayDirty(GrippedObjects);
 
 	for (int i = 0; i < LocallyGrippedObjects.Num(); i++)
 	{
@@ -493,6 +495,7 @@ void UGripMotionControllerComponent::EndPlay(const EEndPlayReason::Type EndPlayR
 		}
 	}
 	LocallyGrippedObjects.Empty();
+	MarkGripArrayDirty(LocallyGrippedObjects);
 
 	for (int i = 0; i < PhysicsGrips.Num(); i++)
 	{
@@ -668,15 +671,15 @@ void UGripMotionControllerComponent::GetLifetimeReplicatedProps(TArray< class FL
 
 
 	// Skipping the owner with this as the owner will use the controllers location directly
-	DOREPLIFETIME_CONDITION(UGripMotionControllerComponent, ReplicatedControllerTransform, COND_SkipOwner);
-	DOREPLIFETIME(UGripMotionControllerComponent, GrippedObjects);
-	DOREPLIFETIME(UGripMotionControllerComponent, ControllerNetUpdateRate);
-	DOREPLIFETIME(UGripMotionControllerComponent, bSmoothReplicatedMotion);	
-	DOREPLIFETIME(UGripMotionControllerComponent, bReplicateWithoutTracking);
+	VRE_DOREPLIFETIME_CONDITION(UGripMotionControllerComponent, ReplicatedControllerTransform, COND_SkipOwner);
+	VRE_DOREPLIFETIME(UGripMotionControllerComponent, GrippedObjects);
+	VRE_DOREPLIFETIME(UGripMotionControllerComponent, ControllerNetUpdateRate);
+	VRE_DOREPLIFETIME(UGripMotionControllerComponent, bSmoothReplicatedMotion);	
+	VRE_DOREPLIFETIME(UGripMotionControllerComponent, bReplicateWithoutTracking);
 	
 
-	DOREPLIFETIME_CONDITION(UGripMotionControllerComponent, LocallyGrippedObjects, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(UGripMotionControllerComponent, LocalTransactionBuffer, COND_OwnerOnly);
+	VRE_DOREPLIFETIME_CONDITION(UGripMotionControllerComponent, LocallyGrippedObjects, COND_SkipOwner);
+	VRE_DOREPLIFETIME_CONDITION(UGripMotionControllerComponent, LocalTransactionBuffer, COND_OwnerOnly);
 //	DOREPLIFETIME(UGripMotionControllerComponent, bReplicateControllerTransform);
 }
 
@@ -690,10 +693,43 @@ void UGripMotionControllerComponent::GetLifetimeReplicatedProps(TArray< class FL
 	DOREPLIFETIME_ACTIVE_OVERRIDE(USceneComponent, RelativeScale3D, false);
 }*/
 
+void UGripMotionControllerComponent::MarkGripArrayDirty(const TArray<FBPActorGripInformation>& GripArray)
+{
+	if (&GripArray == &GrippedObjects)
+	{
+		VRE_MARK_PROPERTY_DIRTY(UGripMotionControllerComponent, GrippedObjects, this);
+	}
+	else if (&GripArray == &LocallyGrippedObjects)
+	{
+		VRE_MARK_PROPERTY_DIRTY(UGripMotionControllerComponent, LocallyGrippedObjects, this);
+	}
+	else if (&GripArray == &LocalTransactionBuffer)
+	{
+		VRE_MARK_PROPERTY_DIRTY(UGripMotionControllerComponent, LocalTransactionBuffer, this);
+	}
+}
+
+void UGripMotionControllerComponent::MarkGripDirty(const FBPActorGripInformation* Grip)
+{
+	if (!Grip)
+		return;
+
+	// Find which array the grip lives in
+	if (GrippedObjects.Num() && Grip >= GrippedObjects.GetData() && Grip < GrippedObjects.GetData() + GrippedObjects.Num())
+	{
+		MarkGripArrayDirty(GrippedObjects);
+	}
+	else if (LocallyGrippedObjects.Num() && Grip >= LocallyGrippedObjects.GetData() && Grip < LocallyGrippedObjects.GetData() + LocallyGrippedObjects.Num())
+	{
+		MarkGripArrayDirty(LocallyGrippedObjects);
+	}
+}
+
 void UGripMotionControllerComponent::Server_SendControllerTransform_Implementation(FBPVRComponentPosRep NewTransform)
 {
 	// Store new transform and trigger OnRep_Function
 	ReplicatedControllerTransform = NewTransform;
+	VRE_MARK_PROPERTY_DIRTY(UGripMotionControllerComponent, ReplicatedControllerTransform, this);
 
 	// Server should no longer call this RPC itself, but if is using non tracked then it will so keeping auth check
 	if(!bHasAuthority)
@@ -1030,6 +1066,7 @@ void UGripMotionControllerComponent::SetGripCollisionType(const FBPActorGripInfo
 	if (fIndex != INDEX_NONE)
 	{
 		GrippedObjects[fIndex].GripCollisionType = NewGripCollisionType;
+		MarkGripArrayDirty(GrippedObjects);
 		ReCreateGrip(GrippedObjects[fIndex]);
 		Result = EBPVRResultSwitch::OnSucceeded;
 		return;
@@ -1041,6 +1078,7 @@ void UGripMotionControllerComponent::SetGripCollisionType(const FBPActorGripInfo
 		if (fIndex != INDEX_NONE)
 		{
 			LocallyGrippedObjects[fIndex].GripCollisionType = NewGripCollisionType;
+			MarkGripArrayDirty(LocallyGrippedObjects);
 
 			if (IsLocallyControlled() && !IsServer() && !IsTornOff() && LocallyGrippedObjects[fIndex].GripMovementReplicationSetting == EGripMovementReplicationSettings::ClientSide_Authoritive)
 			{
@@ -1065,6 +1103,7 @@ void UGripMotionControllerComponent::SetGripLateUpdateSetting(const FBPActorGrip
 	if (fIndex != INDEX_NONE)
 	{
 		GrippedObjects[fIndex].GripLateUpdateSetting = NewGripLateUpdateSetting;
+		MarkGripArrayDirty(GrippedObjects);
 		Result = EBPVRResultSwitch::OnSucceeded;
 		return;
 	}
@@ -1075,6 +1114,7 @@ void UGripMotionControllerComponent::SetGripLateUpdateSetting(const FBPActorGrip
 		if (fIndex != INDEX_NONE)
 		{
 			LocallyGrippedObjects[fIndex].GripLateUpdateSetting = NewGripLateUpdateSetting;
+			MarkGripArrayDirty(LocallyGrippedObjects);
 
 			if (IsLocallyControlled() && !IsServer() && !IsTornOff() && LocallyGrippedObjects[fIndex].GripMovementReplicationSetting == EGripMovementReplicationSettings::ClientSide_Authoritive)
 			{
@@ -1101,6 +1141,7 @@ void UGripMotionControllerComponent::SetGripRelativeTransform(
 	if (fIndex != INDEX_NONE)
 	{
 		GrippedObjects[fIndex].RelativeTransform = NewRelativeTransform;
+		MarkGripArrayDirty(GrippedObjects);
 		if (FBPActorPhysicsHandleInformation * HandleInfo = GetPhysicsGrip(Grip))
 		{
 			UpdatePhysicsHandle(Grip.GripID, true);
@@ -1117,6 +1158,7 @@ void UGripMotionControllerComponent::SetGripRelativeTransform(
 		if (fIndex != INDEX_NONE)
 		{
 			LocallyGrippedObjects[fIndex].RelativeTransform = NewRelativeTransform;
+			MarkGripArrayDirty(LocallyGrippedObjects);
 			if (FBPActorPhysicsHandleInformation * HandleInfo = GetPhysicsGrip(Grip))
 			{
 				UpdatePhysicsHandle(Grip.GripID, true);
@@ -1180,6 +1222,7 @@ void UGripMotionControllerComponent::SetGripStiffnessAndDamping(
 	{
 		GrippedObjects[fIndex].Stiffness = NewStiffness;
 		GrippedObjects[fIndex].Damping = NewDamping;
+		MarkGripArrayDirty(GrippedObjects);
 
 		if (bAlsoSetAngularValues)
 		{
@@ -1199,6 +1242,7 @@ void UGripMotionControllerComponent::SetGripStiffnessAndDamping(
 		{
 			LocallyGrippedObjects[fIndex].Stiffness = NewStiffness;
 			LocallyGrippedObjects[fIndex].Damping = NewDamping;
+			MarkGripArrayDirty(LocallyGrippedObjects);
 
 			if (bAlsoSetAngularValues)
 			{
@@ -1710,6 +1754,7 @@ bool UGripMotionControllerComponent::GripActor(
 	if (!bIsLocalGrip)
 	{
 		int32 Index = GrippedObjects.Add(newActorGrip);
+		MarkGripArrayDirty(GrippedObjects);
 		if (Index != INDEX_NONE)
 			NotifyGrip(GrippedObjects[Index]);
 		//NotifyGrip(newActorGrip);
@@ -1719,9 +1764,11 @@ bool UGripMotionControllerComponent::GripActor(
 		if (!IsLocallyControlled())
 		{
 			LocalTransactionBuffer.Add(newActorGrip);
+			MarkGripArrayDirty(LocalTransactionBuffer);
 		}
 
 		int32 Index = LocallyGrippedObjects.Add(newActorGrip);
+		MarkGripArrayDirty(LocallyGrippedObjects);
 
 		if (Index != INDEX_NONE)
 		{
@@ -1966,6 +2013,7 @@ bool UGripMotionControllerComponent::GripComponent(
 	if (!bIsLocalGrip)
 	{
 		int32 Index = GrippedObjects.Add(newComponentGrip);
+		MarkGripArrayDirty(GrippedObjects);
 		if (Index != INDEX_NONE)
 			NotifyGrip(GrippedObjects[Index]);
 
@@ -1976,9 +2024,11 @@ bool UGripMotionControllerComponent::GripComponent(
 		if (!IsLocallyControlled())
 		{
 			LocalTransactionBuffer.Add(newComponentGrip);
+			MarkGripArrayDirty(LocalTransactionBuffer);
 		}
 
 		int32 Index = LocallyGrippedObjects.Add(newComponentGrip);
+		MarkGripArrayDirty(LocallyGrippedObjects);
 
 		if (Index != INDEX_NONE)
 		{
@@ -2081,7 +2131,10 @@ bool UGripMotionControllerComponent::DropGrip_Implementation(const FBPActorGripI
 		for (int i = LocalTransactionBuffer.Num() - 1; i >= 0; i--)
 		{
 			if (LocalTransactionBuffer[i].GripID == Grip.GripID)
+			{
 				LocalTransactionBuffer.RemoveAt(i);
+				MarkGripArrayDirty(LocalTransactionBuffer);
+			}
 		}
 	}
 
@@ -2702,6 +2755,7 @@ void UGripMotionControllerComponent::DropAndSocket_Implementation(const FBPActor
 		if (HasGripAuthority(NewDrop) || IsServer())
 		{
 			LocallyGrippedObjects.RemoveAt(fIndex);
+			MarkGripArrayDirty(LocallyGrippedObjects);
 		}
 		else
 		{
@@ -2717,6 +2771,7 @@ void UGripMotionControllerComponent::DropAndSocket_Implementation(const FBPActor
 			if (HasGripAuthority(NewDrop) || IsServer())
 			{
 				GrippedObjects.RemoveAt(fIndex);
+				MarkGripArrayDirty(GrippedObjects);
 			}
 			else
 			{
@@ -3736,6 +3791,7 @@ void UGripMotionControllerComponent::Drop_Implementation(const FBPActorGripInfor
 		if (HasGripAuthority(NewDrop) || IsServer())
 		{
 			LocallyGrippedObjects.RemoveAt(fIndex);
+			MarkGripArrayDirty(LocallyGrippedObjects);
 		}
 		else
 		{
@@ -3751,6 +3807,7 @@ void UGripMotionControllerComponent::Drop_Implementation(const FBPActorGripInfor
 			if (HasGripAuthority(NewDrop) || IsServer())
 			{
 				GrippedObjects.RemoveAt(fIndex);
+				MarkGripArrayDirty(GrippedObjects);
 			}
 			else
 			{
@@ -4000,6 +4057,8 @@ bool UGripMotionControllerComponent::AddSecondaryAttachmentToGrip(const FBPActor
 		GripToUse->SecondaryGripInfo.curLerp = LerpToTime;
 	}
 
+	MarkGripDirty(GripToUse);
+
 	if (bGrippedObjectIsInterfaced)
 	{
 		SecondaryGripIDs.Add(GripToUse->GripID);
@@ -4190,6 +4249,7 @@ bool UGripMotionControllerComponent::RemoveSecondaryAttachmentFromGrip(const FBP
 
 		GripToUse->SecondaryGripInfo.SecondaryAttachment = nullptr;
 		GripToUse->SecondaryGripInfo.bHasSecondaryAttachment = false;
+		MarkGripDirty(GripToUse);
 
 		if (GripToUse->GripMovementReplicationSetting == EGripMovementReplicationSettings::ClientSide_Authoritive && !IsServer())
 		{
@@ -4726,6 +4786,7 @@ void UGripMotionControllerComponent::UpdateTracking(float DeltaTime)
 					// Tracked doesn't matter, already set the relative location above in that case
 					ReplicatedControllerTransform.Position = RelLoc;
 					ReplicatedControllerTransform.Rotation = RelRot;
+					VRE_MARK_PROPERTY_DIRTY(UGripMotionControllerComponent, ReplicatedControllerTransform, this);
 
 					// I would keep the torn off check here, except this can be checked on tick if they
 					// Set 100 htz updates, and in the TornOff case, it actually can't hurt any besides some small
@@ -7643,8 +7704,11 @@ void UGripMotionControllerComponent::Server_NotifyHandledTransaction_Implementat
 {
 	for (int i = LocalTransactionBuffer.Num() - 1; i >= 0; i--)
 	{
-		if(LocalTransactionBuffer[i].GripID == GripID)
+		if (LocalTransactionBuffer[i].GripID == GripID)
+		{
 			LocalTransactionBuffer.RemoveAt(i);
+			MarkGripArrayDirty(LocalTransactionBuffer);
+		}
 	}
 }
 
@@ -7775,6 +7839,7 @@ void UGripMotionControllerComponent::Server_NotifyLocalGripAddedOrChanged_Implem
 		}
 
 		int32 NewIndex = LocallyGrippedObjects.Add(newGrip);
+		MarkGripArrayDirty(LocallyGrippedObjects);
 
 		if (NewIndex != INDEX_NONE && LocallyGrippedObjects.Num() > 0)
 		{
@@ -7802,6 +7867,7 @@ void UGripMotionControllerComponent::Server_NotifyLocalGripAddedOrChanged_Implem
 		{
 			FBPActorGripInformation OriginalGrip = LocallyGrippedObjects[IndexFound];
 			LocallyGrippedObjects[IndexFound].RepCopy(newGrip);
+			MarkGripArrayDirty(LocallyGrippedObjects);
 			HandleGripReplication(LocallyGrippedObjects[IndexFound], &OriginalGrip);
 		}
 	}
@@ -7879,6 +7945,7 @@ void UGripMotionControllerComponent::Server_NotifySecondaryAttachmentChanged_Imp
 
 		// I override the = operator now so that it won't set the lerp components
 		GripInfo->SecondaryGripInfo.RepCopy(SecondaryGripInfo);
+		MarkGripArrayDirty(LocallyGrippedObjects);
 
 		// Initialize the differences, clients will do this themselves on the rep back
 		HandleGripReplication(*GripInfo, &OriginalGrip);
@@ -7906,6 +7973,7 @@ void UGripMotionControllerComponent::Server_NotifySecondaryAttachmentChanged_Ret
 		// I override the = operator now so that it won't set the lerp components
 		GripInfo->SecondaryGripInfo.RepCopy(SecondaryGripInfo);
 		GripInfo->RelativeTransform = NewRelativeTransform;
+		MarkGripArrayDirty(LocallyGrippedObjects);
 
 		// Initialize the differences, clients will do this themselves on the rep back
 		HandleGripReplication(*GripInfo, &OriginalGrip);
@@ -16,6 +16,17 @@
 #include "GameFramework/Actor.h"
 #include "GripMotionControllerComponent.h"
 
+namespace VRMeleeCVars
+{
+	static int32 UseHitTables = 1;
+	FAutoConsoleVariableRef CVarUseHitTables(
+		TEXT("vre.Melee.UseHitTables"),
+		UseHitTables,
+		TEXT("When on, melee scripts resolve surface settings and penetration notifier thresholds from tables built on begin play instead of rebuilding them for every hit.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+}
+
 UGS_Melee::UGS_Melee(const FObjectInitializer& ObjectInitializer) :
 	Super(ObjectInitializer)
 {
@@ -44,6 +55,10 @@ UGS_Melee::UGS_Melee(const FObjectInitializer& ObjectInitializer) :
 	bUsePrimaryHandSettingsWithOneHand = false;
 	COMType = EVRMeleeComType::VRPMELEECOM_BetweenHands;
 	bOnlyPenetrateWithTwoHands = false;
+
+	SurfaceTableSourceNum = 0;
+	bSurfaceTableFromOverride = false;
+	FMemory::Memset(SurfaceTableIndices, INDEX_NONE, sizeof(SurfaceTableIndices));
 }
 
 void UGS_Melee::UpdateDualHandInfo()
@@ -229,6 +244,7 @@ void UGS_Melee::UpdateHandPositionAndRotation(FBPGripPair HandPair, FTransform H
 
 				GripInfo = SecondaryHand.HoldingController->GetGripPtrByID(SecondaryHand.GripID);
 				GripInfo->AdvancedGripSettings.PhysicsSettings.PhysicsGripLocationSettings = EPhysicsGripCOMType::COM_GripAtControllerLoc;
+				SecondaryHand.HoldingController->MarkGripDirty(GripInfo);
 
 				FBPActorPhysicsHandleInformation* HandleInfo = SecondaryHand.HoldingController->GetPhysicsGrip(SecondaryHand.GripID);
 				if (HandleInfo)
@@ -252,6 +268,7 @@ void UGS_Melee::UpdateHandPositionAndRotation(FBPGripPair HandPair, FTransform H
 					GripInfo->AdvancedGripSettings.PhysicsSettings.PhysicsGripLocationSettings = EPhysicsGripCOMType::COM_SetAndGripAt;
 				}
 				}
+				PrimaryHand.HoldingController->MarkGripDirty(GripInfo);
 
 				HandleInfo = PrimaryHand.HoldingController->GetPhysicsGrip(PrimaryHand.GripID);
 				if (HandleInfo)
@@ -316,6 +333,7 @@ void UGS_Melee::UpdateHandPosition(FBPGripPair HandPair, FVector HandWorldPositi
 
 				GripInfo = SecondaryHand.HoldingController->GetGripPtrByID(SecondaryHand.GripID);
 				GripInfo->AdvancedGripSettings.PhysicsSettings.PhysicsGripLocationSettings = EPhysicsGripCOMType::COM_GripAtControllerLoc;
+				SecondaryHand.HoldingController->MarkGripDirty(GripInfo);
 
 				FBPActorPhysicsHandleInformation* HandleInfo = SecondaryHand.HoldingController->GetPhysicsGrip(SecondaryHand.GripID);
 				if (HandleInfo)
@@ -339,6 +357,7 @@ void UGS_Melee::UpdateHandPosition(FBPGripPair HandPair, FVector HandWorldPositi
 					GripInfo->AdvancedGripSettings.PhysicsSettings.PhysicsGripLocationSettings = EPhysicsGripCOMType::COM_SetAndGripAt;
 				}
 				}
+				PrimaryHand.HoldingController->MarkGripDirty(GripInfo);
 
 				HandleInfo = PrimaryHand.HoldingController->GetPhysicsGrip(PrimaryHand.GripID);
 				if (HandleInfo)
@@ -397,6 +416,7 @@ void UGS_Melee::OnGrip_Implementation(UGripMotionControllerComponent* GrippingCo
 		{
 			FBPActorGripInformation * GripInfo = SecondaryHand.HoldingController->GetGripPtrByID(SecondaryHand.GripID);
 			GripInfo->AdvancedGripSettings.PhysicsSettings.PhysicsGripLocationSettings = EPhysicsGripCOMType::COM_GripAtControllerLoc;
+			SecondaryHand.HoldingController->MarkGripDirty(GripInfo);
 
 			FBPActorPhysicsHandleInformation* HandleInfo = SecondaryHand.HoldingController->GetPhysicsGrip(SecondaryHand.GripID);
 			if (HandleInfo)
@@ -420,6 +440,7 @@ void UGS_Melee::OnGrip_Implementation(UGripMotionControllerComponent* GrippingCo
 				GripInfo->AdvancedGripSettings.PhysicsSettings.PhysicsGripLocationSettings = EPhysicsGripCOMType::COM_SetAndGripAt;
 			}
 			}
+			PrimaryHand.HoldingController->MarkGripDirty(GripInfo);
 
 			HandleInfo = PrimaryHand.HoldingController->GetPhysicsGrip(PrimaryHand.GripID);
 			if (HandleInfo)
@@ -512,6 +533,7 @@ void UGS_Melee::OnGripRelease_Implementation(UGripMotionControllerComponent* Rel
 
 				FBPAdvGripSettings AdvSettings = IVRGripInterface::Execute_AdvancedGripSettings(GripInfo->GrippedObject);
 				GripInfo->AdvancedGripSettings.PhysicsSettings.PhysicsGripLocationSettings = AdvSettings.PhysicsSettings.PhysicsGripLocationSettings;
+				PrimaryHand.HoldingController->MarkGripDirty(GripInfo);
 
 				PrimaryHand.HoldingController->UpdatePhysicsHandle(PrimaryHand.GripID, true);
 			}
@@ -569,6 +591,73 @@ void UGS_Melee::OnBeginPlay_Implementation(UObject * CallingOwner)
 			bCheckLodge = true;
 		}
 	}
+
+	RefreshMeleeHitTables();
+}
+
+void UGS_Melee::RefreshMeleeHitTables()
+{
+	const TArray<FBPHitSurfaceProperties>& SourceSurfaceSettings = OverrideMeleeSurfaceSettings.Num() > 0 ? OverrideMeleeSurfaceSettings : GetDefault<UVRGlobalSettings>()->MeleeSurfaceSettings;
+
+	bSurfaceTableFromOverride = OverrideMeleeSurfaceSettings.Num() > 0;
+	SurfaceTableSourceNum = SourceSurfaceSettings.Num();
+	SurfaceTable.Reset(SourceSurfaceSettings.Num());
+	FMemory::Memset(SurfaceTableIndices, INDEX_NONE, sizeof(SurfaceTableIndices));
+
+	for (const FBPHitSurfaceProperties& SurfaceSettings : SourceSurfaceSettings)
+	{
+		const uint8 SurfaceIndex = SurfaceSettings.SurfaceType.GetValue();
+
+		// First entry for a surface type wins, same as searching the list
+		if (SurfaceIndex < SurfaceType_Max && SurfaceTableIndices[SurfaceIndex] == INDEX_NONE)
+		{
+			SurfaceTableIndices[SurfaceIndex] = (int8)SurfaceTable.Add(SurfaceSettings);
+		}
+	}
+
+	LodgeZoneCache.Reset(PenetrationNotifierComponents.Num());
+
+	for (const FBPLodgeComponentInfo& LodgeData : PenetrationNotifierComponents)
+	{
+		FVRMeleeLodgeZoneCache& ZoneCache = LodgeZoneCache.AddDefaulted_GetRef();
+		ZoneCache.TargetComponent = LodgeData.TargetComponent.Get();
+
+		if (IsValid(LodgeData.TargetComponent))
+		{
+			ZoneCache.LocalBox = LodgeData.TargetComponent->CalcLocalBounds().GetBox();
+		}
+
+		ZoneCache.PenetrationDotMin = 1.0f - LodgeData.AcceptableForwardProductRange;
+		ZoneCache.HitDotMin = 1.0f - LodgeData.AcceptableForwardProductRangeForHits;
+		ZoneCache.PenetrationVelocitySq = FMath::Square(LodgeData.PenetrationVelocity);
+		ZoneCache.MinimumHitVelocitySq = FMath::Square(LodgeData.MinimumHitVelocity);
+		ZoneCache.bCanPenetrate = LodgeData.ZoneType != EVRMeleeZoneType::VRPMELLE_ZONETYPE_Hit;
+		ZoneCache.bCanHit = LodgeData.ZoneType > EVRMeleeZoneType::VRPMELLE_ZONETYPE_Stab;
+	}
+}
+
+bool UGS_Melee::AreMeleeHitTablesValid() const
+{
+	if (VRMeleeCVars::UseHitTables <= 0)
+		return false;
+
+	const bool bUseOverride = OverrideMeleeSurfaceSettings.Num() > 0;
+	if (bUseOverride != bSurfaceTableFromOverride)
+		return false;
+
+	if (SurfaceTableSourceNum != (bUseOverride ? OverrideMeleeSurfaceSettings.Num() : GetDefault<UVRGlobalSettings>()->MeleeSurfaceSettings.Num()))
+		return false;
+
+	if (LodgeZoneCache.Num() != PenetrationNotifierComponents.Num())
+		return false;
+
+	for (int32 LodgeIndex = 0; LodgeIndex < PenetrationNotifierComponents.Num(); ++LodgeIndex)
+	{
+		if (LodgeZoneCache[LodgeIndex].TargetComponent != PenetrationNotifierComponents[LodgeIndex].TargetComponent.Get())
+			return false;
+	}
+
+	return true;
 }
 
 void UGS_Melee::OnEndPlay_Implementation(const EEndPlayReason::Type EndPlayReason)
@@ -597,17 +686,10 @@ void UGS_Melee::OnLodgeHitCallback(AActor* SelfActor, AActor* OtherActor, FVecto
 	if (!bAlwaysTickPenetration && !bIsHeld)
 		return;
 
-	TArray<FBPHitSurfaceProperties> AllowedPenetrationSurfaceTypes;
-
-	if (OverrideMeleeSurfaceSettings.Num() > 0)
+	// Rebuilt here as well if the lists were changed since begin play
+	if (!AreMeleeHitTablesValid())
 	{
-		// Use our local copy
-		AllowedPenetrationSurfaceTypes = OverrideMeleeSurfaceSettings;
-	}
-	else
-	{
-		// Use the global settings
-		UVRGlobalSettings::GetMeleeSurfaceGlobalSettings(AllowedPenetrationSurfaceTypes);
+		RefreshMeleeHitTables();
 	}
 	
 	FBPHitSurfaceProperties HitSurfaceProperties;
@@ -616,7 +698,7 @@ void UGS_Melee::OnLodgeHitCallback(AActor* SelfActor, AActor* OtherActor, FVecto
 		HitSurfaceProperties.SurfaceType = Hit.PhysMaterial->SurfaceType;
 	}
 
-	if (AllowedPenetrationSurfaceTypes.Num())
+	if (SurfaceTable.Num())
 	{
 		// Reject bad surface types
 		if (!Hit.PhysMaterial.IsValid())
@@ -625,12 +707,12 @@ void UGS_Melee::OnLodgeHitCallback(AActor* SelfActor, AActor* OtherActor, FVecto
 			return;
 		}
 
-		EPhysicalSurface PhysSurfaceType = Hit.PhysMaterial->SurfaceType;
-		int32 IndexOfSurface = AllowedPenetrationSurfaceTypes.IndexOfByPredicate([&PhysSurfaceType](const FBPHitSurfaceProperties& Entry) { return Entry.SurfaceType == PhysSurfaceType; });
+		const uint8 SurfaceIndex = Hit.PhysMaterial->SurfaceType.GetValue();
+		const int32 IndexOfSurface = SurfaceIndex < SurfaceType_Max ? SurfaceTableIndices[SurfaceIndex] : INDEX_NONE;
 
 		if (IndexOfSurface != INDEX_NONE)
 		{
-			HitSurfaceProperties = AllowedPenetrationSurfaceTypes[IndexOfSurface];
+			HitSurfaceProperties = SurfaceTable[IndexOfSurface];
 		}
 		else
 		{
@@ -662,17 +744,26 @@ void UGS_Melee::OnLodgeHitCallback(AActor* SelfActor, AActor* OtherActor, FVecto
 
 	float HitNormalImpulse = NormalImpulse.SizeSquared();
 
-	for(FBPLodgeComponentInfo &LodgeData : PenetrationNotifierComponents)
+	const bool bCanPenetrate = HitSurfaceProperties.bSurfaceAllowsPenetration && (!bOnlyPenetrateWithTwoHands || SecondaryHand.IsValid());
+
+	for (int32 LodgeIndex = 0; LodgeIndex < PenetrationNotifierComponents.Num(); ++LodgeIndex)
 	{
+		FBPLodgeComponentInfo& LodgeData = PenetrationNotifierComponents[LodgeIndex];
 		if (!IsValid(LodgeData.TargetComponent))
 			continue;
 
-		FBox LodgeLocalBox = LodgeData.TargetComponent->CalcLocalBounds().GetBox();
-		FVector LocalHit = LodgeData.TargetComponent->GetComponentTransform().InverseTransformPosition(Hit.ImpactPoint);
+		const FVRMeleeLodgeZoneCache& ZoneCache = LodgeZoneCache[LodgeIndex];
+
+		// Nothing this zone can throw if it can't penetrate and is already beaten to the hit
+		if (!(bCanPenetrate && ZoneCache.bCanPenetrate) && (bHadFirstHit || !ZoneCache.bCanHit))
+			continue;
+
+		const FTransform& LodgeTransform = LodgeData.TargetComponent->GetComponentTransform();
+		FVector LocalHit = LodgeTransform.InverseTransformPosition(Hit.ImpactPoint);
 		//FBox LodgeBox = LodgeData.TargetComponent->Bounds.GetBox();
-		if (IsValid(LodgeData.TargetComponent) && LodgeLocalBox.IsInsideOrOn(LocalHit))//LodgeBox.IsInsideOrOn(Hit.ImpactPoint))
+		if (ZoneCache.LocalBox.IsInsideOrOn(LocalHit))//LodgeBox.IsInsideOrOn(Hit.ImpactPoint))
 		{
-			FVector ForwardVec = LodgeData.TargetComponent->GetForwardVector();
+			FVector ForwardVec = LodgeTransform.GetUnitAxis(EAxis::X);
 			
 			// Using swept objects hit normal as we are looking for a facing from ourselves
 			float DotValue = FMath::Abs(FVector::DotProduct(Hit.Normal, ForwardVec));
@@ -680,9 +771,9 @@ void UGS_Melee::OnLodgeHitCallback(AActor* SelfActor, AActor* OtherActor, FVecto
 			// Check if the velocity was strong enough along our axis to count as a lodge event
 			// Also that our facing was in the relatively correct direction
 
-			if (HitSurfaceProperties.bSurfaceAllowsPenetration && (!bOnlyPenetrateWithTwoHands || SecondaryHand.IsValid()))
+			if (bCanPenetrate)
 			{
-				if (LodgeData.ZoneType != EVRMeleeZoneType::VRPMELLE_ZONETYPE_Hit && DotValue >= (1.0f - LodgeData.AcceptableForwardProductRange) && (Velocity * HitSurfaceProperties.StabVelocityScaler) >= FMath::Square(LodgeData.PenetrationVelocity))
+				if (ZoneCache.bCanPenetrate && DotValue >= ZoneCache.PenetrationDotMin && (Velocity * HitSurfaceProperties.StabVelocityScaler) >= ZoneCache.PenetrationVelocitySq)
 				{
 					OnShouldLodgeInObject.Broadcast(LodgeData, OtherActor, Hit.GetComponent(), Hit.GetComponent()->GetCollisionObjectType(), HitSurfaceProperties, NormalImpulse, Hit);
 					return;
@@ -692,7 +783,7 @@ void UGS_Melee::OnLodgeHitCallback(AActor* SelfActor, AActor* OtherActor, FVecto
 
 			float HitImpulse = LodgeData.bIgnoreForwardVectorForHitImpulse ? HitNormalImpulse : Velocity;
 
-			if (!bHadFirstHit && LodgeData.ZoneType > EVRMeleeZoneType::VRPMELLE_ZONETYPE_Stab && DotValue >= (1.0f - LodgeData.AcceptableForwardProductRangeForHits) && HitImpulse >= FMath::Square(LodgeData.MinimumHitVelocity))
+			if (!bHadFirstHit && ZoneCache.bCanHit && DotValue >= ZoneCache.HitDotMin && HitImpulse >= ZoneCache.MinimumHitVelocitySq)
 			{
 				bHadFirstHit = true;
 				FirstHitComp = LodgeData;
@@ -15,6 +15,7 @@
 #include "DrawDebugHelpers.h"
 
 #include "Physics/Experimental/PhysScene_Chaos.h"
+#include "Misc/VRPushModelHelpers.h"
 #if WITH_PUSH_MODEL
 #include "Net/Core/PushModel/PushModel.h"
 #endif
@@ -62,13 +63,13 @@ void AGrippableActor::GetLifetimeReplicatedProps(TArray< class FLifetimeProperty
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION(AGrippableActor, GripLogicScripts, COND_Custom);
-	DOREPLIFETIME(AGrippableActor, bReplicateGripScripts);
-	DOREPLIFETIME(AGrippableActor, bRepGripSettingsAndGameplayTags);
-	DOREPLIFETIME(AGrippableActor, bAllowIgnoringAttachOnOwner);
-	DOREPLIFETIME(AGrippableActor, ClientAuthReplicationData);
-	DOREPLIFETIME_CONDITION(AGrippableActor, VRGripInterfaceSettings, COND_Custom);
-	DOREPLIFETIME_CONDITION(AGrippableActor, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(AGrippableActor, GripLogicScripts, COND_Custom);
+	VRE_DOREPLIFETIME(AGrippableActor, bReplicateGripScripts);
+	VRE_DOREPLIFETIME(AGrippableActor, bRepGripSettingsAndGameplayTags);
+	VRE_DOREPLIFETIME(AGrippableActor, bAllowIgnoringAttachOnOwner);
+	VRE_DOREPLIFETIME(AGrippableActor, ClientAuthReplicationData);
+	VRE_DOREPLIFETIME_CONDITION(AGrippableActor, VRGripInterfaceSettings, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(AGrippableActor, GameplayTags, COND_Custom);
 
 	DISABLE_REPLICATED_PRIVATE_PROPERTY(AActor, AttachmentReplication);
 
@@ -349,11 +350,13 @@ void AGrippableActor::BeginPlay()
 void AGrippableActor::SetDenyGripping(bool bDenyGripping)
 {
 	VRGripInterfaceSettings.bDenyGripping = bDenyGripping;
+	VRE_MARK_PROPERTY_DIRTY(AGrippableActor, VRGripInterfaceSettings, this);
 }
 
 void AGrippableActor::SetGripPriority(int NewGripPriority)
 {
 	VRGripInterfaceSettings.AdvancedGripSettings.GripPriority = NewGripPriority;
+	VRE_MARK_PROPERTY_DIRTY(AGrippableActor, VRGripInterfaceSettings, this);
 }
 
 void AGrippableActor::TickGrip_Implementation(UGripMotionControllerComponent * GrippingController, const FBPActorGripInformation & GripInformation, float DeltaTime) {}
@@ -7,6 +7,7 @@
 #include "VRExpansionFunctionLibrary.h"
 #include "GripScripts/VRGripScriptBase.h"
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
 
 //=============================================================================
 UGrippableBoxComponent::~UGrippableBoxComponent()
@@ -47,12 +48,12 @@ void UGrippableBoxComponent::GetLifetimeReplicatedProps(TArray< class FLifetimeP
 {
 	 Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION(UGrippableBoxComponent, GripLogicScripts, COND_Custom);
-	DOREPLIFETIME(UGrippableBoxComponent, bReplicateGripScripts);
-	DOREPLIFETIME(UGrippableBoxComponent, bRepGripSettingsAndGameplayTags);
-	DOREPLIFETIME(UGrippableBoxComponent, bReplicateMovement);
-	DOREPLIFETIME_CONDITION(UGrippableBoxComponent, VRGripInterfaceSettings, COND_Custom);
-	DOREPLIFETIME_CONDITION(UGrippableBoxComponent, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableBoxComponent, GripLogicScripts, COND_Custom);
+	VRE_DOREPLIFETIME(UGrippableBoxComponent, bReplicateGripScripts);
+	VRE_DOREPLIFETIME(UGrippableBoxComponent, bRepGripSettingsAndGameplayTags);
+	VRE_DOREPLIFETIME(UGrippableBoxComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableBoxComponent, VRGripInterfaceSettings, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableBoxComponent, GameplayTags, COND_Custom);
 }
 
 void UGrippableBoxComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -123,11 +124,13 @@ void UGrippableBoxComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 void UGrippableBoxComponent::SetDenyGripping(bool bDenyGripping)
 {
 	VRGripInterfaceSettings.bDenyGripping = bDenyGripping;
+	VRE_MARK_PROPERTY_DIRTY(UGrippableBoxComponent, VRGripInterfaceSettings, this);
 }
 
 void UGrippableBoxComponent::SetGripPriority(int NewGripPriority)
 {
 	VRGripInterfaceSettings.AdvancedGripSettings.GripPriority = NewGripPriority;
+	VRE_MARK_PROPERTY_DIRTY(UGrippableBoxComponent, VRGripInterfaceSettings, this);
 }
 
 void UGrippableBoxComponent::TickGrip_Implementation(UGripMotionControllerComponent * GrippingController, const FBPActorGripInformation & GripInformation, float DeltaTime) {}
@@ -235,6 +238,7 @@ void UGrippableBoxComponent::SetHeld_Implementation(UGripMotionControllerCompone
 			if (!VRGripInterfaceSettings.bIsHeld)
 				bOriginalReplicatesMovement = bReplicateMovement;
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UGrippableBoxComponent, bReplicateMovement, this);
 		}
 
 		VRGripInterfaceSettings.bWasHeld = true;
@@ -245,6 +249,7 @@ void UGrippableBoxComponent::SetHeld_Implementation(UGripMotionControllerCompone
 		if (VRGripInterfaceSettings.MovementReplicationType != EGripMovementReplicationSettings::ForceServerSideMovement)
 		{
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UGrippableBoxComponent, bReplicateMovement, this);
 		}
 
 		VRGripInterfaceSettings.HoldingControllers.Remove(FBPGripPair(HoldingController, GripID));
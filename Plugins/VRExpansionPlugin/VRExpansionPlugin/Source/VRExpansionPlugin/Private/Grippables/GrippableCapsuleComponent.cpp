@@ -7,6 +7,7 @@
 #include "VRExpansionFunctionLibrary.h"
 #include "GripScripts/VRGripScriptBase.h"
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
 
   //=============================================================================
 UGrippableCapsuleComponent::UGrippableCapsuleComponent(const FObjectInitializer& ObjectInitializer)
@@ -43,12 +44,12 @@ void UGrippableCapsuleComponent::GetLifetimeReplicatedProps(TArray< class FLifet
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	DOREPLIFETIME_CONDITION(UGrippableCapsuleComponent, GripLogicScripts, COND_Custom);
-	DOREPLIFETIME(UGrippableCapsuleComponent, bReplicateGripScripts);
-	DOREPLIFETIME(UGrippableCapsuleComponent, bRepGripSettingsAndGameplayTags);
-	DOREPLIFETIME(UGrippableCapsuleComponent, bReplicateMovement);
-	DOREPLIFETIME_CONDITION(UGrippableCapsuleComponent, VRGripInterfaceSettings, COND_Custom);
-	DOREPLIFETIME_CONDITION(UGrippableCapsuleComponent, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableCapsuleComponent, GripLogicScripts, COND_Custom);
+	VRE_DOREPLIFETIME(UGrippableCapsuleComponent, bReplicateGripScripts);
+	VRE_DOREPLIFETIME(UGrippableCapsuleComponent, bRepGripSettingsAndGameplayTags);
+	VRE_DOREPLIFETIME(UGrippableCapsuleComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableCapsuleComponent, VRGripInterfaceSettings, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableCapsuleComponent, GameplayTags, COND_Custom);
 }
 
 void UGrippableCapsuleComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -123,11 +124,13 @@ void UGrippableCapsuleComponent::EndPlay(const EEndPlayReason::Type EndPlayReaso
 void UGrippableCapsuleComponent::SetDenyGripping(bool bDenyGripping)
 {
 	VRGripInterfaceSettings.bDenyGripping = bDenyGripping;
+	VRE_MARK_PROPERTY_DIRTY(UGrippableCapsuleComponent, VRGripInterfaceSettings, this);
 }
 
 void UGrippableCapsuleComponent::SetGripPriority(int NewGripPriority)
 {
 	VRGripInterfaceSettings.AdvancedGripSettings.GripPriority = NewGripPriority;
+	VRE_MARK_PROPERTY_DIRTY(UGrippableCapsuleComponent, VRGripInterfaceSettings, this);
 }
 
 void UGrippableCapsuleComponent::TickGrip_Implementation(UGripMotionControllerComponent * GrippingController, const FBPActorGripInformation & GripInformation, float DeltaTime) {}
@@ -236,6 +239,7 @@ void UGrippableCapsuleComponent::SetHeld_Implementation(UGripMotionControllerCom
 			if (!VRGripInterfaceSettings.bIsHeld)
 				bOriginalReplicatesMovement = bReplicateMovement;
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UGrippableCapsuleComponent, bReplicateMovement, this);
 		}
 
 		VRGripInterfaceSettings.bWasHeld = true;
@@ -246,6 +250,7 @@ void UGrippableCapsuleComponent::SetHeld_Implementation(UGripMotionControllerCom
 		if (VRGripInterfaceSettings.MovementReplicationType != EGripMovementReplicationSettings::ForceServerSideMovement)
 		{
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UGrippableCapsuleComponent, bReplicateMovement, this);
 		}
 
 		VRGripInterfaceSettings.HoldingControllers.Remove(FBPGripPair(HoldingController, GripID));
@@ -18,6 +18,7 @@
 #include "Chaos/DebugDrawQueue.h"
 //#include "Components/SkeletalMeshComponent.h"
 #include "Misc/ScopeRWLock.h"
+#include "Async/ParallelFor.h"
 
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerState.h"
@@ -31,6 +32,20 @@ namespace VRPhysicsReplicationStatics
 	static bool bHasVRPhysicsReplication = false;
 }
 
+DECLARE_CYCLE_STAT(TEXT("VR PhysicsReplication Gather"), STAT_VRPhysicsReplicationGather, STATGROUP_Physics);
+DECLARE_CYCLE_STAT(TEXT("VR PhysicsReplication Solve"), STAT_VRPhysicsReplicationSolve, STATGROUP_Physics);
+DECLARE_CYCLE_STAT(TEXT("VR PhysicsReplication Apply"), STAT_VRPhysicsReplicationApply, STATGROUP_Physics);
+
+namespace VRPhysicsReplicationCVars
+{
+	static int32 MinTargetsForParallelSolve = 32;
+	FAutoConsoleVariableRef CVarMinTargetsForParallelSolve(
+		TEXT("vre.PhysicsReplication.MinTargetsForParallelSolve"),
+		MinTargetsForParallelSolve,
+		TEXT("Number of replicated physics targets needed in a tick before their corrections are solved on worker threads instead of inline.\n"),
+		ECVF_Default);
+}
+
 /*struct FAsyncPhysicsRepCallbackDataVR : public Chaos::FSimCallbackInput
 {
 	TArray<FAsyncPhysicsDesiredState> Buffer;
@@ -261,6 +276,52 @@ void FPhysicsReplicationVR::SetReplicatedTargetVR(Chaos::FPhysicsObject* Physics
 	ReplicatedTargetsQueueVR.Add(Target);
 }
 
+FVRPhysicsRepSettings::FVRPhysicsRepSettings(const FRigidBodyErrorCorrection& ErrorCorrection)
+{
+	// Grab configuration variables from engine config or from CVars if overriding is turned on.
+	static const auto CVarNetPingExtrapolation = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetPingExtrapolation"));
+	NetPingExtrapolation = CVarNetPingExtrapolation->GetFloat() >= 0.0f ? CVarNetPingExtrapolation->GetFloat() : ErrorCorrection.PingExtrapolation;
+
+	static const auto CVarNetPingLimit = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetPingLimit"));
+	NetPingLimit = CVarNetPingLimit->GetFloat() > 0.0f ? CVarNetPingLimit->GetFloat() : ErrorCorrection.PingLimit;
+
+	static const auto CVarErrorPerLinearDifference = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorPerLinearDifference"));
+	ErrorPerLinearDiff = CVarErrorPerLinearDifference->GetFloat() >= 0.0f ? CVarErrorPerLinearDifference->GetFloat() : ErrorCorrection.ErrorPerLinearDifference;
+
+	static const auto CVarErrorPerAngularDifference = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorPerAngularDifference"));
+	ErrorPerAngularDiff = CVarErrorPerAngularDifference->GetFloat() >= 0.0f ? CVarErrorPerAngularDifference->GetFloat() : ErrorCorrection.ErrorPerAngularDifference;
+
+	static const auto CVarMaxRestoredStateError = IConsoleManager::Get().FindConsoleVariable(TEXT("p.MaxRestoredStateError"));
+	MaxRestoredStateError = CVarMaxRestoredStateError->GetFloat() >= 0.0f ? CVarMaxRestoredStateError->GetFloat() : ErrorCorrection.MaxRestoredStateError;
+
+	static const auto CVarErrorAccumulation = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationSeconds"));
+	ErrorAccumulationSeconds = CVarErrorAccumulation->GetFloat() >= 0.0f ? CVarErrorAccumulation->GetFloat() : ErrorCorrection.ErrorAccumulationSeconds;
+
+	static const auto CVarErrorAccumulationDistanceSq = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationDistanceSq"));
+	ErrorAccumulationDistanceSq = CVarErrorAccumulationDistanceSq->GetFloat() >= 0.0f ? CVarErrorAccumulationDistanceSq->GetFloat() : ErrorCorrection.ErrorAccumulationDistanceSq;
+
+	static const auto CVarErrorAccumulationSimilarity = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationSimilarity"));
+	ErrorAccumulationSimilarity = CVarErrorAccumulationSimilarity->GetFloat() >= 0.0f ? CVarErrorAccumulationSimilarity->GetFloat() : ErrorCorrection.ErrorAccumulationSimilarity;
+
+	static const auto CVarLinSet = IConsoleManager::Get().FindConsoleVariable(TEXT("p.PositionLerp"));
+	PositionLerp = CVarLinSet->GetFloat() >= 0.0f ? CVarLinSet->GetFloat() : ErrorCorrection.PositionLerp;
+
+	static const auto CVarLinLerp = IConsoleManager::Get().FindConsoleVariable(TEXT("p.LinearVelocityCoefficient"));
+	LinearVelocityCoefficient = CVarLinLerp->GetFloat() >= 0.0f ? CVarLinLerp->GetFloat() : ErrorCorrection.LinearVelocityCoefficient;
+
+	static const auto CVarAngSet = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AngleLerp"));
+	AngleLerp = CVarAngSet->GetFloat() >= 0.0f ? CVarAngSet->GetFloat() : ErrorCorrection.AngleLerp;
+
+	static const auto CVarAngLerp = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AngularVelocityCoefficient"));
+	AngularVelocityCoefficient = CVarAngLerp->GetFloat() >= 0.0f ? CVarAngLerp->GetFloat() : ErrorCorrection.AngularVelocityCoefficient;
+
+	static const auto CVarMaxLinearHardSnapDistance = IConsoleManager::Get().FindConsoleVariable(TEXT("p.MaxLinearHardSnapDistance"));
+	MaxLinearHardSnapDistance = CVarMaxLinearHardSnapDistance->GetFloat() >= 0.f ? CVarMaxLinearHardSnapDistance->GetFloat() : ErrorCorrection.MaxLinearHardSnapDistance;
+
+	static const auto CVarAlwaysHardSnap = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AlwaysHardSnap"));
+	bAlwaysHardSnap = CVarAlwaysHardSnap->GetInt() != 0;
+}
+
 bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstance* BI, FReplicatedPhysicsTarget& PhysicsTarget, const FRigidBodyErrorCorrection& ErrorCorrection, const float PingSecondsOneWay, bool* bDidHardSnap)
 {
 	// Skip all of the custom logic if we aren't the server
@@ -278,10 +339,31 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 		return false;
 	}
 
-	if (!BI->IsInstanceSimulatingPhysics())
+	// Same path as OnTick, just for a single body
+	FVRPhysicsRepWorkItem WorkItem;
+	GatherRigidBodyStateVR(BI, PhysicsTarget, WorkItem);
+
+	const FVRPhysicsRepSettings Settings(ErrorCorrection);
+	SolveRigidBodyStateVR(DeltaSeconds, Settings, PingSecondsOneWay, WorkItem);
+	return ApplySolvedRigidBodyStateVR(Settings, ErrorCorrection, WorkItem, bDidHardSnap);
+}
+
+void FPhysicsReplicationVR::GatherRigidBodyStateVR(FBodyInstance* BI, FReplicatedPhysicsTarget& PhysicsTarget, FVRPhysicsRepWorkItem& OutWorkItem) const
+{
+	OutWorkItem.BI = BI;
+	OutWorkItem.PhysicsTarget = &PhysicsTarget;
+	OutWorkItem.bSimulating = BI->IsInstanceSimulatingPhysics();
+
+	if (OutWorkItem.bSimulating)
 	{
-		return false;
+		// Get Current state
+		BI->GetRigidBodyState(OutWorkItem.CurrentState);
 	}
+}
+
+void FPhysicsReplicationVR::SolveRigidBodyStateVR(float DeltaSeconds, const FVRPhysicsRepSettings& Settings, const float PingSecondsOneWay, FVRPhysicsRepWorkItem& WorkItem) const
+{
+	// This runs on worker threads, it can only read the gathered state and write to its own work item and target
 
 	//
 	// NOTES:
@@ -313,79 +395,42 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 	// by default), a hard snap to the target physics state is applied.
 	//
 
-	bool bRestoredState = true;
+	WorkItem.bSolved = false;
+	WorkItem.bRestoredState = true;
+
+	if (!WorkItem.bSimulating)
+	{
+		WorkItem.bRestoredState = false;
+		return;
+	}
+
+	FReplicatedPhysicsTarget& PhysicsTarget = *WorkItem.PhysicsTarget;
+	const FRigidBodyState& CurrentState = WorkItem.CurrentState;
 	const FRigidBodyState NewState = PhysicsTarget.TargetState;
 	const float NewQuatSizeSqr = NewState.Quaternion.SizeSquared();
 
 	// failure cases
-	if (!BI->IsInstanceSimulatingPhysics())
-	{
-		UE_LOG(LogPhysics, Warning, TEXT("Physics replicating on non-simulated body. (%s)"), *BI->GetBodyDebugName());
-		return bRestoredState;
-	}
-	else if (NewQuatSizeSqr < UE_KINDA_SMALL_NUMBER)
+	if (NewQuatSizeSqr < UE_KINDA_SMALL_NUMBER)
 	{
-		UE_LOG(LogPhysics, Warning, TEXT("Invalid zero quaternion set for body. (%s)"), *BI->GetBodyDebugName());
-		return bRestoredState;
+		UE_LOG(LogPhysics, Warning, TEXT("Invalid zero quaternion set for body. (%s)"), *WorkItem.BI->GetBodyDebugName());
+		return;
 	}
 	else if (FMath::Abs(NewQuatSizeSqr - 1.f) > UE_KINDA_SMALL_NUMBER)
 	{
 		UE_LOG(LogPhysics, Warning, TEXT("Quaternion (%f %f %f %f) with non-unit magnitude detected. (%s)"),
-			NewState.Quaternion.X, NewState.Quaternion.Y, NewState.Quaternion.Z, NewState.Quaternion.W, *BI->GetBodyDebugName());
-		return bRestoredState;
+			NewState.Quaternion.X, NewState.Quaternion.Y, NewState.Quaternion.Z, NewState.Quaternion.W, *WorkItem.BI->GetBodyDebugName());
+		return;
 	}
 
-	// Grab configuration variables from engine config or from CVars if overriding is turned on.
-	static const auto CVarNetPingExtrapolation = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetPingExtrapolation"));
-	const float NetPingExtrapolation = CVarNetPingExtrapolation->GetFloat() >= 0.0f ? CVarNetPingExtrapolation->GetFloat() : ErrorCorrection.PingExtrapolation;
-
-	static const auto CVarNetPingLimit = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetPingLimit"));
-	const float NetPingLimit = CVarNetPingLimit->GetFloat() > 0.0f ? CVarNetPingLimit->GetFloat() : ErrorCorrection.PingLimit;
-
-	static const auto CVarErrorPerLinearDifference = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorPerLinearDifference"));
-	const float ErrorPerLinearDiff = CVarErrorPerLinearDifference->GetFloat() >= 0.0f ? CVarErrorPerLinearDifference->GetFloat() : ErrorCorrection.ErrorPerLinearDifference;
-	
-	static const auto CVarErrorPerAngularDifference = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorPerAngularDifference"));
-	const float ErrorPerAngularDiff = CVarErrorPerAngularDifference->GetFloat() >= 0.0f ? CVarErrorPerAngularDifference->GetFloat() : ErrorCorrection.ErrorPerAngularDifference;
-	
-	static const auto CVarMaxRestoredStateError = IConsoleManager::Get().FindConsoleVariable(TEXT("p.MaxRestoredStateError"));
-	const float MaxRestoredStateError = CVarMaxRestoredStateError->GetFloat() >= 0.0f ? CVarMaxRestoredStateError->GetFloat() : ErrorCorrection.MaxRestoredStateError;
-	
-	static const auto CVarErrorAccumulation = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationSeconds"));
-	const float ErrorAccumulationSeconds = CVarErrorAccumulation->GetFloat() >= 0.0f ? CVarErrorAccumulation->GetFloat() : ErrorCorrection.ErrorAccumulationSeconds;
-	
-	static const auto CVarErrorAccumulationDistanceSq = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationDistanceSq"));
-	const float ErrorAccumulationDistanceSq = CVarErrorAccumulationDistanceSq->GetFloat() >= 0.0f ? CVarErrorAccumulationDistanceSq->GetFloat() : ErrorCorrection.ErrorAccumulationDistanceSq;
-	
-	static const auto CVarErrorAccumulationSimilarity = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationSimilarity"));
-	const float ErrorAccumulationSimilarity = CVarErrorAccumulationSimilarity->GetFloat() >= 0.0f ? CVarErrorAccumulationSimilarity->GetFloat() : ErrorCorrection.ErrorAccumulationSimilarity;
-	
-	static const auto CVarLinSet = IConsoleManager::Get().FindConsoleVariable(TEXT("p.PositionLerp"));
-	const float PositionLerp = CVarLinSet->GetFloat() >= 0.0f ? CVarLinSet->GetFloat() : ErrorCorrection.PositionLerp;
-
-	static const auto CVarLinLerp = IConsoleManager::Get().FindConsoleVariable(TEXT("p.LinearVelocityCoefficient"));
-	const float LinearVelocityCoefficient = CVarLinLerp->GetFloat() >= 0.0f ? CVarLinLerp->GetFloat() : ErrorCorrection.LinearVelocityCoefficient;
-
-	static const auto CVarAngSet = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AngleLerp"));
-	const float AngleLerp = CVarAngSet->GetFloat() >= 0.0f ? CVarAngSet->GetFloat() : ErrorCorrection.AngleLerp;
-
-	static const auto CVarAngLerp = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AngularVelocityCoefficient"));
-	const float AngularVelocityCoefficient = CVarAngLerp->GetFloat() >= 0.0f ? CVarAngLerp->GetFloat() : ErrorCorrection.AngularVelocityCoefficient;
-	
-	static const auto CVarMaxLinearHardSnapDistance = IConsoleManager::Get().FindConsoleVariable(TEXT("p.MaxLinearHardSnapDistance"));
-	const float MaxLinearHardSnapDistance = CVarMaxLinearHardSnapDistance->GetFloat() >= 0.f ? CVarMaxLinearHardSnapDistance->GetFloat() : ErrorCorrection.MaxLinearHardSnapDistance;
-
-	// Get Current state
-	FRigidBodyState CurrentState;
-	BI->GetRigidBodyState(CurrentState);
+	WorkItem.bSolved = true;
 
 	/////// EXTRAPOLATE APPROXIMATE TARGET VALUES ///////
 
 	// Starting from the last known authoritative position, and
 	// extrapolate an approximation using the last known velocity
 	// and ping.
-	const float PingSeconds = FMath::Clamp(PingSecondsOneWay, 0.f, NetPingLimit);
-	const float ExtrapolationDeltaSeconds = PingSeconds * NetPingExtrapolation;
+	const float PingSeconds = FMath::Clamp(PingSecondsOneWay, 0.f, Settings.NetPingLimit);
+	const float ExtrapolationDeltaSeconds = PingSeconds * Settings.NetPingExtrapolation;
 	const FVector ExtrapolationDeltaPos = NewState.LinVel * ExtrapolationDeltaSeconds;
 	const FVector_NetQuantize100 TargetPos = NewState.Position + ExtrapolationDeltaPos;
 	float NewStateAngVel;
@@ -395,6 +440,11 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 	const FQuat ExtrapolationDeltaQuaternion = FQuat(NewStateAngVelAxis, NewStateAngVel * ExtrapolationDeltaSeconds);
 	FQuat TargetQuat = ExtrapolationDeltaQuaternion * NewState.Quaternion;
 
+	WorkItem.PingSeconds = PingSeconds;
+	WorkItem.ExtrapolationDeltaPos = ExtrapolationDeltaPos;
+	WorkItem.TargetPos = TargetPos;
+	WorkItem.TargetQuat = TargetQuat;
+
 	/////// COMPUTE DIFFERENCES ///////
 
 	FVector LinDiff;
@@ -409,13 +459,13 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 	/////// ACCUMULATE ERROR IF NOT APPROACHING SOLUTION ///////
 
 	// Store sleeping state
-	const bool bShouldSleep = (NewState.Flags & ERigidBodyFlags::Sleeping) != 0;
-	const bool bWasAwake = BI->IsInstanceAwake();
-	const bool bAutoWake = false;
+	WorkItem.bShouldSleep = (NewState.Flags & ERigidBodyFlags::Sleeping) != 0;
 
-	const float Error = (LinDiffSize * ErrorPerLinearDiff) + (AngDiffSize * ErrorPerAngularDiff);
-	bRestoredState = Error < MaxRestoredStateError;
-	if (bRestoredState)
+	const float Error = (LinDiffSize * Settings.ErrorPerLinearDiff) + (AngDiffSize * Settings.ErrorPerAngularDiff);
+	WorkItem.bRestoredState = Error < Settings.MaxRestoredStateError;
+	WorkItem.bOutsideTolerance = !WorkItem.bRestoredState;
+
+	if (WorkItem.bRestoredState)
 	{
 		PhysicsTarget.AccumulatedErrorSeconds = 0.0f;
 	}
@@ -451,10 +501,13 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 			TargetPos - FVector(CurrentState.Position),
 			PhysicsTarget.PrevPosTarget - PhysicsTarget.PrevPos);
 
+		WorkItem.PrevProgress = PrevProgress;
+		WorkItem.PrevSimilarity = PrevSimilarity;
+
 		// If the conditions from the heuristic outlined above are met, accumulate
 		// error. Otherwise, reduce it.
-		if (PrevProgress < ErrorAccumulationDistanceSq &&
-			PrevSimilarity > ErrorAccumulationSimilarity)
+		if (PrevProgress < Settings.ErrorAccumulationDistanceSq &&
+			PrevSimilarity > Settings.ErrorAccumulationSimilarity)
 		{
 			PhysicsTarget.AccumulatedErrorSeconds += DeltaSeconds;
 		}
@@ -464,112 +517,125 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 		}
 
 		// Hard snap if error accumulation or linear error is big enough, and clear the error accumulator.
-		static const auto CVarAlwaysHardSnap = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AlwaysHardSnap"));
-		const bool bHardSnap =
-			LinDiffSize > MaxLinearHardSnapDistance ||
-			PhysicsTarget.AccumulatedErrorSeconds > ErrorAccumulationSeconds ||
-			CVarAlwaysHardSnap->GetInt();
-
-		const FTransform IdealWorldTM(TargetQuat, TargetPos);
+		WorkItem.bLinearHardSnap = LinDiffSize > Settings.MaxLinearHardSnapDistance;
+		WorkItem.bHardSnap =
+			WorkItem.bLinearHardSnap ||
+			PhysicsTarget.AccumulatedErrorSeconds > Settings.ErrorAccumulationSeconds ||
+			Settings.bAlwaysHardSnap;
 
-		if (bHardSnap)
+		if (WorkItem.bHardSnap)
+		{
+			// Too much error so just snap state here and be done with it
+			WorkItem.bRestoredState = true;
+			WorkItem.NewPos = TargetPos;
+			WorkItem.NewQuat = TargetQuat;
+			WorkItem.NewLinVel = NewState.LinVel;
+			WorkItem.NewAngVel = NewState.AngVel;
+		}
+		else if (PhysicsReplicationAsyncVR == nullptr)	//sync case
 		{
+			// Small enough error to interpolate, the async case sends the ideal transform over to the callback instead
+			WorkItem.NewLinVel = FVector(NewState.LinVel) + (LinDiff * Settings.LinearVelocityCoefficient * DeltaSeconds);
+			WorkItem.NewAngVel = FVector(NewState.AngVel) + (AngDiffAxis * AngDiff * Settings.AngularVelocityCoefficient * DeltaSeconds);
+
+			WorkItem.NewPos = FMath::Lerp(FVector(CurrentState.Position), FVector(TargetPos), Settings.PositionLerp);
+			WorkItem.NewQuat = FQuat::Slerp(CurrentState.Quaternion, TargetQuat, Settings.AngleLerp);
+		}
+	}
+
+	PhysicsTarget.PrevPosTarget = TargetPos;
+	PhysicsTarget.PrevPos = FVector(CurrentState.Position);
+}
+
+bool FPhysicsReplicationVR::ApplySolvedRigidBodyStateVR(const FVRPhysicsRepSettings& Settings, const FRigidBodyErrorCorrection& ErrorCorrection, FVRPhysicsRepWorkItem& WorkItem, bool* bDidHardSnap)
+{
+	if (!WorkItem.bSolved)
+	{
+		return WorkItem.bRestoredState;
+	}
+
+	FBodyInstance* BI = WorkItem.BI;
+	FReplicatedPhysicsTarget& PhysicsTarget = *WorkItem.PhysicsTarget;
+	const FRigidBodyState& NewState = PhysicsTarget.TargetState;
+	const bool bAutoWake = false;
+
+	if (WorkItem.bHardSnap)
+	{
 #if !UE_BUILD_SHIPPING
-			if (PhysicsReplicationCVars::LogPhysicsReplicationHardSnaps && GetOwningWorld())
+		if (PhysicsReplicationCVars::LogPhysicsReplicationHardSnaps && GetOwningWorld())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Simulated HARD SNAP - \nCurrent Pos - %s, Target Pos - %s\n CurrentState.LinVel - %s, New Lin Vel - %s\nTarget Extrapolation Delta - %s, Is Replay? - %d, Is Asleep - %d, Prev Progress - %f, Prev Similarity - %f"),
+				*WorkItem.CurrentState.Position.ToString(), *WorkItem.TargetPos.ToString(), *WorkItem.CurrentState.LinVel.ToString(), *NewState.LinVel.ToString(),
+				*WorkItem.ExtrapolationDeltaPos.ToString(), GetOwningWorld()->IsPlayingReplay(), !BI->IsInstanceAwake(), WorkItem.PrevProgress, WorkItem.PrevSimilarity);
+			if (bDidHardSnap)
 			{
-				UE_LOG(LogTemp, Warning, TEXT("Simulated HARD SNAP - \nCurrent Pos - %s, Target Pos - %s\n CurrentState.LinVel - %s, New Lin Vel - %s\nTarget Extrapolation Delta - %s, Is Replay? - %d, Is Asleep - %d, Prev Progress - %f, Prev Similarity - %f"),
-					*CurrentState.Position.ToString(), *TargetPos.ToString(), *CurrentState.LinVel.ToString(), *NewState.LinVel.ToString(),
-					*ExtrapolationDeltaPos.ToString(), GetOwningWorld()->IsPlayingReplay(), !BI->IsInstanceAwake(), PrevProgress, PrevSimilarity);
-				if (bDidHardSnap)
-				{
-					*bDidHardSnap = true;
-				}
-				if (LinDiffSize > MaxLinearHardSnapDistance)
-				{
-					UE_LOG(LogTemp, Warning, TEXT("Hard snap due to linear difference error"));
-				}
-				else
-				{
-					UE_LOG(LogTemp, Warning, TEXT("Hard snap due to accumulated error"))
-				}
+				*bDidHardSnap = true;
+			}
+			if (WorkItem.bLinearHardSnap)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Hard snap due to linear difference error"));
 			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Hard snap due to accumulated error"))
+			}
+		}
 #endif
-			// Too much error so just snap state here and be done with it
-			PhysicsTarget.AccumulatedErrorSeconds = 0.0f;
-			bRestoredState = true;
-			BI->SetBodyTransform(IdealWorldTM, ETeleportType::ResetPhysics, bAutoWake);
+		PhysicsTarget.AccumulatedErrorSeconds = 0.0f;
+		BI->SetBodyTransform(FTransform(WorkItem.NewQuat, WorkItem.NewPos), ETeleportType::ResetPhysics, bAutoWake);
 
-			// Set the new velocities
-			BI->SetLinearVelocity(NewState.LinVel, false, bAutoWake);
-			BI->SetAngularVelocityInRadians(FMath::DegreesToRadians(NewState.AngVel), false, bAutoWake);
+		// Set the new velocities
+		BI->SetLinearVelocity(WorkItem.NewLinVel, false, bAutoWake);
+		BI->SetAngularVelocityInRadians(FMath::DegreesToRadians(WorkItem.NewAngVel), false, bAutoWake);
+	}
+	else if (WorkItem.bOutsideTolerance)
+	{
+		// Small enough error to interpolate
+		if (PhysicsReplicationAsyncVR == nullptr)	//sync case
+		{
+			BI->SetBodyTransform(FTransform(WorkItem.NewQuat, WorkItem.NewPos), ETeleportType::ResetPhysics);
+			BI->SetLinearVelocity(WorkItem.NewLinVel, false);
+			BI->SetAngularVelocityInRadians(FMath::DegreesToRadians(WorkItem.NewAngVel), false);
 		}
 		else
 		{
-			// Small enough error to interpolate
-			if (PhysicsReplicationAsyncVR == nullptr)	//sync case
-			{
-				const FVector NewLinVel = FVector(NewState.LinVel) + (LinDiff * LinearVelocityCoefficient * DeltaSeconds);
-				const FVector NewAngVel = FVector(NewState.AngVel) + (AngDiffAxis * AngDiff * AngularVelocityCoefficient * DeltaSeconds);
+			//If async is used, enqueue for callback
+			FPhysicsRepAsyncInputData AsyncInputData;
+			AsyncInputData.TargetState = NewState;
+			AsyncInputData.TargetState.Position = WorkItem.TargetPos;
+			AsyncInputData.TargetState.Quaternion = WorkItem.TargetQuat;
+			AsyncInputData.Proxy = static_cast<Chaos::FSingleParticlePhysicsProxy*>(BI->GetPhysicsActorHandle());
+			AsyncInputData.PhysicsObject = nullptr;
+			AsyncInputData.ErrorCorrection = { ErrorCorrection.LinearVelocityCoefficient, ErrorCorrection.AngularVelocityCoefficient, ErrorCorrection.PositionLerp, ErrorCorrection.AngleLerp };
 
-				const FVector NewPos = FMath::Lerp(FVector(CurrentState.Position), FVector(TargetPos), PositionLerp);
-				const FQuat NewAng = FQuat::Slerp(CurrentState.Quaternion, TargetQuat, AngleLerp);
+			AsyncInputData.LatencyOneWay = WorkItem.PingSeconds;
 
-				BI->SetBodyTransform(FTransform(NewAng, NewPos), ETeleportType::ResetPhysics);
-				BI->SetLinearVelocity(NewLinVel, false);
-				BI->SetAngularVelocityInRadians(FMath::DegreesToRadians(NewAngVel), false);
-			}
-			else
-			{
-				//If async is used, enqueue for callback
-				FPhysicsRepAsyncInputData AsyncInputData;
-				AsyncInputData.TargetState = NewState;
-				AsyncInputData.TargetState.Position = IdealWorldTM.GetLocation();
-				AsyncInputData.TargetState.Quaternion = IdealWorldTM.GetRotation();
-				AsyncInputData.Proxy = static_cast<Chaos::FSingleParticlePhysicsProxy*>(BI->GetPhysicsActorHandle());
-				AsyncInputData.PhysicsObject = nullptr;
-				AsyncInputData.ErrorCorrection = { ErrorCorrection.LinearVelocityCoefficient, ErrorCorrection.AngularVelocityCoefficient, ErrorCorrection.PositionLerp, ErrorCorrection.AngleLerp };
-
-				AsyncInputData.LatencyOneWay = PingSeconds;
-
-
-				AsyncInputVR->InputData.Add(AsyncInputData);
-				/*FAsyncPhysicsDesiredState AsyncDesiredState;
-				AsyncDesiredState.WorldTM = IdealWorldTM;
-				AsyncDesiredState.LinearVelocity = NewState.LinVel;
-				AsyncDesiredState.AngularVelocity = NewState.AngVel;
-				AsyncDesiredState.Proxy = static_cast<Chaos::FSingleParticlePhysicsProxy*>(BI->GetPhysicsActorHandle());
-				AsyncDesiredState.ErrorCorrection = { ErrorCorrection.LinearVelocityCoefficient, ErrorCorrection.AngularVelocityCoefficient, ErrorCorrection.PositionLerp, ErrorCorrection.AngleLerp };
-				AsyncDesiredState.bShouldSleep = bShouldSleep;
-				CurAsyncDataVR->Buffer.Add(AsyncDesiredState);*/
-			}
+
+			AsyncInputVR->InputData.Add(AsyncInputData);
 		}
+	}
 
-		// Should we show the async part?
+	// Should we show the async part?
 #if !UE_BUILD_SHIPPING
-		static const auto CVarNetShowCorrections = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetShowCorrections"));
-		if (CVarNetShowCorrections->GetInt() != 0)
+	static const auto CVarNetShowCorrections = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetShowCorrections"));
+	if (WorkItem.bOutsideTolerance && CVarNetShowCorrections->GetInt() != 0)
+	{
+		PhysicsTarget.ErrorHistory.bAutoAdjustMinMax = false;
+		PhysicsTarget.ErrorHistory.MinValue = 0.0f;
+		PhysicsTarget.ErrorHistory.MaxValue = 1.0f;
+		PhysicsTarget.ErrorHistory.AddSample(PhysicsTarget.AccumulatedErrorSeconds / Settings.ErrorAccumulationSeconds);
+		if (UWorld* OwningWorld = GetOwningWorld())
 		{
-			PhysicsTarget.ErrorHistory.bAutoAdjustMinMax = false;
-			PhysicsTarget.ErrorHistory.MinValue = 0.0f;
-			PhysicsTarget.ErrorHistory.MaxValue = 1.0f;
-			PhysicsTarget.ErrorHistory.AddSample(PhysicsTarget.AccumulatedErrorSeconds / ErrorAccumulationSeconds);
-			if (UWorld* OwningWorld = GetOwningWorld())
-			{
-				FColor Color = FColor::White;
-				static const auto CVarNetCorrectionLifetime = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetCorrectionLifetime"));
-				DrawDebugDirectionalArrow(OwningWorld, CurrentState.Position, TargetPos, 5.0f, Color, true, CVarNetCorrectionLifetime->GetFloat(), 0, 1.5f);
-#if 0
-				//todo: do we show this in async mode?
-				DrawDebugFloatHistory(*OwningWorld, PhysicsTarget.ErrorHistory, NewPos + FVector(0.0f, 0.0f, 100.0f), FVector2D(100.0f, 50.0f), FColor::White);
-#endif
-			}
+			FColor Color = FColor::White;
+			static const auto CVarNetCorrectionLifetime = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetCorrectionLifetime"));
+			DrawDebugDirectionalArrow(OwningWorld, WorkItem.CurrentState.Position, WorkItem.TargetPos, 5.0f, Color, true, CVarNetCorrectionLifetime->GetFloat(), 0, 1.5f);
 		}
-#endif
 	}
+#endif
 
 	/////// SLEEP UPDATE ///////
 
-	if (bShouldSleep)
+	if (WorkItem.bShouldSleep)
 	{
 		// In the async case, we apply sleep state in ApplyAsyncDesiredState
 		if (PhysicsReplicationAsyncVR == nullptr)
@@ -578,10 +644,7 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 		}
 	}
 
-	PhysicsTarget.PrevPosTarget = TargetPos;
-	PhysicsTarget.PrevPos = FVector(CurrentState.Position);
-
-	return bRestoredState;
+	return WorkItem.bRestoredState;
 }
 
 void FPhysicsReplicationVR::OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrimitiveComponent>, FReplicatedPhysicsTarget>& ComponentsToTargets)
@@ -602,9 +665,6 @@ void FPhysicsReplicationVR::OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrim
 		return;
 	}
 
-	using namespace Chaos;
-
-
 	int32 LocalFrameOffset = 0; // LocalFrame = ServerFrame + LocalFrameOffset;
 	if (FPhysicsSolverBase::IsNetworkPhysicsPredictionEnabled())
 	{
@@ -629,86 +689,113 @@ void FPhysicsReplicationVR::OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrim
 	// Get the ping between this PC & the server
 	const float LocalPing = 0.0f;//GetLocalPing();
 
-	for (auto Itr = ComponentsToTargets.CreateIterator(); Itr; ++Itr)
+	// We will always be the server here, I already filtered out clients to default logic.
+	// Get the total ping - this approximates the time since the update was
+	// actually generated on the machine that is doing the authoritative sim.
+	const float TargetPingSecondsOneWay = 0.0f;// (LocalPing + OwnerPing) * 0.5f * 0.001f;
+
+	/////// GATHER ///////
+
+	// Resolve the components and bodies once into a flat list, nothing is added to or removed from the map until the end of the tick
+	// so the target pointers stay valid.
+	RepWorkItemsVR.Reset();
+
 	{
+		SCOPE_CYCLE_COUNTER(STAT_VRPhysicsReplicationGather);
 
-		bool bRemoveItr = false;
-		if (UPrimitiveComponent* PrimComp = Itr.Key().Get())
+		for (auto Itr = ComponentsToTargets.CreateIterator(); Itr; ++Itr)
 		{
-			if (FBodyInstance* BI = PrimComp->GetBodyInstance(Itr.Value().BoneName))
+			UPrimitiveComponent* PrimComp = Itr.Key().Get();
+			if (!PrimComp)
+				continue;
+
+			FBodyInstance* BI = PrimComp->GetBodyInstance(Itr.Value().BoneName);
+			AActor* OwningActor = PrimComp->GetOwner();
+			if (!BI || !OwningActor)
+				continue;
+
+			FReplicatedPhysicsTarget& PhysicsTarget = Itr.Value();
+
+			// Remove if there is no owner
+			const bool bRemoveTarget = !OwningActor->GetNetOwningPlayer();
+			if (!bRemoveTarget && !(PhysicsTarget.TargetState.Flags & ERigidBodyFlags::NeedsUpdate))
+				continue;
+
+			FVRPhysicsRepWorkItem& WorkItem = RepWorkItemsVR.AddDefaulted_GetRef();
+			WorkItem.ComponentKey = Itr.Key();
+			WorkItem.PrimComp = PrimComp;
+			WorkItem.bRemoveTarget = bRemoveTarget;
+
+			if (bRemoveTarget)
 			{
-				FReplicatedPhysicsTarget& PhysicsTarget = Itr.Value();
-				FRigidBodyState& UpdatedState = PhysicsTarget.TargetState;
-				bool bUpdated = false;
-				if (AActor* OwningActor = PrimComp->GetOwner())
-				{
-					// Remove if there is no owner
-					if (!OwningActor->GetNetOwningPlayer())
-					{
-						bRemoveItr = true;
-					}
-					else
-					{
-						// Removed as this is server sided
-						/*const ENetRole OwnerRole = OwningActor->GetLocalRole();
-						const bool bIsSimulated = OwnerRole == ROLE_SimulatedProxy;
-						const bool bIsReplicatedAutonomous = OwnerRole == ROLE_AutonomousProxy && PrimComp->bReplicatePhysicsToAutonomousProxy;
-						if (bIsSimulated || bIsReplicatedAutonomous)*/
-
-
-						// Deleted everything here, we will always be the server, I already filtered out clients to default logic
-						{
-							/*const*/ float OwnerPing = 0.0f;// GetOwnerPing(OwningActor, PhysicsTarget);
-
-							/*if (UPlayer* OwningPlayer = OwningActor->GetNetOwningPlayer())
-							{
-								if (APlayerController* PlayerController = OwningPlayer->GetPlayerController(nullptr))
-								{
-									if (APlayerState* PlayerState = PlayerController->PlayerState)
-									{
-										OwnerPing = PlayerState->ExactPing;
-									}
-								}
-							}*/
-
-							// Get the total ping - this approximates the time since the update was
-							// actually generated on the machine that is doing the authoritative sim.
-							// NOTE: We divide by 2 to approximate 1-way ping from 2-way ping.
-							const float PingSecondsOneWay = 0.0f;// (LocalPing + OwnerPing) * 0.5f * 0.001f;
-
-
-							if (UpdatedState.Flags & ERigidBodyFlags::NeedsUpdate)
-							{
-								const int32 LocalFrame = PhysicsTarget.ServerFrame + LocalFrameOffset;
-								const bool bRestoredState = ApplyRigidBodyState(DeltaSeconds, BI, PhysicsTarget, PhysicErrorCorrection, PingSecondsOneWay, LocalFrame, 0);
-								//const bool bRestoredState = ApplyRigidBodyState(DeltaSeconds, BI, PhysicsTarget, PhysicErrorCorrection, PingSecondsOneWay, LocalFrame, NumPredictedFrames);
-
-								// Need to update the component to match new position.
-								static const auto CVarSkipSkeletalRepOptimization = IConsoleManager::Get().FindConsoleVariable(TEXT("p.SkipSkeletalRepOptimization"));
-								if (/*PhysicsReplicationCVars::SkipSkeletalRepOptimization*/CVarSkipSkeletalRepOptimization->GetInt() == 0 || Cast<USkeletalMeshComponent>(PrimComp) == nullptr)	//simulated skeletal mesh does its own polling of physics results so we don't need to call this as it'll happen at the end of the physics sim
-								{
-									PrimComp->SyncComponentToRBPhysics();
-								}
-
-								// Added a sleeping check from the input state as well, we always want to cease activity on sleep
-								if (bRestoredState /* || ((UpdatedState.Flags & ERigidBodyFlags::Sleeping) != 0)*/)
-								{
-									bRemoveItr = true;
-								}
-							}
-						}
-					}
-				}
+				WorkItem.BI = BI;
+				WorkItem.PhysicsTarget = &PhysicsTarget;
+			}
+			else
+			{
+				GatherRigidBodyStateVR(BI, PhysicsTarget, WorkItem);
 			}
+		}
+	}
+
+	/////// SOLVE ///////
+
+	const FVRPhysicsRepSettings Settings(PhysicErrorCorrection);
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VRPhysicsReplicationSolve);
 
-			if (bRemoveItr)
+		// Each work item only reads its gathered state and writes to its own target
+		const bool bRunInParallel = RepWorkItemsVR.Num() >= VRPhysicsReplicationCVars::MinTargetsForParallelSolve;
+		ParallelFor(RepWorkItemsVR.Num(), [this, DeltaSeconds, TargetPingSecondsOneWay, &Settings](int32 Index)
+		{
+			FVRPhysicsRepWorkItem& WorkItem = RepWorkItemsVR[Index];
+			if (!WorkItem.bRemoveTarget)
 			{
-				OnTargetRestored(Itr.Key().Get(), Itr.Value());
-				Itr.RemoveCurrent();
+				SolveRigidBodyStateVR(DeltaSeconds, Settings, TargetPingSecondsOneWay, WorkItem);
+			}
+		}, bRunInParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+	}
+
+	/////// APPLY ///////
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VRPhysicsReplicationApply);
+
+		// Body writes stay on the game thread, each one takes the scene write lock on its own
+		static const auto CVarSkipSkeletalRepOptimization = IConsoleManager::Get().FindConsoleVariable(TEXT("p.SkipSkeletalRepOptimization"));
+		for (FVRPhysicsRepWorkItem& WorkItem : RepWorkItemsVR)
+		{
+			if (WorkItem.bRemoveTarget)
+				continue;
+
+			const bool bRestoredState = ApplySolvedRigidBodyStateVR(Settings, PhysicErrorCorrection, WorkItem);
+
+			// Need to update the component to match new position.
+			if (/*PhysicsReplicationCVars::SkipSkeletalRepOptimization*/CVarSkipSkeletalRepOptimization->GetInt() == 0 || Cast<USkeletalMeshComponent>(WorkItem.PrimComp) == nullptr)	//simulated skeletal mesh does its own polling of physics results so we don't need to call this as it'll happen at the end of the physics sim
+			{
+				WorkItem.PrimComp->SyncComponentToRBPhysics();
+			}
+
+			// Added a sleeping check from the input state as well, we always want to cease activity on sleep
+			if (bRestoredState /* || ((UpdatedState.Flags & ERigidBodyFlags::Sleeping) != 0)*/)
+			{
+				WorkItem.bRemoveTarget = true;
+			}
+		}
+
+		for (FVRPhysicsRepWorkItem& WorkItem : RepWorkItemsVR)
+		{
+			if (WorkItem.bRemoveTarget)
+			{
+				OnTargetRestored(WorkItem.PrimComp, *WorkItem.PhysicsTarget);
+				ComponentsToTargets.Remove(WorkItem.ComponentKey);
 			}
 		}
 	}
 
+	RepWorkItemsVR.Reset();
+
 	// PhysicsObject replication flow
 	for (FReplicatedPhysicsTarget& PhysicsTarget : ReplicatedTargetsQueueVR)
 	{
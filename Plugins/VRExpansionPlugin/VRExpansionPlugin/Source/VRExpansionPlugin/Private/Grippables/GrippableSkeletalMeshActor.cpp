@@ -13,6 +13,7 @@
 #include "PhysicsReplication.h"
 #include "Physics/Experimental/PhysScene_Chaos.h"
 #include "PhysicsEngine/PhysicsAsset.h" // Tmp until epic bug fixes skeletal welding
+#include "Misc/VRPushModelHelpers.h"
 #if WITH_PUSH_MODEL
 #include "Net/Core/PushModel/PushModel.h"
 #endif
@@ -37,7 +38,7 @@ void UOptionalRepSkeletalMeshComponent::GetLifetimeReplicatedProps(TArray< class
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UOptionalRepSkeletalMeshComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME(UOptionalRepSkeletalMeshComponent, bReplicateMovement);
 }
 
 void UOptionalRepSkeletalMeshComponent::GetWeldedBodies(TArray<FBodyInstance*>& OutWeldedBodies, TArray<FName>& OutLabels, bool bIncludingAutoWeld)
@@ -152,13 +153,13 @@ void AGrippableSkeletalMeshActor::GetLifetimeReplicatedProps(TArray< class FLife
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION(AGrippableSkeletalMeshActor, GripLogicScripts, COND_Custom);
-	DOREPLIFETIME(AGrippableSkeletalMeshActor, bReplicateGripScripts);
-	DOREPLIFETIME(AGrippableSkeletalMeshActor, bRepGripSettingsAndGameplayTags);
-	DOREPLIFETIME(AGrippableSkeletalMeshActor, bAllowIgnoringAttachOnOwner);
-	DOREPLIFETIME(AGrippableSkeletalMeshActor, ClientAuthReplicationData);
-	DOREPLIFETIME_CONDITION(AGrippableSkeletalMeshActor, VRGripInterfaceSettings, COND_Custom);
-	DOREPLIFETIME_CONDITION(AGrippableSkeletalMeshActor, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(AGrippableSkeletalMeshActor, GripLogicScripts, COND_Custom);
+	VRE_DOREPLIFETIME(AGrippableSkeletalMeshActor, bReplicateGripScripts);
+	VRE_DOREPLIFETIME(AGrippableSkeletalMeshActor, bRepGripSettingsAndGameplayTags);
+	VRE_DOREPLIFETIME(AGrippableSkeletalMeshActor, bAllowIgnoringAttachOnOwner);
+	VRE_DOREPLIFETIME(AGrippableSkeletalMeshActor, ClientAuthReplicationData);
+	VRE_DOREPLIFETIME_CONDITION(AGrippableSkeletalMeshActor, VRGripInterfaceSettings, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(AGrippableSkeletalMeshActor, GameplayTags, COND_Custom);
 
 	DISABLE_REPLICATED_PRIVATE_PROPERTY(AActor, AttachmentReplication);
 
@@ -362,7 +363,7 @@ bool AGrippableSkeletalMeshActor::ReplicateSubobjects(UActorChannel* Channel, cl
 
 /*void AGrippableSkeletalMeshActor::GetLifetimeReplicatedProps(TArray< class FLifetimeProperty > & OutLifetimeProps) const
 {
-	DOREPLIFETIME(AGrippableSkeletalMeshActor, VRGripInterfaceSettings);
+	VRE_DOREPLIFETIME(AGrippableSkeletalMeshActor, VRGripInterfaceSettings);
 }*/
 
 //=============================================================================
@@ -388,11 +389,13 @@ void AGrippableSkeletalMeshActor::BeginPlay()
 void AGrippableSkeletalMeshActor::SetDenyGripping(bool bDenyGripping)
 {
 	VRGripInterfaceSettings.bDenyGripping = bDenyGripping;
+	VRE_MARK_PROPERTY_DIRTY(AGrippableSkeletalMeshActor, VRGripInterfaceSettings, this);
 }
 
 void AGrippableSkeletalMeshActor::SetGripPriority(int NewGripPriority)
 {
 	VRGripInterfaceSettings.AdvancedGripSettings.GripPriority = NewGripPriority;
+	VRE_MARK_PROPERTY_DIRTY(AGrippableSkeletalMeshActor, VRGripInterfaceSettings, this);
 }
 
 void AGrippableSkeletalMeshActor::TickGrip_Implementation(UGripMotionControllerComponent* GrippingController, const FBPActorGripInformation& GripInformation, float DeltaTime) {}
@@ -8,6 +8,7 @@
 #include "GripScripts/VRGripScriptBase.h"
 #include "PhysicsEngine/PhysicsAsset.h" // Tmp until epic bug fixes skeletal welding
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
 
   //=============================================================================
 UGrippableSkeletalMeshComponent::UGrippableSkeletalMeshComponent(const FObjectInitializer& ObjectInitializer)
@@ -44,12 +45,12 @@ void UGrippableSkeletalMeshComponent::GetLifetimeReplicatedProps(TArray< class F
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	DOREPLIFETIME_CONDITION(UGrippableSkeletalMeshComponent, GripLogicScripts, COND_Custom);
-	DOREPLIFETIME(UGrippableSkeletalMeshComponent, bReplicateGripScripts);
-	DOREPLIFETIME(UGrippableSkeletalMeshComponent, bRepGripSettingsAndGameplayTags);
-	DOREPLIFETIME(UGrippableSkeletalMeshComponent, bReplicateMovement);
-	DOREPLIFETIME_CONDITION(UGrippableSkeletalMeshComponent, VRGripInterfaceSettings, COND_Custom);
-	DOREPLIFETIME_CONDITION(UGrippableSkeletalMeshComponent, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableSkeletalMeshComponent, GripLogicScripts, COND_Custom);
+	VRE_DOREPLIFETIME(UGrippableSkeletalMeshComponent, bReplicateGripScripts);
+	VRE_DOREPLIFETIME(UGrippableSkeletalMeshComponent, bRepGripSettingsAndGameplayTags);
+	VRE_DOREPLIFETIME(UGrippableSkeletalMeshComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableSkeletalMeshComponent, VRGripInterfaceSettings, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableSkeletalMeshComponent, GameplayTags, COND_Custom);
 }
 
 void UGrippableSkeletalMeshComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -124,11 +125,13 @@ void UGrippableSkeletalMeshComponent::EndPlay(const EEndPlayReason::Type EndPlay
 void UGrippableSkeletalMeshComponent::SetDenyGripping(bool bDenyGripping)
 {
 	VRGripInterfaceSettings.bDenyGripping = bDenyGripping;
+	VRE_MARK_PROPERTY_DIRTY(UGrippableSkeletalMeshComponent, VRGripInterfaceSettings, this);
 }
 
 void UGrippableSkeletalMeshComponent::SetGripPriority(int NewGripPriority)
 {
 	VRGripInterfaceSettings.AdvancedGripSettings.GripPriority = NewGripPriority;
+	VRE_MARK_PROPERTY_DIRTY(UGrippableSkeletalMeshComponent, VRGripInterfaceSettings, this);
 }
 
 void UGrippableSkeletalMeshComponent::TickGrip_Implementation(UGripMotionControllerComponent * GrippingController, const FBPActorGripInformation & GripInformation, float DeltaTime) {}
@@ -236,6 +239,7 @@ void UGrippableSkeletalMeshComponent::SetHeld_Implementation(UGripMotionControll
 			if (!VRGripInterfaceSettings.bIsHeld)
 				bOriginalReplicatesMovement = bReplicateMovement;
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UGrippableSkeletalMeshComponent, bReplicateMovement, this);
 		}
 
 		VRGripInterfaceSettings.bWasHeld = true;
@@ -246,6 +250,7 @@ void UGrippableSkeletalMeshComponent::SetHeld_Implementation(UGripMotionControll
 		if (VRGripInterfaceSettings.MovementReplicationType != EGripMovementReplicationSettings::ForceServerSideMovement)
 		{
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UGrippableSkeletalMeshComponent, bReplicateMovement, this);
 		}
 
 		VRGripInterfaceSettings.HoldingControllers.Remove(FBPGripPair(HoldingController, GripID));
@@ -7,6 +7,7 @@
 #include "VRExpansionFunctionLibrary.h"
 #include "GripScripts/VRGripScriptBase.h"
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
 
   //=============================================================================
 UGrippableSphereComponent::UGrippableSphereComponent(const FObjectInitializer& ObjectInitializer)
@@ -42,12 +43,12 @@ void UGrippableSphereComponent::GetLifetimeReplicatedProps(TArray< class FLifeti
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	DOREPLIFETIME_CONDITION(UGrippableSphereComponent, GripLogicScripts, COND_Custom);
-	DOREPLIFETIME(UGrippableSphereComponent, bReplicateGripScripts)
-	DOREPLIFETIME(UGrippableSphereComponent, bRepGripSettingsAndGameplayTags);
-	DOREPLIFETIME(UGrippableSphereComponent, bReplicateMovement);
-	DOREPLIFETIME_CONDITION(UGrippableSphereComponent, VRGripInterfaceSettings, COND_Custom);
-	DOREPLIFETIME_CONDITION(UGrippableSphereComponent, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableSphereComponent, GripLogicScripts, COND_Custom);
+	VRE_DOREPLIFETIME(UGrippableSphereComponent, bReplicateGripScripts);
+	VRE_DOREPLIFETIME(UGrippableSphereComponent, bRepGripSettingsAndGameplayTags);
+	VRE_DOREPLIFETIME(UGrippableSphereComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableSphereComponent, VRGripInterfaceSettings, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableSphereComponent, GameplayTags, COND_Custom);
 }
 
 void UGrippableSphereComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -122,11 +123,13 @@ void UGrippableSphereComponent::EndPlay(const EEndPlayReason::Type EndPlayReason
 void UGrippableSphereComponent::SetDenyGripping(bool bDenyGripping)
 {
 	VRGripInterfaceSettings.bDenyGripping = bDenyGripping;
+	VRE_MARK_PROPERTY_DIRTY(UGrippableSphereComponent, VRGripInterfaceSettings, this);
 }
 
 void UGrippableSphereComponent::SetGripPriority(int NewGripPriority)
 {
 	VRGripInterfaceSettings.AdvancedGripSettings.GripPriority = NewGripPriority;
+	VRE_MARK_PROPERTY_DIRTY(UGrippableSphereComponent, VRGripInterfaceSettings, this);
 }
 
 void UGrippableSphereComponent::TickGrip_Implementation(UGripMotionControllerComponent * GrippingController, const FBPActorGripInformation & GripInformation, float DeltaTime) {}
@@ -234,6 +237,7 @@ void UGrippableSphereComponent::SetHeld_Implementation(UGripMotionControllerComp
 			if (!VRGripInterfaceSettings.bIsHeld)
 				bOriginalReplicatesMovement = bReplicateMovement;
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UGrippableSphereComponent, bReplicateMovement, this);
 		}
 
 		VRGripInterfaceSettings.bWasHeld = true;
@@ -244,6 +248,7 @@ void UGrippableSphereComponent::SetHeld_Implementation(UGripMotionControllerComp
 		if (VRGripInterfaceSettings.MovementReplicationType != EGripMovementReplicationSettings::ForceServerSideMovement)
 		{
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UGrippableSphereComponent, bReplicateMovement, this);
 		}
 
 		VRGripInterfaceSettings.HoldingControllers.Remove(FBPGripPair(HoldingController, GripID));
@@ -14,6 +14,7 @@
 #include "GripScripts/VRGripScriptBase.h"
 #include "DrawDebugHelpers.h"
 #include "Physics/Experimental/PhysScene_Chaos.h"
+#include "Misc/VRPushModelHelpers.h"
 
 #if WITH_PUSH_MODEL
 #include "Net/Core/PushModel/PushModel.h"
@@ -62,7 +63,7 @@ void UOptionalRepStaticMeshComponent::GetLifetimeReplicatedProps(TArray< class F
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UOptionalRepStaticMeshComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME(UOptionalRepStaticMeshComponent, bReplicateMovement);
 }
 
   //=============================================================================
@@ -110,13 +111,13 @@ void AGrippableStaticMeshActor::GetLifetimeReplicatedProps(TArray< class FLifeti
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	DOREPLIFETIME_CONDITION(AGrippableStaticMeshActor, GripLogicScripts, COND_Custom);
-	DOREPLIFETIME(AGrippableStaticMeshActor, bReplicateGripScripts);
-	DOREPLIFETIME(AGrippableStaticMeshActor, bRepGripSettingsAndGameplayTags);
-	DOREPLIFETIME(AGrippableStaticMeshActor, bAllowIgnoringAttachOnOwner);
-	DOREPLIFETIME(AGrippableStaticMeshActor, ClientAuthReplicationData);
-	DOREPLIFETIME_CONDITION(AGrippableStaticMeshActor, VRGripInterfaceSettings, COND_Custom);
-	DOREPLIFETIME_CONDITION(AGrippableStaticMeshActor, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(AGrippableStaticMeshActor, GripLogicScripts, COND_Custom);
+	VRE_DOREPLIFETIME(AGrippableStaticMeshActor, bReplicateGripScripts);
+	VRE_DOREPLIFETIME(AGrippableStaticMeshActor, bRepGripSettingsAndGameplayTags);
+	VRE_DOREPLIFETIME(AGrippableStaticMeshActor, bAllowIgnoringAttachOnOwner);
+	VRE_DOREPLIFETIME(AGrippableStaticMeshActor, ClientAuthReplicationData);
+	VRE_DOREPLIFETIME_CONDITION(AGrippableStaticMeshActor, VRGripInterfaceSettings, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(AGrippableStaticMeshActor, GameplayTags, COND_Custom);
 
 	DISABLE_REPLICATED_PRIVATE_PROPERTY(AActor, AttachmentReplication);
 
@@ -343,11 +344,13 @@ void AGrippableStaticMeshActor::BeginPlay()
 void AGrippableStaticMeshActor::SetDenyGripping(bool bDenyGripping)
 {
 	VRGripInterfaceSettings.bDenyGripping = bDenyGripping;
+	VRE_MARK_PROPERTY_DIRTY(AGrippableStaticMeshActor, VRGripInterfaceSettings, this);
 }
 
 void AGrippableStaticMeshActor::SetGripPriority(int NewGripPriority)
 {
 	VRGripInterfaceSettings.AdvancedGripSettings.GripPriority = NewGripPriority;
+	VRE_MARK_PROPERTY_DIRTY(AGrippableStaticMeshActor, VRGripInterfaceSettings, this);
 }
 
 void AGrippableStaticMeshActor::TickGrip_Implementation(UGripMotionControllerComponent * GrippingController, const FBPActorGripInformation & GripInformation, float DeltaTime) {}
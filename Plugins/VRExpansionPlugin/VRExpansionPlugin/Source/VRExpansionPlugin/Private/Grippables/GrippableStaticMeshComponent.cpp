@@ -7,6 +7,7 @@
 #include "VRExpansionFunctionLibrary.h"
 #include "GripScripts/VRGripScriptBase.h"
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
 
   //=============================================================================
 UGrippableStaticMeshComponent::UGrippableStaticMeshComponent(const FObjectInitializer& ObjectInitializer)
@@ -43,12 +44,12 @@ void UGrippableStaticMeshComponent::GetLifetimeReplicatedProps(TArray< class FLi
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	DOREPLIFETIME_CONDITION(UGrippableStaticMeshComponent, GripLogicScripts, COND_Custom);
-	DOREPLIFETIME(UGrippableStaticMeshComponent, bReplicateGripScripts);
-	DOREPLIFETIME(UGrippableStaticMeshComponent, bRepGripSettingsAndGameplayTags);
-	DOREPLIFETIME(UGrippableStaticMeshComponent, bReplicateMovement);
-	DOREPLIFETIME_CONDITION(UGrippableStaticMeshComponent, VRGripInterfaceSettings, COND_Custom);
-	DOREPLIFETIME_CONDITION(UGrippableStaticMeshComponent, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableStaticMeshComponent, GripLogicScripts, COND_Custom);
+	VRE_DOREPLIFETIME(UGrippableStaticMeshComponent, bReplicateGripScripts);
+	VRE_DOREPLIFETIME(UGrippableStaticMeshComponent, bRepGripSettingsAndGameplayTags);
+	VRE_DOREPLIFETIME(UGrippableStaticMeshComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableStaticMeshComponent, VRGripInterfaceSettings, COND_Custom);
+	VRE_DOREPLIFETIME_CONDITION(UGrippableStaticMeshComponent, GameplayTags, COND_Custom);
 }
 
 void UGrippableStaticMeshComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -123,11 +124,13 @@ void UGrippableStaticMeshComponent::EndPlay(const EEndPlayReason::Type EndPlayRe
 void UGrippableStaticMeshComponent::SetDenyGripping(bool bDenyGripping)
 {
 	VRGripInterfaceSettings.bDenyGripping = bDenyGripping;
+	VRE_MARK_PROPERTY_DIRTY(UGrippableStaticMeshComponent, VRGripInterfaceSettings, this);
 }
 
 void UGrippableStaticMeshComponent::SetGripPriority(int NewGripPriority)
 {
 	VRGripInterfaceSettings.AdvancedGripSettings.GripPriority = NewGripPriority;
+	VRE_MARK_PROPERTY_DIRTY(UGrippableStaticMeshComponent, VRGripInterfaceSettings, this);
 }
 
 void UGrippableStaticMeshComponent::TickGrip_Implementation(UGripMotionControllerComponent * GrippingController, const FBPActorGripInformation & GripInformation, float DeltaTime) {}
@@ -235,6 +238,7 @@ void UGrippableStaticMeshComponent::SetHeld_Implementation(UGripMotionController
 			if (!VRGripInterfaceSettings.bIsHeld)
 				bOriginalReplicatesMovement = bReplicateMovement;
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UGrippableStaticMeshComponent, bReplicateMovement, this);
 		}
 
 		VRGripInterfaceSettings.bWasHeld = true;
@@ -245,6 +249,7 @@ void UGrippableStaticMeshComponent::SetHeld_Implementation(UGripMotionController
 		if (VRGripInterfaceSettings.MovementReplicationType != EGripMovementReplicationSettings::ForceServerSideMovement)
 		{
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UGrippableStaticMeshComponent, bReplicateMovement, this);
 		}
 
 		VRGripInterfaceSettings.HoldingControllers.Remove(FBPGripPair(HoldingController, GripID));
@@ -16,6 +16,13 @@
 //#include "VRBPDatatypes.h"
 #include "Net/UnrealNetwork.h"
 #include "Serialization/CustomVersion.h"
+#include "Misc/VRPushModelHelpers.h"
+#include "Engine/SkeletalMesh.h"
+#include "Animation/Skeleton.h"
+#include "UObject/ObjectKey.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/Crc.h"
+#include "Misc/VRAssetCacheHelpers.h"
 
 DEFINE_LOG_CATEGORY(LogVRHandSocketComponent);
 
@@ -89,165 +96,172 @@ UAnimSequence* UHandSocketComponent::GetTargetAnimation()
 	return HandTargetAnimation;
 }
 
-bool UHandSocketComponent::GetAnimationSequenceAsPoseSnapShot(UAnimSequence* InAnimationSequence, FPoseSnapshot& OutPoseSnapShot, USkeletalMeshComponent* TargetMesh, bool bSkipRootBone, bool bFlipHand)
+namespace HandSocketPoseCache
 {
-	if (InAnimationSequence)
+	// The cache is just emptied when it gets this large, it only holds stale entries if animations are unloaded
+	static const int32 MaxCachedSnapshots = 512;
+
+	struct FKey
 	{
-		OutPoseSnapShot.SkeletalMeshName = /*TargetMesh ? TargetMesh->SkeletalMesh->GetFName(): */InAnimationSequence->GetSkeleton()->GetFName();
-		OutPoseSnapShot.SnapshotName = InAnimationSequence->GetFName();
-		OutPoseSnapShot.BoneNames.Empty();
-		OutPoseSnapShot.LocalTransforms.Empty();
+		TObjectKey<UAnimSequence> Animation;
+		TObjectKey<UObject> TargetAsset;
+		uint32 DeltasHash;
+		bool bSkipRootBone;
+		bool bFlipHand;
 
-		TArray<FName> AnimSeqNames;
+		bool operator==(const FKey& Other) const
+		{
+			return Animation == Other.Animation && TargetAsset == Other.TargetAsset && DeltasHash == Other.DeltasHash &&
+				bSkipRootBone == Other.bSkipRootBone && bFlipHand == Other.bFlipHand;
+		}
 
-		if (USkeleton* AnimationSkele = InAnimationSequence->GetSkeleton())
+		friend uint32 GetTypeHash(const FKey& Key)
 		{
-			// pre-size the array to avoid unnecessary reallocation
-			OutPoseSnapShot.BoneNames.AddUninitialized(AnimationSkele->GetReferenceSkeleton().GetNum());
-			for (int32 i = 0; i < AnimationSkele->GetReferenceSkeleton().GetNum(); i++)
-			{
-				OutPoseSnapShot.BoneNames[i] = AnimationSkele->GetReferenceSkeleton().GetBoneName(i);
-				if (bFlipHand)
-				{
-					FString bName = OutPoseSnapShot.BoneNames[i].ToString();
+			uint32 Hash = HashCombine(GetTypeHash(Key.Animation), GetTypeHash(Key.TargetAsset));
+			Hash = HashCombine(Hash, Key.DeltasHash);
+			return HashCombine(Hash, (Key.bSkipRootBone ? 1u : 0u) | (Key.bFlipHand ? 2u : 0u));
+		}
+	};
 
-					if (bName.Contains("_r"))
-					{
-						bName = bName.Replace(TEXT("_r"), TEXT("_l"));
-					}
-					else
-					{
-						bName = bName.Replace(TEXT("_l"), TEXT("_r"));
-					}
+	struct FCacheState
+	{
+		FCriticalSection Lock;
+		TMap<FKey, FPoseSnapshot> Snapshots;
 
-					OutPoseSnapShot.BoneNames[i] = FName(bName);
-				}
-			}
+		// Flipped bone names per skeleton, in reference skeleton order
+		TMap<TObjectKey<USkeleton>, TArray<FName>> MirroredSkeletonNames;
+		TMap<FName, FName> MirroredNames;
+	};
+
+	static void ClearCacheState(FCacheState& State)
+	{
+		FScopeLock ScopeLock(&State.Lock);
+		State.Snapshots.Reset();
+		State.MirroredSkeletonNames.Reset();
+	}
+
+	static bool AffectsCache(const UObject* Object)
+	{
+		return Object && (Object->IsA<UAnimSequence>() || Object->IsA<USkeleton>() || Object->IsA<USkeletalMesh>());
+	}
+
+	static TVRAssetDerivedCache<FCacheState> PoseCache(
+		TEXT("vre.HandSocket.CachePoseSnapshots"),
+		TEXT("When on, pose snapshots built by hand sockets are cached and shared between all hand sockets.\n")
+		TEXT("0: Disable, 1: Enable"),
+		&AffectsCache,
+		&ClearCacheState);
+
+	static FCacheState& GetState()
+	{
+		return PoseCache.GetState();
+	}
+
+	static void ClearCache()
+	{
+		PoseCache.Clear();
+	}
+
+	// Swaps _r and _l, lock has to be held
+	static FName GetMirroredBoneName_Locked(FCacheState& State, FName BoneName)
+	{
+		if (const FName* Mirrored = State.MirroredNames.Find(BoneName))
+			return *Mirrored;
+
+		FString bName = BoneName.ToString();
+
+		if (bName.Contains("_r"))
+		{
+			bName = bName.Replace(TEXT("_r"), TEXT("_l"));
 		}
 		else
 		{
-			return false;
+			bName = bName.Replace(TEXT("_l"), TEXT("_r"));
 		}
 
-		const FReferenceSkeleton& RefSkeleton = (TargetMesh) ? TargetMesh->GetSkinnedAsset()->GetRefSkeleton() : InAnimationSequence->GetSkeleton()->GetReferenceSkeleton();
-		FTransform LocalTransform;
+		FName MirroredName(bName);
+		State.MirroredNames.Add(BoneName, MirroredName);
+		return MirroredName;
+	}
 
-		const TArray<FTrackToSkeletonMap>& TrackMap = InAnimationSequence->GetCompressedTrackToSkeletonMapTable();
-		int32 TrackIndex = INDEX_NONE;
+	static FName GetMirroredBoneName(FName BoneName)
+	{
+		FCacheState& State = GetState();
+		FScopeLock ScopeLock(&State.Lock);
+		return GetMirroredBoneName_Locked(State, BoneName);
+	}
 
-		OutPoseSnapShot.LocalTransforms.Reserve(OutPoseSnapShot.BoneNames.Num());
+	static void GetSkeletonBoneNames(USkeleton* Skeleton, bool bFlipHand, TArray<FName>& OutBoneNames)
+	{
+		const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
 
-		for (int32 BoneNameIndex = 0; BoneNameIndex < OutPoseSnapShot.BoneNames.Num(); ++BoneNameIndex)
+		if (!bFlipHand)
 		{
-
-			const FName& BoneName = OutPoseSnapShot.BoneNames[BoneNameIndex];
-
-			TrackIndex = INDEX_NONE;
-			if (BoneNameIndex != INDEX_NONE && BoneNameIndex < TrackMap.Num() && TrackMap[BoneNameIndex].BoneTreeIndex == BoneNameIndex)
+			OutBoneNames.Reset(RefSkeleton.GetNum());
+			for (int32 i = 0; i < RefSkeleton.GetNum(); i++)
 			{
-				TrackIndex = BoneNameIndex;
-			}
-			else
-			{
-				// This shouldn't happen but I need a fallback
-				// Don't currently want to reconstruct the map inversely
-				for (int i = 0; i < TrackMap.Num(); ++i)
-				{
-					if (TrackMap[i].BoneTreeIndex == BoneNameIndex)
-					{
-						TrackIndex = i;
-						break;
-					}
-				}
+				OutBoneNames.Add(RefSkeleton.GetBoneName(i));
 			}
+			return;
+		}
 
-			if (TrackIndex != INDEX_NONE && (!bSkipRootBone || TrackIndex != 0))
-			{
-				double TrackLocation = 0.0f;			
-				InAnimationSequence->GetBoneTransform(LocalTransform, FSkeletonPoseBoneIndex(TrackMap[TrackIndex].BoneTreeIndex), TrackLocation, false);
-			}
-			else
-			{
-				// otherwise, get ref pose if exists
-				const int32 BoneIDX = RefSkeleton.FindBoneIndex(BoneName);
-				if (BoneIDX != INDEX_NONE)
-				{
-					LocalTransform = RefSkeleton.GetRefBonePose()[BoneIDX];
-				}
-				else
-				{
-					LocalTransform = FTransform::Identity;
-				}
-			}
+		FCacheState& State = GetState();
+		FScopeLock ScopeLock(&State.Lock);
 
-			if (bFlipHand && (!bSkipRootBone || TrackIndex != 0))
+		TArray<FName>* MirroredNames = State.MirroredSkeletonNames.Find(Skeleton);
+		if (!MirroredNames || MirroredNames->Num() != RefSkeleton.GetNum())
+		{
+			MirroredNames = &State.MirroredSkeletonNames.Add(Skeleton);
+			MirroredNames->Reset(RefSkeleton.GetNum());
+			for (int32 i = 0; i < RefSkeleton.GetNum(); i++)
 			{
-				FMatrix M = LocalTransform.ToMatrixWithScale();
-				M.Mirror(EAxis::X, EAxis::X);
-				M.Mirror(EAxis::Y, EAxis::Y);
-				M.Mirror(EAxis::Z, EAxis::Z);
-				LocalTransform.SetFromMatrix(M);
+				MirroredNames->Add(GetMirroredBoneName_Locked(State, RefSkeleton.GetBoneName(i)));
 			}
-
-			OutPoseSnapShot.LocalTransforms.Add(LocalTransform);
 		}
 
-		OutPoseSnapShot.bIsValid = true;
-		return true;
+		OutBoneNames = *MirroredNames;
 	}
 
-	return false;
-}
-
-bool UHandSocketComponent::GetBlendedPoseSnapShot(FPoseSnapshot& PoseSnapShot, USkeletalMeshComponent* TargetMesh, bool bSkipRootBone, bool bFlipHand)
-{
-	if (HandTargetAnimation)// && bUseCustomPoseDeltas && CustomPoseDeltas.Num() > 0)
+	static uint32 HashDeltas(const TArray<FBPVRHandPoseBonePair>* Deltas)
 	{
-		PoseSnapShot.SkeletalMeshName = HandTargetAnimation->GetSkeleton()->GetFName();
-		PoseSnapShot.SnapshotName = HandTargetAnimation->GetFName();
-		PoseSnapShot.BoneNames.Empty();
-		PoseSnapShot.LocalTransforms.Empty();
-		TArray<FName> OrigBoneNames;
+		if (!Deltas)
+			return 0;
 
-		if(USkeleton * AnimationSkele = HandTargetAnimation->GetSkeleton())
+		uint32 Hash = GetTypeHash(Deltas->Num()) + 1;
+		for (const FBPVRHandPoseBonePair& HandPair : *Deltas)
 		{
-			// pre-size the array to avoid unnecessary reallocation
-			PoseSnapShot.BoneNames.AddUninitialized(AnimationSkele->GetReferenceSkeleton().GetNum());
-			OrigBoneNames.AddUninitialized(AnimationSkele->GetReferenceSkeleton().GetNum());
-			for (int32 i = 0; i < AnimationSkele->GetReferenceSkeleton().GetNum(); i++)
-			{
-				PoseSnapShot.BoneNames[i] = AnimationSkele->GetReferenceSkeleton().GetBoneName(i);
-				OrigBoneNames[i] = PoseSnapShot.BoneNames[i];
-				if (bFlipHand)
-				{
-					FString bName = PoseSnapShot.BoneNames[i].ToString();
+			const double QuatValues[4] = { HandPair.DeltaPose.X, HandPair.DeltaPose.Y, HandPair.DeltaPose.Z, HandPair.DeltaPose.W };
+			Hash = HashCombine(Hash, GetTypeHash(HandPair.BoneName));
+			Hash = FCrc::MemCrc32(QuatValues, sizeof(QuatValues), Hash);
+		}
 
-					if (bName.Contains("_r"))
-					{
-						bName = bName.Replace(TEXT("_r"), TEXT("_l"));
-					}
-					else
-					{
-						bName = bName.Replace(TEXT("_l"), TEXT("_r"));
-					}
+		return Hash;
+	}
 
-					PoseSnapShot.BoneNames[i] = FName(bName);
-				}
-			}
-		}
-		else
-		{
+	// Samples the animation into a snapshot, with optional deltas (keyed by the un-mirrored bone names) layered on top
+	static bool BuildAnimationPoseSnapShot(UAnimSequence* InAnimationSequence, FPoseSnapshot& OutPoseSnapShot, USkeletalMeshComponent* TargetMesh, bool bSkipRootBone, bool bFlipHand, const TArray<FBPVRHandPoseBonePair>* CustomPoseDeltas)
+	{
+		USkeleton* AnimationSkele = InAnimationSequence->GetSkeleton();
+		if (!AnimationSkele)
 			return false;
-		}
 
-		const FReferenceSkeleton& RefSkeleton = (TargetMesh) ? TargetMesh->GetSkinnedAsset()->GetRefSkeleton() : HandTargetAnimation->GetSkeleton()->GetReferenceSkeleton();
+		OutPoseSnapShot.SkeletalMeshName = /*TargetMesh ? TargetMesh->SkeletalMesh->GetFName(): */AnimationSkele->GetFName();
+		OutPoseSnapShot.SnapshotName = InAnimationSequence->GetFName();
+		OutPoseSnapShot.LocalTransforms.Reset();
+		GetSkeletonBoneNames(AnimationSkele, bFlipHand, OutPoseSnapShot.BoneNames);
+
+		const FReferenceSkeleton& RefSkeleton = (TargetMesh) ? TargetMesh->GetSkinnedAsset()->GetRefSkeleton() : AnimationSkele->GetReferenceSkeleton();
 		FTransform LocalTransform;
 
-		const TArray<FTrackToSkeletonMap>& TrackMap = HandTargetAnimation->GetCompressedTrackToSkeletonMapTable();
+		const TArray<FTrackToSkeletonMap>& TrackMap = InAnimationSequence->GetCompressedTrackToSkeletonMapTable();
 		int32 TrackIndex = INDEX_NONE;
 
-		for (int32 BoneNameIndex = 0; BoneNameIndex < PoseSnapShot.BoneNames.Num(); ++BoneNameIndex)
+		OutPoseSnapShot.LocalTransforms.Reserve(OutPoseSnapShot.BoneNames.Num());
+
+		for (int32 BoneNameIndex = 0; BoneNameIndex < OutPoseSnapShot.BoneNames.Num(); ++BoneNameIndex)
 		{
+			const FName& BoneName = OutPoseSnapShot.BoneNames[BoneNameIndex];
+
 			TrackIndex = INDEX_NONE;
 			if (BoneNameIndex < TrackMap.Num() && TrackMap[BoneNameIndex].BoneTreeIndex == BoneNameIndex)
 			{
@@ -267,12 +281,10 @@ bool UHandSocketComponent::GetBlendedPoseSnapShot(FPoseSnapshot& PoseSnapShot, U
 				}
 			}
 
-			const FName& BoneName = PoseSnapShot.BoneNames[BoneNameIndex];
-
 			if (TrackIndex != INDEX_NONE && (!bSkipRootBone || TrackIndex != 0))
 			{
 				double TrackLocation = 0.0f;
-				HandTargetAnimation->GetBoneTransform(LocalTransform, FSkeletonPoseBoneIndex(TrackMap[TrackIndex].BoneTreeIndex), TrackLocation, false);
+				InAnimationSequence->GetBoneTransform(LocalTransform, FSkeletonPoseBoneIndex(TrackMap[TrackIndex].BoneTreeIndex), TrackLocation, false);
 			}
 			else
 			{
@@ -288,10 +300,10 @@ bool UHandSocketComponent::GetBlendedPoseSnapShot(FPoseSnapshot& PoseSnapShot, U
 				}
 			}
 
-			if (bUseCustomPoseDeltas)
+			if (CustomPoseDeltas)
 			{
 				FQuat DeltaQuat = FQuat::Identity;
-				if (FBPVRHandPoseBonePair* HandPair = CustomPoseDeltas.FindByKey(OrigBoneNames[BoneNameIndex]))
+				if (const FBPVRHandPoseBonePair* HandPair = CustomPoseDeltas->FindByKey(AnimationSkele->GetReferenceSkeleton().GetBoneName(BoneNameIndex)))
 				{
 					DeltaQuat = HandPair->DeltaPose;
 				}
@@ -309,12 +321,75 @@ bool UHandSocketComponent::GetBlendedPoseSnapShot(FPoseSnapshot& PoseSnapShot, U
 				LocalTransform.SetFromMatrix(M);
 			}
 
-			PoseSnapShot.LocalTransforms.Add(LocalTransform);
+			OutPoseSnapShot.LocalTransforms.Add(LocalTransform);
 		}
 
-		PoseSnapShot.bIsValid = true;
+		OutPoseSnapShot.bIsValid = true;
 		return true;
 	}
+
+	// Returns the cached snapshot if there is one, otherwise builds and caches it
+	static bool GetAnimationPoseSnapShot(UAnimSequence* InAnimationSequence, FPoseSnapshot& OutPoseSnapShot, USkeletalMeshComponent* TargetMesh, bool bSkipRootBone, bool bFlipHand, const TArray<FBPVRHandPoseBonePair>* CustomPoseDeltas)
+	{
+		if (!PoseCache.IsEnabled())
+		{
+			return BuildAnimationPoseSnapShot(InAnimationSequence, OutPoseSnapShot, TargetMesh, bSkipRootBone, bFlipHand, CustomPoseDeltas);
+		}
+
+		FKey Key;
+		Key.Animation = InAnimationSequence;
+		Key.TargetAsset = TargetMesh ? TargetMesh->GetSkinnedAsset() : nullptr;
+		Key.DeltasHash = HashDeltas(CustomPoseDeltas);
+		Key.bSkipRootBone = bSkipRootBone;
+		Key.bFlipHand = bFlipHand;
+
+		FCacheState& State = GetState();
+
+		{
+			FScopeLock ScopeLock(&State.Lock);
+
+			if (const FPoseSnapshot* CachedSnapshot = State.Snapshots.Find(Key))
+			{
+				OutPoseSnapShot = *CachedSnapshot;
+				return true;
+			}
+		}
+
+		if (!BuildAnimationPoseSnapShot(InAnimationSequence, OutPoseSnapShot, TargetMesh, bSkipRootBone, bFlipHand, CustomPoseDeltas))
+			return false;
+
+		FScopeLock ScopeLock(&State.Lock);
+		if (State.Snapshots.Num() >= MaxCachedSnapshots)
+		{
+			State.Snapshots.Reset();
+		}
+
+		State.Snapshots.Add(Key, OutPoseSnapShot);
+		return true;
+	}
+}
+
+void UHandSocketComponent::ClearPoseSnapShotCache()
+{
+	HandSocketPoseCache::ClearCache();
+}
+
+bool UHandSocketComponent::GetAnimationSequenceAsPoseSnapShot(UAnimSequence* InAnimationSequence, FPoseSnapshot& OutPoseSnapShot, USkeletalMeshComponent* TargetMesh, bool bSkipRootBone, bool bFlipHand)
+{
+	if (InAnimationSequence)
+	{
+		return HandSocketPoseCache::GetAnimationPoseSnapShot(InAnimationSequence, OutPoseSnapShot, TargetMesh, bSkipRootBone, bFlipHand, nullptr);
+	}
+
+	return false;
+}
+
+bool UHandSocketComponent::GetBlendedPoseSnapShot(FPoseSnapshot& PoseSnapShot, USkeletalMeshComponent* TargetMesh, bool bSkipRootBone, bool bFlipHand)
+{
+	if (HandTargetAnimation)// && bUseCustomPoseDeltas && CustomPoseDeltas.Num() > 0)
+	{
+		return HandSocketPoseCache::GetAnimationPoseSnapShot(HandTargetAnimation, PoseSnapShot, TargetMesh, bSkipRootBone, bFlipHand, bUseCustomPoseDeltas ? &CustomPoseDeltas : nullptr);
+	}
 	else if (bUseCustomPoseDeltas && CustomPoseDeltas.Num() && TargetMesh)
 	{
 		PoseSnapShot.SkeletalMeshName = TargetMesh->GetSkinnedAsset()->GetSkeleton()->GetFName();
@@ -332,18 +407,7 @@ bool UHandSocketComponent::GetBlendedPoseSnapShot(FPoseSnapshot& PoseSnapShot, U
 		{
 			if (bFlipHand)
 			{
-				FString bName = HandPair.BoneName.ToString();
-
-				if (bName.Contains("_r"))
-				{
-					bName = bName.Replace(TEXT("_r"), TEXT("_l"));
-				}
-				else
-				{
-					bName = bName.Replace(TEXT("_l"), TEXT("_r"));
-				}
-
-				TargetBoneName = FName(bName);
+				TargetBoneName = HandSocketPoseCache::GetMirroredBoneName(HandPair.BoneName);
 			}
 			else
 			{
@@ -768,9 +832,9 @@ void UHandSocketComponent::GetLifetimeReplicatedProps(TArray< class FLifetimePro
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	DOREPLIFETIME(UHandSocketComponent, bRepGameplayTags);
-	DOREPLIFETIME(UHandSocketComponent, bReplicateMovement);
-	DOREPLIFETIME_CONDITION(UHandSocketComponent, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME(UHandSocketComponent, bRepGameplayTags);
+	VRE_DOREPLIFETIME(UHandSocketComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME_CONDITION(UHandSocketComponent, GameplayTags, COND_Custom);
 }
 
 void UHandSocketComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
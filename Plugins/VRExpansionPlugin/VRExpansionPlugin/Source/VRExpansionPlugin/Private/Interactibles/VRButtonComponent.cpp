@@ -8,6 +8,8 @@
 #include "GripMotionControllerComponent.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/PlayerController.h"
+#include "Misc/VRPushModelHelpers.h"
+#include "Misc/VRInteractibleSimulationSubsystem.h"
 
   //=============================================================================
 UVRButtonComponent::UVRButtonComponent(const FObjectInitializer& ObjectInitializer)
@@ -37,6 +39,8 @@ UVRButtonComponent::UVRButtonComponent(const FObjectInitializer& ObjectInitializ
 	InitialRelativeTransform = FTransform::Identity;
 
 	bReplicateMovement = false;
+	bUseCompactStateReplication = false;
+	bCompactStateRegistered = false;
 }
 
 //=============================================================================
@@ -48,10 +52,10 @@ void UVRButtonComponent::GetLifetimeReplicatedProps(TArray< class FLifetimePrope
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UVRButtonComponent, InitialRelativeTransform);
-	DOREPLIFETIME(UVRButtonComponent, bReplicateMovement);
-	DOREPLIFETIME(UVRButtonComponent, StateChangeAuthorityType);
-	DOREPLIFETIME_CONDITION(UVRButtonComponent, bButtonState, COND_InitialOnly);
+	VRE_DOREPLIFETIME(UVRButtonComponent, InitialRelativeTransform);
+	VRE_DOREPLIFETIME(UVRButtonComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME(UVRButtonComponent, StateChangeAuthorityType);
+	VRE_DOREPLIFETIME_CONDITION(UVRButtonComponent, bButtonState, COND_InitialOnly);
 }
 
 void UVRButtonComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -61,9 +65,9 @@ void UVRButtonComponent::PreReplication(IRepChangedPropertyTracker & ChangedProp
 	// Replicate the levers initial transform if we are replicating movement
 	//DOREPLIFETIME_ACTIVE_OVERRIDE(UVRButtonComponent, InitialRelativeTransform, bReplicateMovement);
 	
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeLocation, bReplicateMovement);
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeRotation, bReplicateMovement);
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeScale3D, bReplicateMovement);
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeLocation, bReplicateMovement && !UsesCompactStateReplication());
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeRotation, bReplicateMovement && !UsesCompactStateReplication());
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeScale3D, bReplicateMovement && !UsesCompactStateReplication());
 }
 
 void UVRButtonComponent::OnRegister()
@@ -127,6 +131,7 @@ void UVRButtonComponent::TickComponent(float DeltaTime, enum ELevelTick TickType
 						LastToggleTime = WorldTime;
 						bToggledThisTouch = true;
 						bButtonState = !bButtonState;
+						VRE_MARK_PROPERTY_DIRTY(UVRButtonComponent, bButtonState, this);
 						ReceiveButtonStateChanged(bButtonState, LocalLastInteractingActor.Get(), LocalLastInteractingComponent.Get());
 						OnButtonStateChanged.Broadcast(bButtonState, LocalLastInteractingActor.Get(), LocalLastInteractingComponent.Get());
 					}
@@ -139,7 +144,7 @@ void UVRButtonComponent::TickComponent(float DeltaTime, enum ELevelTick TickType
 		// Std precision tolerance should be fine
 		if (this->GetRelativeLocation().Equals(GetTargetRelativeLocation()))
 		{
-			this->SetComponentTickEnabled(false);
+			UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 
 			OnButtonEndInteraction.Broadcast(LocalLastInteractingActor.Get(), LocalLastInteractingComponent.Get());
 			ReceiveButtonEndInteraction(LocalLastInteractingActor.Get(), LocalLastInteractingComponent.Get());
@@ -166,6 +171,7 @@ void UVRButtonComponent::TickComponent(float DeltaTime, enum ELevelTick TickType
 			{
 				LastToggleTime = WorldTime;
 				bButtonState = bCheckState;
+				VRE_MARK_PROPERTY_DIRTY(UVRButtonComponent, bButtonState, this);
 				ReceiveButtonStateChanged(bButtonState, LocalLastInteractingActor.Get(), LocalLastInteractingComponent.Get());
 				OnButtonStateChanged.Broadcast(bButtonState, LocalLastInteractingActor.Get(), LocalLastInteractingComponent.Get());
 			}
@@ -302,7 +308,7 @@ void UVRButtonComponent::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AAc
 		InitialComponentLoc = OriginalBaseTransform.InverseTransformPosition(this->GetComponentLocation());
 		bToggledThisTouch = false;
 
-		this->SetComponentTickEnabled(true);
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, true);
 
 		if (LocalInteractingComponent != LocalLastInteractingComponent.Get())
 		{
@@ -358,7 +364,7 @@ void UVRButtonComponent::SetButtonToRestingPosition(bool bLerpToPosition)
 			this->SetRelativeLocation(InitialRelativeTransform.TransformPosition(SetAxisValue(NewDepth)), false);
 		}
 		else
-			this->SetComponentTickEnabled(true); // This will trigger the lerp to resting position
+			UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, true); // This will trigger the lerp to resting position
 
 	}break;
 	default:break;
@@ -372,6 +378,7 @@ void UVRButtonComponent::SetButtonState(bool bNewButtonState, bool bCallButtonCh
 		return;
 
 	bButtonState = bNewButtonState;
+	VRE_MARK_PROPERTY_DIRTY(UVRButtonComponent, bButtonState, this);
 	SetButtonToRestingPosition(!bSnapIntoPosition);
 	LastToggleTime = GetWorld()->GetRealTimeSeconds();
 
@@ -386,6 +393,7 @@ void UVRButtonComponent::ResetInitialButtonLocation()
 {
 	// Get our initial relative transform to our parent (or not if un-parented).
 	InitialRelativeTransform = this->GetRelativeTransform();
+	VRE_MARK_PROPERTY_DIRTY(UVRButtonComponent, InitialRelativeTransform, this);
 }
 
 bool UVRButtonComponent::IsButtonInUse()
@@ -6,6 +6,8 @@
 #include "VRExpansionFunctionLibrary.h"
 #include "GripMotionControllerComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
+#include "Misc/VRInteractibleSimulationSubsystem.h"
 
   //=============================================================================
 UVRDialComponent::UVRDialComponent(const FObjectInitializer& ObjectInitializer)
@@ -19,6 +21,8 @@ UVRDialComponent::UVRDialComponent(const FObjectInitializer& ObjectInitializer)
 
 	// Defaulting these true so that they work by default in networked environments
 	bReplicateMovement = true;
+	bUseCompactStateReplication = false;
+	bCompactStateRegistered = false;
 
 	DialRotationAxis = EVRInteractibleAxis::Axis_Z;
 	InteractorRotationAxis = EVRInteractibleAxis::Axis_X;
@@ -63,12 +67,12 @@ void UVRDialComponent::GetLifetimeReplicatedProps(TArray< class FLifetimePropert
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UVRDialComponent, InitialRelativeTransform);
+	VRE_DOREPLIFETIME(UVRDialComponent, InitialRelativeTransform);
 	//DOREPLIFETIME_CONDITION(UVRDialComponent, bIsLerping, COND_InitialOnly);
 
-	DOREPLIFETIME(UVRDialComponent, bRepGameplayTags);
-	DOREPLIFETIME(UVRDialComponent, bReplicateMovement);
-	DOREPLIFETIME_CONDITION(UVRDialComponent, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME(UVRDialComponent, bRepGameplayTags);
+	VRE_DOREPLIFETIME(UVRDialComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME_CONDITION(UVRDialComponent, GameplayTags, COND_Custom);
 }
 
 void UVRDialComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -78,9 +82,9 @@ void UVRDialComponent::PreReplication(IRepChangedPropertyTracker & ChangedProper
 	// Don't replicate if set to not do it
 	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(UVRDialComponent, GameplayTags, bRepGameplayTags);
 
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeLocation, bReplicateMovement);
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeRotation, bReplicateMovement);
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeScale3D, bReplicateMovement);
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeLocation, bReplicateMovement && !UsesCompactStateReplication());
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeRotation, bReplicateMovement && !UsesCompactStateReplication());
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeScale3D, bReplicateMovement && !UsesCompactStateReplication());
 }
 
 void UVRDialComponent::OnRegister()
@@ -117,7 +121,7 @@ void UVRDialComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 
 		if (CurRotBackEnd == 0.f)
 		{
-			this->SetComponentTickEnabled(false);
+			UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 			bIsLerping = false;
 			OnDialFinishedLerping.Broadcast();
 			ReceiveDialFinishedLerping();
@@ -125,7 +129,7 @@ void UVRDialComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 	}
 	else
 	{
-		this->SetComponentTickEnabled(false); 
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false); 
 	}
 }
 
@@ -280,10 +284,10 @@ void UVRDialComponent::OnGripRelease_Implementation(UGripMotionControllerCompone
 	if (bLerpBackOnRelease)
 	{
 		bIsLerping = true;
-		this->SetComponentTickEnabled(true);
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, true);
 	}
 	else
-		this->SetComponentTickEnabled(false);
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 
 	//OnDropped.Broadcast(ReleasingController, GripInformation, bWasSocketed);
 }
@@ -435,6 +439,7 @@ void UVRDialComponent::SetHeld_Implementation(UGripMotionControllerComponent * N
 			if(!bIsHeld)
 				bOriginalReplicatesMovement = bReplicateMovement;
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UVRDialComponent, bReplicateMovement, this);
 		}
 	}
 	else
@@ -443,6 +448,7 @@ void UVRDialComponent::SetHeld_Implementation(UGripMotionControllerComponent * N
 		if (MovementReplicationSetting != EGripMovementReplicationSettings::ForceServerSideMovement)
 		{
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UVRDialComponent, bReplicateMovement, this);
 		}
 	}
 
@@ -583,6 +589,7 @@ void UVRDialComponent::ResetInitialDialLocation()
 {
 	// Get our initial relative transform to our parent (or not if un-parented).
 	InitialRelativeTransform = this->GetRelativeTransform();
+	VRE_MARK_PROPERTY_DIRTY(UVRDialComponent, InitialRelativeTransform, this);
 	CurRotBackEnd = 0.0f;
 	CalculateDialProgress();
 }
@@ -0,0 +1,362 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Interactibles/VRInteractibleStateReplicationComponent.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VRInteractibleStateReplicationComponent)
+
+#include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
+#include "Interactibles/VRLeverComponent.h"
+#include "Interactibles/VRDialComponent.h"
+#include "Interactibles/VRSliderComponent.h"
+#include "Interactibles/VRButtonComponent.h"
+#include "Interactibles/VRInteractibleFunctionLibrary.h"
+#include "GameFramework/Actor.h"
+
+namespace VRInteractibleCompactState
+{
+	static uint16 Quantize(float Value, float Min, float Max, int32 NumBits)
+	{
+		const uint32 MaxValue = (1u << NumBits) - 1;
+		const float Alpha = Max > Min ? FMath::Clamp((Value - Min) / (Max - Min), 0.0f, 1.0f) : 0.0f;
+		return (uint16)FMath::RoundToInt(Alpha * MaxValue);
+	}
+
+	static float Dequantize(uint16 Value, float Min, float Max, int32 NumBits)
+	{
+		const uint32 MaxValue = (1u << NumBits) - 1;
+		return FMath::Lerp(Min, Max, (float)Value / MaxValue);
+	}
+
+	static FVector GetRotationAxis(EVRInteractibleAxis Axis)
+	{
+		return UVRInteractibleFunctionLibrary::SetAxisValueVec(Axis, 1.0f);
+	}
+
+	static bool IsSingleAxisLever(const UVRLeverComponent* Lever)
+	{
+		return Lever->LeverRotationAxis == EVRInteractibleLeverAxis::Axis_X || Lever->LeverRotationAxis == EVRInteractibleLeverAxis::Axis_Y || Lever->LeverRotationAxis == EVRInteractibleLeverAxis::Axis_Z;
+	}
+
+	// Signed angle in degrees around the axis, from the initial relative transform to the current one
+	static float GetTwistAngle(const USceneComponent* Interactible, const FTransform& InitialRelativeTransform, EVRInteractibleAxis Axis)
+	{
+		const FQuat DeltaQuat = Interactible->GetRelativeTransform().GetRelativeTransform(InitialRelativeTransform).GetRotation().GetNormalized();
+		return FRotator::NormalizeAxis(FMath::RadiansToDegrees(DeltaQuat.GetTwistAngle(GetRotationAxis(Axis))));
+	}
+
+	static FTransform GetTwistedTransform(const FTransform& InitialRelativeTransform, EVRInteractibleAxis Axis, float Angle)
+	{
+		return FTransform(FQuat(GetRotationAxis(Axis), FMath::DegreesToRadians(Angle))) * InitialRelativeTransform;
+	}
+
+	// Range of the slide along each axis, in the space of the initial relative transform (same as ClampSlideVector)
+	static void GetSlideRange(const UVRSliderComponent* Slider, FVector& OutMin, FVector& OutMax)
+	{
+		FVector ScaleFactor = FVector(1.0f);
+
+		if (Slider->bSlideDistanceIsInParentSpace)
+			ScaleFactor = ScaleFactor / Slider->InitialRelativeTransform.GetScale3D();
+
+		const FVector MinScale = (Slider->bUseLegacyLogic ? Slider->MinSlideDistance : Slider->MinSlideDistance.GetAbs()) * ScaleFactor;
+		const FVector Dist = (Slider->bUseLegacyLogic ? (Slider->MinSlideDistance + Slider->MaxSlideDistance) : (Slider->MinSlideDistance.GetAbs() + Slider->MaxSlideDistance.GetAbs())) * ScaleFactor;
+
+		OutMin = -MinScale;
+		OutMax = Dist - MinScale;
+	}
+
+	static bool ShouldSendState(const USceneComponent* Interactible)
+	{
+		if (const UVRLeverComponent* Lever = Cast<UVRLeverComponent>(Interactible))
+			return Lever->bReplicateMovement;
+		else if (const UVRDialComponent* Dial = Cast<UVRDialComponent>(Interactible))
+			return Dial->bReplicateMovement;
+		else if (const UVRSliderComponent* Slider = Cast<UVRSliderComponent>(Interactible))
+			return Slider->bReplicateMovement;
+		else if (const UVRButtonComponent* Button = Cast<UVRButtonComponent>(Interactible))
+			return Button->bReplicateMovement;
+
+		return false;
+	}
+
+	static void SetRegistered(USceneComponent* Interactible, bool bRegistered)
+	{
+		if (UVRLeverComponent* Lever = Cast<UVRLeverComponent>(Interactible))
+			Lever->bCompactStateRegistered = bRegistered;
+		else if (UVRDialComponent* Dial = Cast<UVRDialComponent>(Interactible))
+			Dial->bCompactStateRegistered = bRegistered;
+		else if (UVRSliderComponent* Slider = Cast<UVRSliderComponent>(Interactible))
+			Slider->bCompactStateRegistered = bRegistered;
+		else if (UVRButtonComponent* Button = Cast<UVRButtonComponent>(Interactible))
+			Button->bCompactStateRegistered = bRegistered;
+	}
+
+	static bool Pack(const USceneComponent* Interactible, int32 AngleBits, int32 ProgressBits, FVRInteractiblePackedState& OutState)
+	{
+		if (const UVRLeverComponent* Lever = Cast<UVRLeverComponent>(Interactible))
+		{
+			if (!IsSingleAxisLever(Lever))
+				return false;
+
+			OutState.NumBits = (uint8)AngleBits;
+			OutState.NumValues = 1;
+			OutState.Values[0] = Quantize(GetTwistAngle(Lever, Lever->InitialRelativeTransform, (EVRInteractibleAxis)Lever->LeverRotationAxis), -180.0f, 180.0f, AngleBits);
+			return true;
+		}
+		else if (const UVRDialComponent* Dial = Cast<UVRDialComponent>(Interactible))
+		{
+			OutState.NumBits = (uint8)AngleBits;
+			OutState.NumValues = 1;
+			OutState.Values[0] = Quantize(GetTwistAngle(Dial, Dial->InitialRelativeTransform, Dial->DialRotationAxis), -180.0f, 180.0f, AngleBits);
+			return true;
+		}
+		else if (const UVRSliderComponent* Slider = Cast<UVRSliderComponent>(Interactible))
+		{
+			OutState.NumBits = (uint8)ProgressBits;
+
+			if (Slider->SplineComponentToFollow != nullptr)
+			{
+				OutState.NumValues = 1;
+				OutState.Values[0] = Quantize(Slider->CurrentSliderProgress, 0.0f, 1.0f, ProgressBits);
+				return true;
+			}
+
+			FVector SlideMin, SlideMax;
+			GetSlideRange(Slider, SlideMin, SlideMax);
+			const FVector SlideLocation = Slider->InitialRelativeTransform.InverseTransformPosition(Slider->GetRelativeLocation());
+
+			// Only the axis that can move are sent, both sides know which those are
+			OutState.NumValues = 0;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (SlideMax[Axis] > SlideMin[Axis])
+					OutState.Values[OutState.NumValues++] = Quantize(SlideLocation[Axis], SlideMin[Axis], SlideMax[Axis], ProgressBits);
+			}
+
+			return true;
+		}
+		else if (const UVRButtonComponent* Button = Cast<UVRButtonComponent>(Interactible))
+		{
+			const FVector ButtonLocation = Button->InitialRelativeTransform.InverseTransformPosition(Button->GetRelativeLocation());
+			OutState.NumBits = (uint8)ProgressBits;
+			OutState.NumValues = 1;
+			OutState.Values[0] = Quantize(UVRInteractibleFunctionLibrary::GetAxisValue(Button->ButtonAxis, ButtonLocation), -Button->DepressDistance, 0.0f, ProgressBits);
+			return true;
+		}
+
+		return false;
+	}
+
+	static void Unpack(USceneComponent* Interactible, const FVRInteractiblePackedState& State)
+	{
+		if (!IsValid(Interactible) || State.NumValues < 1)
+			return;
+
+		if (UVRLeverComponent* Lever = Cast<UVRLeverComponent>(Interactible))
+		{
+			if (!IsSingleAxisLever(Lever))
+				return;
+
+			const float Angle = Dequantize(State.Values[0], -180.0f, 180.0f, State.NumBits);
+			Lever->SetRelativeTransform(GetTwistedTransform(Lever->InitialRelativeTransform, (EVRInteractibleAxis)Lever->LeverRotationAxis, Angle));
+
+			// Same as a replicated transform, the angle is updated but no events are thrown
+			Lever->ReCalculateCurrentAngle(false);
+		}
+		else if (UVRDialComponent* Dial = Cast<UVRDialComponent>(Interactible))
+		{
+			const float Angle = Dequantize(State.Values[0], -180.0f, 180.0f, State.NumBits);
+			Dial->SetRelativeTransform(GetTwistedTransform(Dial->InitialRelativeTransform, Dial->DialRotationAxis, Angle));
+		}
+		else if (UVRSliderComponent* Slider = Cast<UVRSliderComponent>(Interactible))
+		{
+			if (Slider->SplineComponentToFollow != nullptr)
+			{
+				Slider->SetSliderProgress(Dequantize(State.Values[0], 0.0f, 1.0f, State.NumBits));
+				return;
+			}
+
+			FVector SlideMin, SlideMax;
+			GetSlideRange(Slider, SlideMin, SlideMax);
+			FVector SlideLocation = Slider->InitialRelativeTransform.InverseTransformPosition(Slider->GetRelativeLocation());
+
+			int32 ValueIndex = 0;
+			for (int32 Axis = 0; Axis < 3 && ValueIndex < State.NumValues; ++Axis)
+			{
+				if (SlideMax[Axis] > SlideMin[Axis])
+					SlideLocation[Axis] = Dequantize(State.Values[ValueIndex++], SlideMin[Axis], SlideMax[Axis], State.NumBits);
+			}
+
+			Slider->SetRelativeLocation(Slider->InitialRelativeTransform.TransformPosition(SlideLocation));
+			Slider->CalculateSliderProgress();
+		}
+		else if (UVRButtonComponent* Button = Cast<UVRButtonComponent>(Interactible))
+		{
+			const float Depth = Dequantize(State.Values[0], -Button->DepressDistance, 0.0f, State.NumBits);
+			Button->SetRelativeLocation(Button->InitialRelativeTransform.TransformPosition(Button->SetAxisValue(Depth)));
+		}
+	}
+}
+
+bool FVRInteractiblePackedState::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint32 BitsMinusOne = FMath::Clamp<uint32>(NumBits, 1, 16) - 1;
+	Ar.SerializeInt(BitsMinusOne, 16);
+
+	uint32 ValueCount = FMath::Min<uint32>(NumValues, 3);
+	Ar.SerializeInt(ValueCount, 4);
+
+	if (Ar.IsLoading())
+	{
+		NumBits = (uint8)(BitsMinusOne + 1);
+		NumValues = (uint8)FMath::Min<uint32>(ValueCount, 3);
+	}
+
+	const uint32 MaxValue = 1u << NumBits;
+	for (int32 i = 0; i < NumValues; ++i)
+	{
+		uint32 Value = FMath::Min<uint32>(Values[i], MaxValue - 1);
+		Ar.SerializeInt(Value, MaxValue);
+		Values[i] = (uint16)Value;
+	}
+
+	return true;
+}
+
+void FVRInteractibleCompactState::PostReplicatedAdd(const struct FVRInteractibleCompactStateArray& InArraySerializer)
+{
+	VRInteractibleCompactState::Unpack(Interactible, PackedState);
+}
+
+void FVRInteractibleCompactState::PostReplicatedChange(const struct FVRInteractibleCompactStateArray& InArraySerializer)
+{
+	VRInteractibleCompactState::Unpack(Interactible, PackedState);
+}
+
+UVRInteractibleStateReplicationComponent::UVRInteractibleStateReplicationComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+
+	AngleBits = 12;
+	ProgressBits = 16;
+}
+
+void UVRInteractibleStateReplicationComponent::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	VRE_DOREPLIFETIME(UVRInteractibleStateReplicationComponent, CompactStates);
+}
+
+bool UVRInteractibleStateReplicationComponent::SupportsInteractible(const USceneComponent* Interactible)
+{
+	if (const UVRLeverComponent* Lever = Cast<UVRLeverComponent>(Interactible))
+		return Lever->bUseCompactStateReplication && VRInteractibleCompactState::IsSingleAxisLever(Lever);
+	else if (const UVRDialComponent* Dial = Cast<UVRDialComponent>(Interactible))
+		return Dial->bUseCompactStateReplication;
+	else if (const UVRSliderComponent* Slider = Cast<UVRSliderComponent>(Interactible))
+		return Slider->bUseCompactStateReplication;
+	else if (const UVRButtonComponent* Button = Cast<UVRButtonComponent>(Interactible))
+		return Button->bUseCompactStateReplication;
+
+	return false;
+}
+
+bool UVRInteractibleStateReplicationComponent::AddInteractible(USceneComponent* Interactible)
+{
+	if (!IsValid(Interactible) || !SupportsInteractible(Interactible))
+		return false;
+
+	for (const FVRInteractibleCompactState& Item : CompactStates.Items)
+	{
+		if (Item.Interactible == Interactible)
+			return false;
+	}
+
+	FVRInteractibleCompactState& NewItem = CompactStates.Items.AddDefaulted_GetRef();
+	NewItem.Interactible = Interactible;
+	VRInteractibleCompactState::Pack(Interactible, FMath::Clamp(AngleBits, 4, 16), FMath::Clamp(ProgressBits, 4, 16), NewItem.PackedState);
+	CompactStates.MarkItemDirty(NewItem);
+	VRE_MARK_PROPERTY_DIRTY(UVRInteractibleStateReplicationComponent, CompactStates, this);
+
+	VRInteractibleCompactState::SetRegistered(Interactible, true);
+	return true;
+}
+
+bool UVRInteractibleStateReplicationComponent::RemoveInteractible(USceneComponent* Interactible)
+{
+	for (int32 i = 0; i < CompactStates.Items.Num(); ++i)
+	{
+		if (CompactStates.Items[i].Interactible == Interactible)
+		{
+			CompactStates.Items.RemoveAtSwap(i);
+			CompactStates.MarkArrayDirty();
+			VRE_MARK_PROPERTY_DIRTY(UVRInteractibleStateReplicationComponent, CompactStates, this);
+
+			VRInteractibleCompactState::SetRegistered(Interactible, false);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UVRInteractibleStateReplicationComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AActor* Owner = GetOwner();
+	if (!Owner || !Owner->HasAuthority())
+		return;
+
+	TInlineComponentArray<USceneComponent*> SceneComponents(Owner);
+	for (USceneComponent* SceneComponent : SceneComponents)
+	{
+		if (SupportsInteractible(SceneComponent))
+			AddInteractible(SceneComponent);
+	}
+}
+
+void UVRInteractibleStateReplicationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Let them go back to replicating their transforms
+	for (FVRInteractibleCompactState& Item : CompactStates.Items)
+	{
+		if (IsValid(Item.Interactible))
+			VRInteractibleCompactState::SetRegistered(Item.Interactible, false);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UVRInteractibleStateReplicationComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	bool bChangedState = false;
+	const int32 ClampedAngleBits = FMath::Clamp(AngleBits, 4, 16);
+	const int32 ClampedProgressBits = FMath::Clamp(ProgressBits, 4, 16);
+
+	for (FVRInteractibleCompactState& Item : CompactStates.Items)
+	{
+		// Client authoritative movement turns bReplicateMovement off while it is held, same as the transform would be
+		if (!IsValid(Item.Interactible) || !VRInteractibleCompactState::ShouldSendState(Item.Interactible))
+			continue;
+
+		FVRInteractiblePackedState NewState;
+		if (VRInteractibleCompactState::Pack(Item.Interactible, ClampedAngleBits, ClampedProgressBits, NewState) && !(NewState == Item.PackedState))
+		{
+			Item.PackedState = NewState;
+			CompactStates.MarkItemDirty(Item);
+			bChangedState = true;
+		}
+	}
+
+	if (bChangedState)
+	{
+		VRE_MARK_PROPERTY_DIRTY(UVRInteractibleStateReplicationComponent, CompactStates, this);
+	}
+}
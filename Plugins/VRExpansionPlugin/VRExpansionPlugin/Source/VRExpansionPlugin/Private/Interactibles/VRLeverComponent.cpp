@@ -6,6 +6,8 @@
 #include "GripMotionControllerComponent.h"
 #include "VRExpansionFunctionLibrary.h"
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
+#include "Misc/VRInteractibleSimulationSubsystem.h"
 
   //=============================================================================
 UVRLeverComponent::UVRLeverComponent(const FObjectInitializer& ObjectInitializer)
@@ -19,6 +21,8 @@ UVRLeverComponent::UVRLeverComponent(const FObjectInitializer& ObjectInitializer
 
 	// Defaulting these true so that they work by default in networked environments
 	bReplicateMovement = true;
+	bUseCompactStateReplication = false;
+	bCompactStateRegistered = false;
 
 	MovementReplicationSetting = EGripMovementReplicationSettings::ForceClientSideMovement;
 	BreakDistance = 100.0f;
@@ -85,12 +89,12 @@ void UVRLeverComponent::GetLifetimeReplicatedProps(TArray< class FLifetimeProper
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UVRLeverComponent, InitialRelativeTransform);
+	VRE_DOREPLIFETIME(UVRLeverComponent, InitialRelativeTransform);
 	//DOREPLIFETIME_CONDITION(UVRLeverComponent, bIsLerping, COND_InitialOnly);
 
-	DOREPLIFETIME(UVRLeverComponent, bRepGameplayTags);
-	DOREPLIFETIME(UVRLeverComponent, bReplicateMovement);
-	DOREPLIFETIME_CONDITION(UVRLeverComponent, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME(UVRLeverComponent, bRepGameplayTags);
+	VRE_DOREPLIFETIME(UVRLeverComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME_CONDITION(UVRLeverComponent, GameplayTags, COND_Custom);
 }
 
 void UVRLeverComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -103,9 +107,9 @@ void UVRLeverComponent::PreReplication(IRepChangedPropertyTracker & ChangedPrope
 	// Don't replicate if set to not do it
 	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(UVRLeverComponent, GameplayTags, bRepGameplayTags);
 
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeLocation, bReplicateMovement);
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeRotation, bReplicateMovement);
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeScale3D,	bReplicateMovement);
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeLocation, bReplicateMovement && !UsesCompactStateReplication());
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeRotation, bReplicateMovement && !UsesCompactStateReplication());
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeScale3D,	bReplicateMovement && !UsesCompactStateReplication());
 }
 
 void UVRLeverComponent::OnRegister()
@@ -165,9 +169,10 @@ void UVRLeverComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 
 			if (LerpedQuat.IsIdentity())
 			{
-				this->SetComponentTickEnabled(false);
+				UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 				bIsLerping = false;
 				bReplicateMovement = bOriginalReplicatesMovement;
+				VRE_MARK_PROPERTY_DIRTY(UVRLeverComponent, bReplicateMovement, this);
 				this->SetRelativeRotation(InitialRelativeTransform.Rotator());
 			}
 			else
@@ -432,7 +437,7 @@ void UVRLeverComponent::OnGrip_Implementation(UGripMotionControllerComponent * G
 	bIsInFirstTick = true;
 	MomentumAtDrop = 0.0f;
 
-	this->SetComponentTickEnabled(true);
+	UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, true);
 
 	//OnGripped.Broadcast(GrippingController, GripInformation);
 }
@@ -442,14 +447,18 @@ void UVRLeverComponent::OnGripRelease_Implementation(UGripMotionControllerCompon
 	if (LeverReturnTypeWhenReleased != EVRInteractibleLeverReturnType::Stay)
 	{		
 		bIsLerping = true;
-		this->SetComponentTickEnabled(true);
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, true);
 		if (MovementReplicationSetting != EGripMovementReplicationSettings::ForceServerSideMovement)
+		{
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UVRLeverComponent, bReplicateMovement, this);
+		}
 	}
 	else
 	{
-		this->SetComponentTickEnabled(false);
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 		bReplicateMovement = bOriginalReplicatesMovement;
+		VRE_MARK_PROPERTY_DIRTY(UVRLeverComponent, bReplicateMovement, this);
 	}
 
 	//OnDropped.Broadcast(ReleasingController, GripInformation, bWasSocketed);
@@ -597,6 +606,7 @@ void UVRLeverComponent::SetHeld_Implementation(UGripMotionControllerComponent *
 			if (!bIsHeld && !bIsLerping)
 				bOriginalReplicatesMovement = bReplicateMovement;
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UVRLeverComponent, bReplicateMovement, this);
 		}
 	}
 	else
@@ -605,6 +615,7 @@ void UVRLeverComponent::SetHeld_Implementation(UGripMotionControllerComponent *
 		if (MovementReplicationSetting != EGripMovementReplicationSettings::ForceServerSideMovement)
 		{
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UVRLeverComponent, bReplicateMovement, this);
 		}
 	}
 
@@ -655,6 +666,7 @@ void UVRLeverComponent::ResetInitialLeverLocation(bool bAllowThrowingEvents)
 {
 	// Get our initial relative transform to our parent (or not if un-parented).
 	InitialRelativeTransform = this->GetRelativeTransform();
+	VRE_MARK_PROPERTY_DIRTY(UVRLeverComponent, InitialRelativeTransform, this);
 	CalculateCurrentAngle(InitialRelativeTransform);
 	ProccessCurrentState(bIsLerping, bAllowThrowingEvents, bAllowThrowingEvents);
 }
@@ -740,9 +752,10 @@ void UVRLeverComponent::LerpAxis(float CurrentAngle, float DeltaTime)
 		if (FMath::IsNearlyZero(MomentumAtDrop * DeltaTime, 0.1f))
 		{
 			MomentumAtDrop = 0.0f;
-			this->SetComponentTickEnabled(false);
+			UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 			bIsLerping = false;
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UVRLeverComponent, bReplicateMovement, this);
 			return;
 		}
 		else
@@ -776,9 +789,10 @@ void UVRLeverComponent::LerpAxis(float CurrentAngle, float DeltaTime)
 		}
 		else
 		{
-			this->SetComponentTickEnabled(false);
+			UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 			bIsLerping = false;
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UVRLeverComponent, bReplicateMovement, this);
 			FTransform CalcTransform = (FTransform(UVRInteractibleFunctionLibrary::SetAxisValueRot((EVRInteractibleAxis)LeverRotationAxis, TargetAngle, FRotator::ZeroRotator)) * InitialRelativeTransform);
 			this->SetRelativeRotation(CalcTransform.Rotator());
 		}
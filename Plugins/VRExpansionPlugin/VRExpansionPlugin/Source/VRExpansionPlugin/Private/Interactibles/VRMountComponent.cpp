@@ -8,6 +8,8 @@
 //#include "PhysicsPublic.h"
 //#include "PhysicsEngine/ConstraintInstance.h"
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
+#include "Misc/VRInteractibleSimulationSubsystem.h"
 
 //=============================================================================
 UVRMountComponent::UVRMountComponent(const FObjectInitializer& ObjectInitializer)
@@ -58,9 +60,9 @@ void UVRMountComponent::GetLifetimeReplicatedProps(TArray< class FLifetimeProper
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UVRMountComponent, bRepGameplayTags);
-	DOREPLIFETIME(UVRMountComponent, bReplicateMovement);
-	DOREPLIFETIME_CONDITION(UVRMountComponent, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME(UVRMountComponent, bRepGameplayTags);
+	VRE_DOREPLIFETIME(UVRMountComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME_CONDITION(UVRMountComponent, GameplayTags, COND_Custom);
 }
 
 void UVRMountComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -425,12 +427,12 @@ void UVRMountComponent::OnGrip_Implementation(UGripMotionControllerComponent * G
 		
 
 
-	this->SetComponentTickEnabled(true);
+	UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, true);
 }
 
 void UVRMountComponent::OnGripRelease_Implementation(UGripMotionControllerComponent * ReleasingController, const FBPActorGripInformation & GripInformation, bool bWasSocketed)
 {
-		this->SetComponentTickEnabled(false);
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 }
 
 void UVRMountComponent::SetGripPriority(int NewGripPriority)
@@ -558,6 +560,7 @@ void UVRMountComponent::SetHeld_Implementation(UGripMotionControllerComponent *
 			if (!bIsHeld)
 				bOriginalReplicatesMovement = bReplicateMovement;
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UVRMountComponent, bReplicateMovement, this);
 		}
 	}
 	else
@@ -566,6 +569,7 @@ void UVRMountComponent::SetHeld_Implementation(UGripMotionControllerComponent *
 		if (MovementReplicationSetting != EGripMovementReplicationSettings::ForceServerSideMovement)
 		{
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UVRMountComponent, bReplicateMovement, this);
 		}
 	}
 
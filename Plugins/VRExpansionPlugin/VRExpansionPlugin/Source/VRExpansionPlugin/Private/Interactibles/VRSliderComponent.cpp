@@ -7,6 +7,232 @@
 #include "Components/SplineComponent.h"
 #include "GripMotionControllerComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
+#include "Misc/VRInteractibleSimulationSubsystem.h"
+#include "HAL/IConsoleManager.h"
+
+namespace VRSliderCVars
+{
+	static int32 UseSplineLookup = 1;
+	FAutoConsoleVariableRef CVarUseSplineLookup(
+		TEXT("vre.Slider.UseSplineLookup"),
+		UseSplineLookup,
+		TEXT("When on, spline following sliders find their closest spline key from a sampled lookup of the spline instead of searching all of its segments.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+}
+
+namespace VRSliderSplineLookup
+{
+	// Every segment is split at least this many times so that small loops can't be stepped over
+	static const int32 MinStepsPerSegment = 4;
+
+	// Smallest key range that is split further
+	static const float MinKeyStep = 1.0f / 128.0f;
+
+	// Allowed distance between the curve and the line between two samples, in the splines local units
+	static const float SampleTolerance = 0.25f;
+
+	static const int32 MaxRefineIterations = 3;
+}
+
+bool FVRSliderSplineLookup::IsValidFor(const USplineComponent* InSpline) const
+{
+	return InSpline && Spline.Get() == InSpline && SplineVersion == InSpline->SplineCurves.Version && bClosedLoop == InSpline->IsClosedLoop();
+}
+
+void FVRSliderSplineLookup::Reset()
+{
+	Keys.Reset();
+	Points.Reset();
+	Spline.Reset();
+	SplineVersion = 0;
+	bClosedLoop = false;
+	MaxSampleSpacing = 0.0f;
+	LastSampleIndex = INDEX_NONE;
+	LastQueryLocation = FVector::ZeroVector;
+}
+
+void FVRSliderSplineLookup::Build(const USplineComponent* InSpline)
+{
+	Reset();
+
+	if (!InSpline)
+		return;
+
+	Spline = InSpline;
+	SplineVersion = InSpline->SplineCurves.Version;
+	bClosedLoop = InSpline->IsClosedLoop();
+
+	const FInterpCurveVector& Position = InSpline->SplineCurves.Position;
+	const int32 NumPoints = Position.Points.Num();
+	const int32 NumSegments = bClosedLoop ? NumPoints : NumPoints - 1;
+
+	if (NumPoints < 1)
+		return;
+
+	Keys.Add(0.0f);
+	Points.Add(Position.Eval(0.0f));
+
+	// Key ranges still to be sampled, split depth first so that samples are added in key order
+	TArray<TPair<float, float>, TInlineAllocator<32>> PendingRanges;
+
+	for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+	{
+		for (int32 Step = VRSliderSplineLookup::MinStepsPerSegment; Step > 0; --Step)
+		{
+			PendingRanges.Emplace(Segment + (float)(Step - 1) / VRSliderSplineLookup::MinStepsPerSegment, Segment + (float)Step / VRSliderSplineLookup::MinStepsPerSegment);
+		}
+
+		while (PendingRanges.Num())
+		{
+			const TPair<float, float> Range = PendingRanges.Pop(false);
+			const float MidKey = (Range.Key + Range.Value) * 0.5f;
+
+			const FVector& StartPoint = Points.Last();
+			const FVector EndPoint = Position.Eval(Range.Value);
+
+			if ((Range.Value - Range.Key) > VRSliderSplineLookup::MinKeyStep &&
+				FMath::PointDistToSegmentSquared(Position.Eval(MidKey), StartPoint, EndPoint) > FMath::Square(VRSliderSplineLookup::SampleTolerance))
+			{
+				PendingRanges.Emplace(MidKey, Range.Value);
+				PendingRanges.Emplace(Range.Key, MidKey);
+				continue;
+			}
+
+			MaxSampleSpacing = FMath::Max(MaxSampleSpacing, (float)FVector::Dist(StartPoint, EndPoint));
+			Keys.Add(Range.Value);
+			Points.Add(EndPoint);
+		}
+	}
+}
+
+int32 FVRSliderSplineLookup::GetPrevSample(int32 Index) const
+{
+	// On closed loops the last sample is the first one again
+	if (Index > 0)
+		return Index - 1;
+
+	return bClosedLoop && Points.Num() > 2 ? Points.Num() - 2 : INDEX_NONE;
+}
+
+int32 FVRSliderSplineLookup::GetNextSample(int32 Index) const
+{
+	if (Index < Points.Num() - 1)
+		return Index + 1;
+
+	return bClosedLoop && Points.Num() > 2 ? 1 : INDEX_NONE;
+}
+
+float FVRSliderSplineLookup::FindInputKeyClosestToLocalLocation(const USplineComponent* InSpline, const FVector& LocalLocation, bool bWarmStart)
+{
+	const int32 NumSamples = Points.Num();
+	if (NumSamples < 2)
+		return 0.0f;
+
+	int32 BestIndex = INDEX_NONE;
+	float BestDistSq = 0.0f;
+
+	if (bWarmStart && Points.IsValidIndex(LastSampleIndex) && FVector::DistSquared(LocalLocation, LastQueryLocation) <= FMath::Square(MaxSampleSpacing))
+	{
+		// A held slider only moves a sample or two each frame, so walk downhill from where it was
+		BestIndex = LastSampleIndex;
+		BestDistSq = FVector::DistSquared(Points[BestIndex], LocalLocation);
+
+		for (int32 Steps = 0; Steps < NumSamples; ++Steps)
+		{
+			int32 NextBest = INDEX_NONE;
+
+			for (const int32 Neighbor : { GetPrevSample(BestIndex), GetNextSample(BestIndex) })
+			{
+				if (Neighbor == INDEX_NONE)
+					continue;
+
+				const float DistSq = FVector::DistSquared(Points[Neighbor], LocalLocation);
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					NextBest = Neighbor;
+				}
+			}
+
+			if (NextBest == INDEX_NONE)
+				break;
+
+			BestIndex = NextBest;
+		}
+	}
+	else
+	{
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			const float DistSq = FVector::DistSquared(Points[i], LocalLocation);
+			if (BestIndex == INDEX_NONE || DistSq < BestDistSq)
+			{
+				BestIndex = i;
+				BestDistSq = DistSq;
+			}
+		}
+	}
+
+	LastSampleIndex = BestIndex;
+	LastQueryLocation = LocalLocation;
+
+	// Project onto the lines to either side of the closest sample
+	float BestKey = Keys[BestIndex];
+	float BestLineDistSq = BestDistSq;
+
+	auto ProjectOntoLine = [&](int32 StartIndex)
+	{
+		if (StartIndex == INDEX_NONE)
+			return;
+
+		const FVector& LineStart = Points[StartIndex];
+		const FVector Line = Points[StartIndex + 1] - LineStart;
+		const float LineSizeSq = Line.SizeSquared();
+		const float Alpha = LineSizeSq > SMALL_NUMBER ? FMath::Clamp((float)((LocalLocation - LineStart) | Line) / LineSizeSq, 0.0f, 1.0f) : 0.0f;
+		const float DistSq = FVector::DistSquared(LineStart + Line * Alpha, LocalLocation);
+
+		if (DistSq < BestLineDistSq)
+		{
+			BestLineDistSq = DistSq;
+			BestKey = FMath::Lerp(Keys[StartIndex], Keys[StartIndex + 1], Alpha);
+		}
+	};
+
+	ProjectOntoLine(BestIndex > 0 ? BestIndex - 1 : (bClosedLoop ? NumSamples - 2 : INDEX_NONE));
+	ProjectOntoLine(BestIndex < NumSamples - 1 ? BestIndex : (bClosedLoop ? 0 : INDEX_NONE));
+
+	// Then a few newton steps on the curve itself, kept only if they got closer
+	const FInterpCurveVector& Position = InSpline->SplineCurves.Position;
+	const float MaxKey = Keys.Last();
+	const float MaxKeyStep = 1.0f / VRSliderSplineLookup::MinStepsPerSegment;
+
+	float RefinedKey = BestKey;
+	for (int32 Iteration = 0; Iteration < VRSliderSplineLookup::MaxRefineIterations; ++Iteration)
+	{
+		const FVector Delta = Position.Eval(RefinedKey) - LocalLocation;
+		const FVector Tangent = Position.EvalDerivative(RefinedKey);
+		const FVector SecondDerivative = Position.EvalSecondDerivative(RefinedKey);
+
+		const float Numerator = (float)(Tangent | Delta);
+		const float Denominator = (float)(Tangent.SizeSquared() + (SecondDerivative | Delta));
+
+		if (Denominator <= SMALL_NUMBER)
+			break;
+
+		const float KeyStep = FMath::Clamp(-Numerator / Denominator, -MaxKeyStep, MaxKeyStep);
+		RefinedKey = FMath::Clamp(RefinedKey + KeyStep, 0.0f, MaxKey);
+
+		if (FMath::Abs(KeyStep) < KINDA_SMALL_NUMBER)
+			break;
+	}
+
+	if (RefinedKey != BestKey && FVector::DistSquared(Position.Eval(RefinedKey), LocalLocation) < FVector::DistSquared(Position.Eval(BestKey), LocalLocation))
+		return RefinedKey;
+
+	return BestKey;
+}
 
   //=============================================================================
 UVRSliderComponent::UVRSliderComponent(const FObjectInitializer& ObjectInitializer)
@@ -20,6 +246,8 @@ UVRSliderComponent::UVRSliderComponent(const FObjectInitializer& ObjectInitializ
 
 	// Defaulting these true so that they work by default in networked environments
 	bReplicateMovement = true;
+	bUseCompactStateReplication = false;
+	bCompactStateRegistered = false;
 
 	MovementReplicationSetting = EGripMovementReplicationSettings::ForceClientSideMovement;
 	BreakDistance = 100.0f;
@@ -84,13 +312,13 @@ void UVRSliderComponent::GetLifetimeReplicatedProps(TArray< class FLifetimePrope
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UVRSliderComponent, InitialRelativeTransform);
-	DOREPLIFETIME(UVRSliderComponent, SplineComponentToFollow);
+	VRE_DOREPLIFETIME(UVRSliderComponent, InitialRelativeTransform);
+	VRE_DOREPLIFETIME(UVRSliderComponent, SplineComponentToFollow);
 	//DOREPLIFETIME_CONDITION(UVRSliderComponent, bIsLerping, COND_InitialOnly);
 
-	DOREPLIFETIME(UVRSliderComponent, bRepGameplayTags);
-	DOREPLIFETIME(UVRSliderComponent, bReplicateMovement);
-	DOREPLIFETIME_CONDITION(UVRSliderComponent, GameplayTags, COND_Custom);
+	VRE_DOREPLIFETIME(UVRSliderComponent, bRepGameplayTags);
+	VRE_DOREPLIFETIME(UVRSliderComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME_CONDITION(UVRSliderComponent, GameplayTags, COND_Custom);
 }
 
 void UVRSliderComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -104,9 +332,9 @@ void UVRSliderComponent::PreReplication(IRepChangedPropertyTracker & ChangedProp
 	// Don't replicate if set to not do it
 	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(UVRSliderComponent, GameplayTags, bRepGameplayTags);
 
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeLocation, bReplicateMovement);
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeRotation, bReplicateMovement);
-	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeScale3D, bReplicateMovement);
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeLocation, bReplicateMovement && !UsesCompactStateReplication());
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeRotation, bReplicateMovement && !UsesCompactStateReplication());
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USceneComponent, RelativeScale3D, bReplicateMovement && !UsesCompactStateReplication());
 }
 
 void UVRSliderComponent::OnRegister()
@@ -161,8 +389,9 @@ void UVRSliderComponent::TickComponent(float DeltaTime, enum ELevelTick TickType
 		OnSliderFinishedLerping.Broadcast(CurrentSliderProgress);
 		ReceiveSliderFinishedLerping(CurrentSliderProgress);
 
-		this->SetComponentTickEnabled(false);
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 		bReplicateMovement = bOriginalReplicatesMovement;
+		VRE_MARK_PROPERTY_DIRTY(UVRSliderComponent, bReplicateMovement, this);
 
 		return;
 	}
@@ -260,8 +489,9 @@ void UVRSliderComponent::TickComponent(float DeltaTime, enum ELevelTick TickType
 			OnSliderFinishedLerping.Broadcast(CurrentSliderProgress);
 			ReceiveSliderFinishedLerping(CurrentSliderProgress);
 
-			this->SetComponentTickEnabled(false);
+			UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UVRSliderComponent, bReplicateMovement, this);
 		}
 		
 		// Check for the hit point always
@@ -299,7 +529,7 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 	if (SplineComponentToFollow != nullptr)
 	{
 		FVector WorldCalculatedLocation = CurrentRelativeTransform.TransformPosition(CalculatedLocation);
-		float ClosestKey = SplineComponentToFollow->FindInputKeyClosestToWorldLocation(WorldCalculatedLocation);
+		float ClosestKey = FindSplineInputKeyClosestToWorldLocation(WorldCalculatedLocation, true);
 
 		if (bSliderUsesSnapPoints)
 		{
@@ -344,7 +574,8 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 			}
 			else if (bLerpToNewKey)
 			{
-				trans = SplineComponentToFollow->FindTransformClosestToWorldLocation(WorldCalculatedLocation, ESplineCoordinateSpace::World, true);
+				// WorldCalculatedLocation is either the original location or the location at the snapped key, ClosestKey is its key in both cases
+				trans = SplineComponentToFollow->GetTransformAtSplineInputKey(ClosestKey, ESplineCoordinateSpace::World, true);
 				bChangedLocation = true;
 			}
 
@@ -366,7 +597,7 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 			}
 			else if (bLerpToNewKey)
 			{
-				WorldLocation = SplineComponentToFollow->FindLocationClosestToWorldLocation(WorldCalculatedLocation, ESplineCoordinateSpace::World);
+				WorldLocation = SplineComponentToFollow->GetLocationAtSplineInputKey(ClosestKey, ESplineCoordinateSpace::World);
 				bChangedLocation = true;
 			}
 
@@ -505,10 +736,11 @@ void UVRSliderComponent::OnGrip_Implementation(UGripMotionControllerComponent *
 	if (GripInformation.GripMovementReplicationSetting != EGripMovementReplicationSettings::ForceServerSideMovement)
 	{
 		bReplicateMovement = false;
+		VRE_MARK_PROPERTY_DIRTY(UVRSliderComponent, bReplicateMovement, this);
 	}
 
 	if (bUpdateInTick)
-		SetComponentTickEnabled(true);
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, true);
 
 	//OnGripped.Broadcast(GrippingController, GripInformation);
 
@@ -521,7 +753,7 @@ void UVRSliderComponent::OnGripRelease_Implementation(UGripMotionControllerCompo
 	if (SliderBehaviorWhenReleased != EVRInteractibleSliderDropBehavior::Stay)
 	{
 		bIsLerping = true;
-		this->SetComponentTickEnabled(true);
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, true);
 
 		FVector Len = (MinSlideDistance.GetAbs() + MaxSlideDistance.GetAbs());
 		if(bSlideDistanceIsInParentSpace)
@@ -538,12 +770,16 @@ void UVRSliderComponent::OnGripRelease_Implementation(UGripMotionControllerCompo
 		}
 
 		if(MovementReplicationSetting != EGripMovementReplicationSettings::ForceServerSideMovement)
+		{
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UVRSliderComponent, bReplicateMovement, this);
+		}
 	}
 	else
 	{
-		this->SetComponentTickEnabled(false);
+		UVRInteractibleSimulationSubsystem::SetInteractibleAwake(this, false);
 		bReplicateMovement = bOriginalReplicatesMovement;
+		VRE_MARK_PROPERTY_DIRTY(UVRSliderComponent, bReplicateMovement, this);
 	}
 
 	//OnDropped.Broadcast(ReleasingController, GripInformation, bWasSocketed);
@@ -700,6 +936,7 @@ void UVRSliderComponent::SetHeld_Implementation(UGripMotionControllerComponent *
 			if (!bIsHeld && !bIsLerping)
 				bOriginalReplicatesMovement = bReplicateMovement;
 			bReplicateMovement = false;
+			VRE_MARK_PROPERTY_DIRTY(UVRSliderComponent, bReplicateMovement, this);
 		}
 	}
 	else
@@ -708,6 +945,7 @@ void UVRSliderComponent::SetHeld_Implementation(UGripMotionControllerComponent *
 		if (MovementReplicationSetting != EGripMovementReplicationSettings::ForceServerSideMovement)
 		{
 			bReplicateMovement = bOriginalReplicatesMovement;
+			VRE_MARK_PROPERTY_DIRTY(UVRSliderComponent, bReplicateMovement, this);
 		}
 	}
 
@@ -831,7 +1069,7 @@ float UVRSliderComponent::GetCurrentSliderProgress(FVector CurLocation, bool bUs
 		float ClosestKey = CurKey;
 
 		if (!bUseKeyInstead)
-			ClosestKey = SplineComponentToFollow->FindInputKeyClosestToWorldLocation(CurLocation);
+			ClosestKey = FindSplineInputKeyClosestToWorldLocation(CurLocation);
 
 		/*int32 primaryKey = FMath::TruncToInt(ClosestKey);
 
@@ -888,9 +1126,28 @@ void UVRSliderComponent::GetLerpedKey(float &ClosestKey, float DeltaTime)
 	}
 }
 
+float UVRSliderComponent::FindSplineInputKeyClosestToWorldLocation(const FVector& WorldLocation, bool bWarmStart)
+{
+	if (VRSliderCVars::UseSplineLookup <= 0)
+		return SplineComponentToFollow->FindInputKeyClosestToWorldLocation(WorldLocation);
+
+	// The spline can be set directly or edited after it was assigned
+	if (!SplineLookup.IsValidFor(SplineComponentToFollow))
+		SplineLookup.Build(SplineComponentToFollow);
+
+	const FVector LocalLocation = SplineComponentToFollow->GetComponentTransform().InverseTransformPosition(WorldLocation);
+	return SplineLookup.FindInputKeyClosestToLocalLocation(SplineComponentToFollow, LocalLocation, bWarmStart);
+}
+
 void UVRSliderComponent::SetSplineComponentToFollow(USplineComponent * SplineToFollow)
 {
 	SplineComponentToFollow = SplineToFollow;
+	VRE_MARK_PROPERTY_DIRTY(UVRSliderComponent, SplineComponentToFollow, this);
+
+	if (SplineToFollow != nullptr)
+		SplineLookup.Build(SplineToFollow);
+	else
+		SplineLookup.Reset();
 	
 	if (SplineToFollow != nullptr)
 		ResetToParentSplineLocation();
@@ -902,6 +1159,7 @@ void UVRSliderComponent::ResetInitialSliderLocation()
 {
 	// Get our initial relative transform to our parent (or not if un-parented).
 	InitialRelativeTransform = this->GetRelativeTransform();
+	VRE_MARK_PROPERTY_DIRTY(UVRSliderComponent, InitialRelativeTransform, this);
 	ResetToParentSplineLocation();
 
 	if (SplineComponentToFollow == nullptr)
@@ -913,7 +1171,7 @@ void UVRSliderComponent::ResetToParentSplineLocation()
 	if (SplineComponentToFollow != nullptr)
 	{
 		FTransform ParentTransform = UVRInteractibleFunctionLibrary::Interactible_GetCurrentParentTransform(this);
-		FTransform WorldTransform = SplineComponentToFollow->FindTransformClosestToWorldLocation(this->GetComponentLocation(), ESplineCoordinateSpace::World, true);
+		FTransform WorldTransform = SplineComponentToFollow->GetTransformAtSplineInputKey(FindSplineInputKeyClosestToWorldLocation(this->GetComponentLocation()), ESplineCoordinateSpace::World, true);
 		if (bFollowSplineRotationAndScale)
 		{
 			WorldTransform.MultiplyScale3D(InitialRelativeTransform.GetScale3D());
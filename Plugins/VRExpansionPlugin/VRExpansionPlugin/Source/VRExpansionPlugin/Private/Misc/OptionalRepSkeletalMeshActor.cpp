@@ -7,6 +7,7 @@
 #include "Net/UnrealNetwork.h"
 #include "PhysicsReplication.h"
 #include "PhysicsEngine/PhysicsAsset.h"
+#include "Misc/VRPushModelHelpers.h"
 #if WITH_PUSH_MODEL
 #include "Net/Core/PushModel/PushModel.h"
 #endif
@@ -30,7 +31,7 @@ void UNoRepSphereComponent::GetLifetimeReplicatedProps(TArray< class FLifetimePr
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UNoRepSphereComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME(UNoRepSphereComponent, bReplicateMovement);
 
 	RESET_REPLIFETIME_CONDITION_PRIVATE_PROPERTY(USceneComponent, AttachParent, COND_InitialOnly);
 	RESET_REPLIFETIME_CONDITION_PRIVATE_PROPERTY(USceneComponent, AttachSocketName, COND_InitialOnly);
@@ -632,7 +633,7 @@ void UInversePhysicsSkeletalMeshComponent::GetLifetimeReplicatedProps(TArray< cl
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UInversePhysicsSkeletalMeshComponent, bReplicateMovement);
+	VRE_DOREPLIFETIME(UInversePhysicsSkeletalMeshComponent, bReplicateMovement);
 }
 
 AOptionalRepGrippableSkeletalMeshActor::AOptionalRepGrippableSkeletalMeshActor(const FObjectInitializer& ObjectInitializer) :
@@ -646,8 +647,8 @@ void AOptionalRepGrippableSkeletalMeshActor::GetLifetimeReplicatedProps(TArray<
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AOptionalRepGrippableSkeletalMeshActor, bIgnoreAttachmentReplication);
-	DOREPLIFETIME(AOptionalRepGrippableSkeletalMeshActor, bIgnorePhysicsReplication);
+	VRE_DOREPLIFETIME(AOptionalRepGrippableSkeletalMeshActor, bIgnoreAttachmentReplication);
+	VRE_DOREPLIFETIME(AOptionalRepGrippableSkeletalMeshActor, bIgnorePhysicsReplication);
 
 	if (bIgnoreAttachmentReplication)
 	{
@@ -14,6 +14,7 @@
 #include "Perception/AISightTargetInterface.h"
 #include "Perception/AISenseConfig_Sight.h"
 #include "Perception/AIPerceptionSystem.h"
+#include "GripMotionControllerComponent.h"
 
 #if WITH_GAMEPLAY_DEBUGGER
 #include "GameplayDebuggerTypes.h"
@@ -42,6 +43,8 @@ DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Register Target"), STAT_AI_Sen
 DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Remove By Listener"), STAT_AI_Sense_Sight_RemoveByListener, STATGROUP_AI);
 DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Remove To Target"), STAT_AI_Sense_Sight_RemoveToTarget, STATGROUP_AI);
 DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Process pending result"), STAT_AI_Sense_Sight_ProcessPendingQuery, STATGROUP_AI);
+DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Spatial Hash Refresh"), STAT_AI_Sense_Sight_SpatialHashRefresh, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Sense: Sight, Deferred far queries"), STAT_AI_Sense_Sight_DeferredQueries, STATGROUP_AI);
 
 
 
@@ -51,6 +54,11 @@ static const int32 DefaultMinQueriesPerTimeSliceCheck = 40;
 static const float DefaultPendingQueriesBudgetReductionRatio = 0.5f;
 static const bool bDefaultUseAsynchronousTraceForDefaultSightQueries = false;
 static const float DefaultStimulusStrength = 1.f;
+static const float DefaultSpatialHashCellSize = 1000.f;
+static const float DefaultSpatialHashQueryMargin = 500.f;
+static const float DefaultSpatialHashRefreshInterval = 0.25f;
+// Async traces come back the frame after they are requested, a set still waiting after this long lost its traces
+static const uint64 MaxVisibilityTraceSetAgeFrames = 30;
 
 enum class EForEachResult : uint8
 {
@@ -157,6 +165,14 @@ UAISense_Sight_VR::UAISense_Sight_VR(const FObjectInitializer& ObjectInitializer
 	, SightLimitQueryImportance(10.f)
 	, PendingQueriesBudgetReductionRatio(DefaultPendingQueriesBudgetReductionRatio)
 	, bUseAsynchronousTraceForDefaultSightQueries(bDefaultUseAsynchronousTraceForDefaultSightQueries)
+	, bUseMultiPointVRVisibility(false)
+	, bUseSpatialHashForQueries(false)
+	, SpatialHashCellSize(DefaultSpatialHashCellSize)
+	, SpatialHashQueryMargin(DefaultSpatialHashQueryMargin)
+	, SpatialHashRefreshInterval(DefaultSpatialHashRefreshInterval)
+	, bUseDistanceBasedQueryRates(false)
+	, FarQueryDistanceRatio(0.5f)
+	, MaxFarQueryIntervalFrames(10.f)
 {
 	if (HasAnyFlags(RF_ClassDefaultObject) == false)
 	{
@@ -186,6 +202,237 @@ FORCEINLINE_DEBUGGABLE float UAISense_Sight_VR::CalcQueryImportance(const FPerce
 		: static_cast<float>(FMath::Clamp((SightLimitQueryImportance - MaxQueryImportance) / SightRadiusSq * DistanceSq + MaxQueryImportance, 0.f, MaxQueryImportance));
 }
 
+int32 UAISense_Sight_VR::GatherVRVisibilityPoints(const AVRBaseCharacter& VRChar, const FPerceptionListener& Listener, const FDigestedSightProperties& PropDigest, const float SightRadiusSq, const EVRSightVisibilityPoint PreferredPoint, FVector(&OutLocations)[(int32)EVRSightVisibilityPoint::Count], EVRSightVisibilityPoint(&OutPoints)[(int32)EVRSightVisibilityPoint::Count]) const
+{
+	int32 NumPoints = 0;
+
+	auto AddPoint = [&](const EVRSightVisibilityPoint Point)
+	{
+		FVector PointLocation;
+		switch (Point)
+		{
+		case EVRSightVisibilityPoint::Head:
+		{
+			if (!VRChar.VRReplicatedCamera)
+				return;
+
+			PointLocation = VRChar.VRReplicatedCamera->GetComponentLocation();
+		}break;
+		case EVRSightVisibilityPoint::LeftHand:
+		{
+			if (!VRChar.LeftMotionController)
+				return;
+
+			PointLocation = VRChar.LeftMotionController->GetComponentLocation();
+		}break;
+		case EVRSightVisibilityPoint::RightHand:
+		{
+			if (!VRChar.RightMotionController)
+				return;
+
+			PointLocation = VRChar.RightMotionController->GetComponentLocation();
+		}break;
+		case EVRSightVisibilityPoint::Body:
+		default:
+		{
+			PointLocation = VRChar.GetVRLocation_Inline();
+		}break;
+		}
+
+		if (FAISystem::CheckIsTargetInSightCone(Listener.CachedLocation, Listener.CachedDirection, PropDigest.PeripheralVisionAngleCos, PropDigest.PointOfViewBackwardOffset, PropDigest.NearClippingRadiusSq, SightRadiusSq, PointLocation))
+		{
+			OutLocations[NumPoints] = PointLocation;
+			OutPoints[NumPoints] = Point;
+			++NumPoints;
+		}
+	};
+
+	AddPoint(PreferredPoint);
+	for (uint8 PointIndex = 0; PointIndex < (uint8)EVRSightVisibilityPoint::Count; ++PointIndex)
+	{
+		if ((EVRSightVisibilityPoint)PointIndex != PreferredPoint)
+		{
+			AddPoint((EVRSightVisibilityPoint)PointIndex);
+		}
+	}
+
+	return NumPoints;
+}
+
+float UAISense_Sight_VR::CalcQueryEvaluationInterval(const FPerceptionListener& Listener, const FVector& TargetLocation, const float SightRadiusSq) const
+{
+	if (!bUseDistanceBasedQueryRates || SightRadiusSq <= 0.f)
+	{
+		return 0.f;
+	}
+
+	const float DistanceRatio = FMath::Sqrt(FVector::DistSquared(Listener.CachedLocation, TargetLocation) / SightRadiusSq);
+	if (DistanceRatio <= FarQueryDistanceRatio)
+	{
+		return 0.f;
+	}
+
+	const float Alpha = FMath::Clamp((DistanceRatio - FarQueryDistanceRatio) / FMath::Max(1.f - FarQueryDistanceRatio, KINDA_SMALL_NUMBER), 0.f, 1.f);
+	return Alpha * MaxFarQueryIntervalFrames;
+}
+
+FIntPoint UAISense_Sight_VR::GetSpatialHashCell(const FVector& Location) const
+{
+	const float CellSize = FMath::Max(SpatialHashCellSize, 100.f);
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+bool UAISense_Sight_VR::IsWithinQueryRange(const FPerceptionListener& Listener, const FDigestedSightProperties& PropDigest, const FVector& TargetLocation, const float Margin) const
+{
+	// Lose sight radius is used so that queries that are currently visible stay around until sight is actually lost
+	const float QueryRadius = FMath::Sqrt(FMath::Max3(PropDigest.SightRadiusSq, PropDigest.LoseSightRadiusSq, 0.f)) + Margin;
+	return FVector::DistSquared(Listener.CachedLocation, TargetLocation) <= FMath::Square(QueryRadius);
+}
+
+void UAISense_Sight_VR::ForEachTargetInQueryRange(const FPerceptionListener& Listener, const FDigestedSightProperties& PropDigest, TFunctionRef<void(const FAISightTargetVR::FTargetId&, const FAISightTargetVR&, const FVector&)> Func) const
+{
+	const float QueryRadius = FMath::Sqrt(FMath::Max3(PropDigest.SightRadiusSq, PropDigest.LoseSightRadiusSq, 0.f)) + SpatialHashQueryMargin;
+	const FIntPoint MinCell = GetSpatialHashCell(Listener.CachedLocation - FVector(QueryRadius, QueryRadius, 0.f));
+	const FIntPoint MaxCell = GetSpatialHashCell(Listener.CachedLocation + FVector(QueryRadius, QueryRadius, 0.f));
+
+	auto VisitCell = [&](const TArray<FAISightTargetVR::FTargetId>& CellTargets)
+	{
+		for (const FAISightTargetVR::FTargetId& TargetId : CellTargets)
+		{
+			if (const FAISightTargetVR* Target = ObservedTargets.Find(TargetId))
+			{
+				const FVector TargetLocation = Target->GetLocationSimple();
+				if (Target->GetTargetActor() && IsWithinQueryRange(Listener, PropDigest, TargetLocation, SpatialHashQueryMargin))
+				{
+					Func(TargetId, *Target, TargetLocation);
+				}
+			}
+		}
+	};
+
+	const int64 NumCellsInRange = (int64)(MaxCell.X - MinCell.X + 1) * (int64)(MaxCell.Y - MinCell.Y + 1);
+	if (NumCellsInRange > TargetSpatialHash.Num())
+	{
+		// Very large sight radius, cheaper to walk the occupied cells instead
+		for (const TPair<FIntPoint, TArray<FAISightTargetVR::FTargetId>>& Cell : TargetSpatialHash)
+		{
+			if (Cell.Key.X >= MinCell.X && Cell.Key.X <= MaxCell.X && Cell.Key.Y >= MinCell.Y && Cell.Key.Y <= MaxCell.Y)
+			{
+				VisitCell(Cell.Value);
+			}
+		}
+	}
+	else
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				if (const TArray<FAISightTargetVR::FTargetId>* CellTargets = TargetSpatialHash.Find(FIntPoint(X, Y)))
+				{
+					VisitCell(*CellTargets);
+				}
+			}
+		}
+	}
+}
+
+void UAISense_Sight_VR::RefreshSpatialHashQueries()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AI_Sense_Sight_SpatialHashRefresh);
+
+	// Re-bucket all of the targets at their current locations
+	TargetSpatialHash.Reset();
+	for (FTargetsContainer::TConstIterator ItTarget(ObservedTargets); ItTarget; ++ItTarget)
+	{
+		if (ItTarget->Value.GetTargetActor() != nullptr)
+		{
+			TargetSpatialHash.FindOrAdd(GetSpatialHashCell(ItTarget->Value.GetLocationSimple())).Add(ItTarget->Key);
+		}
+	}
+
+	AIPerception::FListenerMap& ListenersMap = *GetListeners();
+
+	// Remove queries that have moved well out of range, the extra margin keeps pairs on the edge from thrashing
+	// Queries that are currently seen are left alone so that losing sight of the target is still reported
+	auto PruneQuery = [this, &ListenersMap](TArray<FAISightQueryVR>& SightQueries, const int32 QueryIndex)->EReverseForEachResult
+	{
+		const FAISightQueryVR& SightQuery = SightQueries[QueryIndex];
+		if (SightQuery.GetLastResult())
+		{
+			return EReverseForEachResult::UnTouched;
+		}
+
+		const FPerceptionListener* Listener = ListenersMap.Find(SightQuery.ObserverId);
+		const FAISightTargetVR* Target = ObservedTargets.Find(SightQuery.TargetId);
+		const FDigestedSightProperties* PropDigest = DigestedProperties.Find(SightQuery.ObserverId);
+
+		// Invalid entries are left for the update to clean up
+		if (Listener && Target && PropDigest && Target->GetTargetActor() && !IsWithinQueryRange(*Listener, *PropDigest, Target->GetLocationSimple(), SpatialHashQueryMargin * 2.f))
+		{
+			SightQueries.RemoveAtSwap(QueryIndex, 1, /*bAllowShrinking=*/false);
+			return EReverseForEachResult::Modified;
+		}
+
+		return EReverseForEachResult::UnTouched;
+	};
+
+	if (ReverseForEach(SightQueriesInRange, PruneQuery) == EReverseForEachResult::Modified)
+	{
+		bSightQueriesInRangeDirty = true;
+	}
+	if (ReverseForEach(SightQueriesOutOfRange, PruneQuery) == EReverseForEachResult::Modified)
+	{
+		bSightQueriesOutOfRangeDirty = true;
+	}
+
+	// Gather the pairs that already have a query so that we only add the new ones
+	TSet<TPair<FPerceptionListenerID, FAISightTargetVR::FTargetId>> ExistingPairs;
+	ExistingPairs.Reserve(SightQueriesInRange.Num() + SightQueriesOutOfRange.Num() + SightQueriesPending.Num());
+	auto AddExistingPair = [&ExistingPairs](FAISightQueryVR& SightQuery)->EForEachResult
+	{
+		ExistingPairs.Add(TPair<FPerceptionListenerID, FAISightTargetVR::FTargetId>(SightQuery.ObserverId, SightQuery.TargetId));
+		return EForEachResult::Continue;
+	};
+	ForEach(SightQueriesInRange, AddExistingPair);
+	ForEach(SightQueriesOutOfRange, AddExistingPair);
+	ForEach(SightQueriesPending, AddExistingPair);
+
+	bool bNewQueriesAdded = false;
+	for (AIPerception::FListenerMap::TConstIterator ItListener(ListenersMap); ItListener; ++ItListener)
+	{
+		const FPerceptionListener& Listener = ItListener->Value;
+		const FDigestedSightProperties* PropDigest = Listener.HasSense(GetSenseID()) ? DigestedProperties.Find(Listener.GetListenerID()) : nullptr;
+		if (PropDigest == nullptr)
+		{
+			continue;
+		}
+
+		const IGenericTeamAgentInterface* ListenersTeamAgent = Listener.GetTeamAgent();
+		const AActor* Avatar = Listener.GetBodyActor();
+		const FPerceptionListenerID ListenerId = Listener.GetListenerID();
+
+		ForEachTargetInQueryRange(Listener, *PropDigest, [&](const FAISightTargetVR::FTargetId& TargetId, const FAISightTargetVR& Target, const FVector& TargetLocation)
+		{
+			const AActor* TargetActor = Target.GetTargetActor();
+			if (TargetActor == Avatar || ExistingPairs.Contains(TPair<FPerceptionListenerID, FAISightTargetVR::FTargetId>(ListenerId, TargetId)))
+			{
+				return;
+			}
+
+			if (RegisterNewQuery(Listener, ListenersTeamAgent, *TargetActor, TargetId, TargetLocation, *PropDigest, nullptr))
+			{
+				bNewQueriesAdded = true;
+			}
+		});
+	}
+
+	if (bNewQueriesAdded)
+	{
+		RequestImmediateUpdate();
+	}
+}
+
 void UAISense_Sight_VR::PostInitProperties()
 {
 	Super::PostInitProperties();
@@ -307,6 +554,21 @@ float UAISense_Sight_VR::Update()
 
 	UE_MT_SCOPED_WRITE_ACCESS(QueriesListAccessDetector);
 
+	if (PendingVisibilityTraceSets.Num() > 0)
+	{
+		CleanupPendingVisibilityTraceSets();
+	}
+
+	if (bUseSpatialHashForQueries)
+	{
+		const double CurrentTime = World->GetTimeSeconds();
+		if (LastSpatialHashRefreshTime < 0.0 || CurrentTime < LastSpatialHashRefreshTime || (CurrentTime - LastSpatialHashRefreshTime) >= SpatialHashRefreshInterval)
+		{
+			LastSpatialHashRefreshTime = CurrentTime;
+			RefreshSpatialHashQueries();
+		}
+	}
+
 	// sort Sight Queries
 	{
 		auto RecalcScore = [](FAISightQueryVR& SightQuery)->EForEachResult
@@ -325,9 +587,13 @@ float UAISense_Sight_VR::Update()
 			bSightQueriesOutOfRangeDirty = false;
 		}
 
-		// Sort in range queries
-		ForEach(SightQueriesInRange, RecalcScore);
-		SightQueriesInRange.Sort(FAISightQueryVR::FSortPredicate());
+		// In range queries are ordered by a key that doesn't change as they age, so we only need to rebuild the heap
+		// when something outside of the update added or removed queries
+		if (bSightQueriesInRangeDirty)
+		{
+			SightQueriesInRange.Heapify(FAISightQueryVR::FHeapPredicate());
+			bSightQueriesInRangeDirty = false;
+		}
 	}
 
 	int32 TracesCount = 0;
@@ -347,21 +613,27 @@ float UAISense_Sight_VR::Update()
 	};
 	struct FQueryOperation
 	{
-		FQueryOperation(bool bInInRange, EOperationType InOpType, int32 InIndex) : bInRange(bInInRange), OpType(InOpType), Index(InIndex) {}
-		bool bInRange;
+		FQueryOperation(EOperationType InOpType, int32 InIndex) : OpType(InOpType), Index(InIndex) {}
 		EOperationType OpType;
 		int32 Index;
 	};
+
+	// Operations are only deferred for the out of range list, in range queries are popped off of the heap as they are processed
 	TArray<FQueryOperation> QueryOperations;
 	TArray<FAISightTargetVR::FTargetId> InvalidTargets;
 	QueryOperations.Reserve(InitialInvalidItemsSize);
 	InvalidTargets.Reserve(InitialInvalidItemsSize);
 
+	// In range queries that were popped this update and stay in range, pushed back after the loop so they are only processed once
+	TArray<FAISightQueryVR> InRangeQueriesToPush;
+	TArray<FAISightQueryVR> SightQueriesOutOfRangeToInsert;
+	int32 NumDeferredQueries = 0;
+
 	AIPerception::FListenerMap& ListenersMap = *GetListeners();
 
-	int32 InRangeItr = 0;
+	const int32 TotalNumQueries = SightQueriesInRange.Num() + SightQueriesOutOfRange.Num();
 	int32 OutOfRangeItr = 0;
-	for (int32 QueryIndex = 0; QueryIndex < SightQueriesInRange.Num() + SightQueriesOutOfRange.Num(); ++QueryIndex)
+	for (int32 QueryIndex = 0; QueryIndex < TotalNumQueries; ++QueryIndex)
 	{
 		// Time slice limit check - spread out checks to every N queries so we don't spend more time checking timer than doing work
 		NumQueriesProcessed++;
@@ -375,9 +647,12 @@ float UAISense_Sight_VR::Update()
 			break;
 		}
 
-		// Calculate next in range query
-		int32 InRangeIndex = SightQueriesInRange.IsValidIndex(InRangeItr) ? InRangeItr : INDEX_NONE;
-		FAISightQueryVR* InRangeQuery = InRangeIndex != INDEX_NONE ? &SightQueriesInRange[InRangeIndex] : nullptr;
+		// Next in range query is the top of the heap
+		FAISightQueryVR* InRangeQuery = SightQueriesInRange.Num() > 0 ? &SightQueriesInRange.HeapTop() : nullptr;
+		if (InRangeQuery)
+		{
+			InRangeQuery->RecalcScore();
+		}
 
 		// Calculate next out of range query
 		int32 OutOfRangeIndex = SightQueriesOutOfRange.IsValidIndex(OutOfRangeItr) ? (NextOutOfRangeIndex + OutOfRangeItr) % SightQueriesOutOfRange.Num() : INDEX_NONE;
@@ -387,16 +662,41 @@ float UAISense_Sight_VR::Update()
 			OutOfRangeQuery->RecalcScore();
 		}
 
+		if (!InRangeQuery && !OutOfRangeQuery)
+		{
+			break;
+		}
+
 		// Compare to real find next query
 		const bool bIsInRangeQuery = (InRangeQuery && OutOfRangeQuery) ? FAISightQueryVR::FSortPredicate()(*InRangeQuery, *OutOfRangeQuery) : !OutOfRangeQuery;
-		FAISightQueryVR* SightQuery = bIsInRangeQuery ? InRangeQuery : OutOfRangeQuery;
-		ensure(SightQuery);
+
+		FAISightQueryVR PoppedInRangeQuery;
+		FAISightQueryVR* SightQuery = nullptr;
+		if (bIsInRangeQuery)
+		{
+			SightQueriesInRange.HeapPop(PoppedInRangeQuery, FAISightQueryVR::FHeapPredicate(), /*bAllowShrinking*/false);
+			SightQuery = &PoppedInRangeQuery;
+		}
+		else
+		{
+			SightQuery = OutOfRangeQuery;
+			++OutOfRangeItr;
+		}
 
 #if AISENSE_SIGHT_TIMESLICING_DEBUG
 		SlicingInfo.PushQueryInfo(bIsInRangeQuery, SightQuery->GetAge());
 #endif //AISENSE_SIGHT_TIMESLICING_DEBUG
 
-		bIsInRangeQuery ? ++InRangeItr : ++OutOfRangeItr;
+		// Far queries that are not due yet, seen targets are never deferred
+		if (SightQuery->EvaluationInterval > 0.f && !SightQuery->GetLastResult() && SightQuery->GetAge() < SightQuery->EvaluationInterval)
+		{
+			++NumDeferredQueries;
+			if (bIsInRangeQuery)
+			{
+				InRangeQueriesToPush.Add(*SightQuery);
+			}
+			continue;
+		}
 
 		FPerceptionListener& Listener = ListenersMap[SightQuery->ObserverId];
 		FAISightTargetVR& Target = ObservedTargets[SightQuery->TargetId];
@@ -423,7 +723,15 @@ float UAISense_Sight_VR::Update()
 
 			if (VisibilityResult == UAISense_Sight::EVisibilityResult::Pending)
 			{
-				QueryOperations.Add(FQueryOperation(bIsInRangeQuery, EOperationType::MoveToPending, bIsInRangeQuery ? InRangeIndex : OutOfRangeIndex));
+				// Don't restart the query here, the trace info shares memory with the frame info and is needed to find the query again
+				if (bIsInRangeQuery)
+				{
+					SightQueriesPending.Add(*SightQuery);
+				}
+				else
+				{
+					QueryOperations.Add(FQueryOperation(EOperationType::MoveToPending, OutOfRangeIndex));
+				}
 			}
 			else
 			{
@@ -440,26 +748,37 @@ float UAISense_Sight_VR::Update()
 
 				const float SightRadiusSq = bWasVisible ? PropDigest.LoseSightRadiusSq : PropDigest.SightRadiusSq;
 				SightQuery->Importance = CalcQueryImportance(Listener, TargetLocation, SightRadiusSq);
+				SightQuery->EvaluationInterval = CalcQueryEvaluationInterval(Listener, TargetLocation, SightRadiusSq);
 				const bool bShouldBeInRange = SightQuery->Importance > 0.0f;
-				if (bIsInRangeQuery != bShouldBeInRange)
-				{
-					QueryOperations.Add(FQueryOperation(bIsInRangeQuery, EOperationType::SwapList, bIsInRangeQuery ? InRangeIndex : OutOfRangeIndex));
-				}
 
 				// restart query
 				SightQuery->OnProcessed();
-			}
-
 
-
-			// restart query
-			SightQuery->OnProcessed();
+				if (bIsInRangeQuery)
+				{
+					if (bShouldBeInRange)
+					{
+						InRangeQueriesToPush.Add(*SightQuery);
+					}
+					else
+					{
+						SightQueriesOutOfRangeToInsert.Add(*SightQuery);
+					}
+				}
+				else if (bShouldBeInRange)
+				{
+					QueryOperations.Add(FQueryOperation(EOperationType::SwapList, OutOfRangeIndex));
+				}
+			}
 		}
 		else
 		{
+			// in range queries are already off of the heap, out of range ones go to the "to be removed" array
+			if (!bIsInRangeQuery)
+			{
+				QueryOperations.Add(FQueryOperation(EOperationType::Remove, OutOfRangeIndex));
+			}
 
-			// put this index to "to be removed" array
-			QueryOperations.Add(FQueryOperation(bIsInRangeQuery, EOperationType::Remove, bIsInRangeQuery ? InRangeIndex : OutOfRangeIndex));
 			if (TargetActor == nullptr)
 			{
 				InvalidTargets.AddUnique(SightQuery->TargetId);
@@ -468,6 +787,8 @@ float UAISense_Sight_VR::Update()
 	}
 	NextOutOfRangeIndex = SightQueriesOutOfRange.Num() > 0 ? (NextOutOfRangeIndex + OutOfRangeItr) % SightQueriesOutOfRange.Num() : 0;
 
+	SET_DWORD_STAT(STAT_AI_Sense_Sight_DeferredQueries, NumDeferredQueries);
+
 #if AISENSE_SIGHT_TIMESLICING_DEBUG
 	SlicingInfo.Stop();
 	UE_LOG(LogAIPerception, VeryVerbose, TEXT("UAISense_Sight::Update processed %d sources %s [time slice limited? %d]"), NumQueriesProcessed, *SlicingInfo.ToString(), bHitTimeSliceLimit ? 1 : 0);
@@ -475,38 +796,34 @@ float UAISense_Sight_VR::Update()
 	UE_LOG(LogAIPerception, VeryVerbose, TEXT("UAISense_Sight::Update processed %d sources [time slice limited? %d]"), NumQueriesProcessed, bHitTimeSliceLimit ? 1 : 0);
 #endif // AISENSE_SIGHT_TIMESLICING_DEBUG
 
-	if (QueryOperations.Num() > 0)
+	if (QueryOperations.Num() > 0 || InRangeQueriesToPush.Num() > 0 || SightQueriesOutOfRangeToInsert.Num() > 0 || InvalidTargets.Num() > 0)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_AI_Sense_Sight_QueryOperations);
 
-		// Sort by InRange and by descending Index 
+		// Processed queries go back into the heap with their new priority
+		for (FAISightQueryVR& ProcessedQuery : InRangeQueriesToPush)
+		{
+			SightQueriesInRange.HeapPush(ProcessedQuery, FAISightQueryVR::FHeapPredicate());
+		}
+
+		// Sort by descending Index
 		QueryOperations.Sort([](const FQueryOperation& LHS, const FQueryOperation& RHS)->bool
 			{
-				if (LHS.bInRange != RHS.bInRange)
-					return LHS.bInRange;
 				return LHS.Index > RHS.Index;
 			});
-		// Do all the removes first and save the out of range swaps because we will insert them at the right location to prevent sorting
-		TArray<FAISightQueryVR> SightQueriesOutOfRangeToInsert;
+		// Do all the removes from the out of range list, in range queries that left range are inserted after to preserve the ordering
 		for (FQueryOperation& Operation : QueryOperations)
 		{
 			switch (Operation.OpType)
 			{
 			case EOperationType::SwapList:
 			{
-				if (Operation.bInRange)
-				{
-					SightQueriesOutOfRangeToInsert.Push(SightQueriesInRange[Operation.Index]);
-				}
-				else
-				{
-					SightQueriesInRange.Add(SightQueriesOutOfRange[Operation.Index]);
-				}
+				SightQueriesInRange.HeapPush(SightQueriesOutOfRange[Operation.Index], FAISightQueryVR::FHeapPredicate());
 			}break;
 
 			case EOperationType::MoveToPending:
 			{
-				SightQueriesPending.Add(Operation.bInRange ? SightQueriesInRange[Operation.Index] : SightQueriesOutOfRange[Operation.Index]);
+				SightQueriesPending.Add(SightQueriesOutOfRange[Operation.Index]);
 			}break;
 
 			case EOperationType::Remove:
@@ -517,19 +834,11 @@ float UAISense_Sight_VR::Update()
 				break;
 			}
 
-			if (Operation.bInRange)
+			// Preserve the list ordered
+			SightQueriesOutOfRange.RemoveAt(Operation.Index, 1, /*bAllowShrinking*/false);
+			if (Operation.Index < NextOutOfRangeIndex)
 			{
-				// In range queries are always sorted at the beginning of the update
-				SightQueriesInRange.RemoveAtSwap(Operation.Index, 1, /*bAllowShrinking*/false);
-			}
-			else
-			{
-				// Preserve the list ordered
-				SightQueriesOutOfRange.RemoveAt(Operation.Index, 1, /*bAllowShrinking*/false);
-				if (Operation.Index < NextOutOfRangeIndex)
-				{
-					NextOutOfRangeIndex--;
-				}
+				NextOutOfRangeIndex--;
 			}
 		}
 		// Reinsert the saved out of range swaps
@@ -577,7 +886,22 @@ UAISense_Sight::EVisibilityResult UAISense_Sight_VR::ComputeVisibility(UWorld* W
 	const FVector TargetLocation = VRChar != nullptr ? VRChar->GetVRLocation_Inline() : TargetActor->GetActorLocation();
 
 	const float SightRadiusSq = SightQuery.GetLastResult() ? PropDigest.LoseSightRadiusSq : PropDigest.SightRadiusSq;
-	if (!FAISystem::CheckIsTargetInSightCone(Listener.CachedLocation, Listener.CachedDirection, PropDigest.PeripheralVisionAngleCos, PropDigest.PointOfViewBackwardOffset, PropDigest.NearClippingRadiusSq, SightRadiusSq, TargetLocation))
+
+	// VR characters can peek around corners with their head or hands while their body stays hidden
+	FVector PointLocations[(int32)EVRSightVisibilityPoint::Count];
+	EVRSightVisibilityPoint Points[(int32)EVRSightVisibilityPoint::Count];
+	int32 NumPoints = 0;
+	const bool bUseMultiPoint = bUseMultiPointVRVisibility && VRChar != nullptr && Target.SightTargetInterface == nullptr;
+
+	if (bUseMultiPoint)
+	{
+		NumPoints = GatherVRVisibilityPoints(*VRChar, Listener, PropDigest, SightRadiusSq, SightQuery.LastVisiblePoint, PointLocations, Points);
+		if (NumPoints == 0)
+		{
+			return UAISense_Sight::EVisibilityResult::NotVisible;
+		}
+	}
+	else if (!FAISystem::CheckIsTargetInSightCone(Listener.CachedLocation, Listener.CachedDirection, PropDigest.PeripheralVisionAngleCos, PropDigest.PointOfViewBackwardOffset, PropDigest.NearClippingRadiusSq, SightRadiusSq, TargetLocation))
 	{
 		return UAISense_Sight::EVisibilityResult::NotVisible;
 	}
@@ -629,7 +953,56 @@ UAISense_Sight::EVisibilityResult UAISense_Sight_VR::ComputeVisibility(UWorld* W
 
 		const FCollisionQueryParams QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(AILineOfSight), true, ListenerActor);
 
-		if (bUseAsynchronousTraceForDefaultSightQueries)
+		if (bUseMultiPoint)
+		{
+			if (bUseAsynchronousTraceForDefaultSightQueries)
+			{
+				// Request all of the points at once, the results are gathered in OnPendingTraceQueryProcessed
+				FVRVisibilityTraceSet TraceSet;
+				for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+				{
+					const FTraceHandle TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Listener.CachedLocation, PointLocations[PointIndex], DefaultSightCollisionChannel, QueryParams, FCollisionResponseParams::DefaultResponseParam, &OnPendingTraceQueryProcessedDelegate);
+					if (TraceHandle.IsValid())
+					{
+						TraceSet.Handles.Add(TraceHandle);
+						TraceSet.Points.Add(Points[PointIndex]);
+					}
+				}
+
+				if (TraceSet.Handles.Num() == 0)
+				{
+					return UAISense_Sight::EVisibilityResult::NotVisible;
+				}
+
+				OutNumberOfAsyncLosCheckRequested += TraceSet.Handles.Num();
+
+				// the first handle identifies the query when the set is resolved
+				SightQuery.SetTraceInfo(TraceSet.Handles[0]);
+				TraceSet.RequestFrame = GFrameCounter;
+				PendingVisibilityTraceSets.Add(MoveTemp(TraceSet));
+				return UAISense_Sight::EVisibilityResult::Pending;
+			}
+			else
+			{
+				FHitResult HitResult;
+				for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+				{
+					const bool bHit = World->LineTraceSingleByChannel(HitResult, Listener.CachedLocation, PointLocations[PointIndex], DefaultSightCollisionChannel, QueryParams, FCollisionResponseParams::DefaultResponseParam);
+
+					++OutNumberOfLoSChecksPerformed;
+
+					if (UE::AISense_SightVR::IsTraceConsideredVisible(bHit ? &HitResult : nullptr, TargetActor))
+					{
+						SightQuery.LastVisiblePoint = Points[PointIndex];
+						OutSeenLocation = PointLocations[PointIndex];
+						return UAISense_Sight::EVisibilityResult::Visible;
+					}
+				}
+
+				return UAISense_Sight::EVisibilityResult::NotVisible;
+			}
+		}
+		else if (bUseAsynchronousTraceForDefaultSightQueries)
 		{
 			const FTraceHandle TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Listener.CachedLocation, TargetLocation, DefaultSightCollisionChannel, QueryParams, FCollisionResponseParams::DefaultResponseParam, &OnPendingTraceQueryProcessedDelegate);
 			if (!TraceHandle.IsValid())
@@ -726,28 +1099,116 @@ void UAISense_Sight_VR::OnPendingTraceQueryProcessed(const FTraceHandle& TraceHa
 	SCOPE_CYCLE_COUNTER(STAT_AI_Sense_Sight_ProcessPendingQuery);
 	UE_MT_SCOPED_WRITE_ACCESS(QueriesListAccessDetector);
 
-	const int32 QueryIdx = SightQueriesPending.IndexOfByPredicate([&TraceHandle](const FAISightQueryVR& Element)
+	auto IsSameTrace = [](const FTraceHandle& Handle, const FTraceHandle& OtherHandle)
+	{
+		return Handle._Data.FrameNumber == OtherHandle._Data.FrameNumber && Handle._Data.Index == OtherHandle._Data.Index;
+	};
+
+	auto FindPendingQuery = [this](const FTraceHandle& Handle)
+	{
+		return SightQueriesPending.IndexOfByPredicate([&Handle](const FAISightQueryVR& Element)
+			{
+				return Element.TraceInfo.FrameNumber == Handle._Data.FrameNumber
+					&& Element.TraceInfo.Index == Handle._Data.Index;
+			});
+	};
+
+	auto FindTargetActor = [this](const FAISightQueryVR& SightQuery)->AActor*
+	{
+		const FAISightTargetVR* Target = ObservedTargets.Find(SightQuery.TargetId);
+		return Target ? Target->Target.Get() : nullptr;
+	};
+
+	// Multi point queries resolve on the first visible point or once all of their traces are back
+	int32 PointIdx = INDEX_NONE;
+	const int32 TraceSetIdx = PendingVisibilityTraceSets.IndexOfByPredicate([&](const FVRVisibilityTraceSet& TraceSet)
 		{
-			return Element.TraceInfo.FrameNumber == TraceHandle._Data.FrameNumber
-				&& Element.TraceInfo.Index == TraceHandle._Data.Index;
+			PointIdx = TraceSet.Handles.IndexOfByPredicate([&](const FTraceHandle& Handle) { return IsSameTrace(Handle, TraceHandle); });
+			return PointIdx != INDEX_NONE;
 		});
 
-	if (QueryIdx == INDEX_NONE)
+	if (TraceSetIdx != INDEX_NONE)
 	{
-		// the query is not pending. It must have been removed because the source or the target have been removed
+		FVRVisibilityTraceSet& TraceSet = PendingVisibilityTraceSets[TraceSetIdx];
+		++TraceSet.NumReturned;
+		const bool bAllReturned = TraceSet.NumReturned >= TraceSet.Handles.Num();
+
+		// The pending query stores the first handle of its set
+		const int32 QueryIdx = FindPendingQuery(TraceSet.Handles[0]);
+		if (QueryIdx == INDEX_NONE)
+		{
+			// the query is not pending. It must have been removed because the source or the target have been removed
+			if (bAllReturned)
+			{
+				PendingVisibilityTraceSets.RemoveAtSwap(TraceSetIdx, 1, false);
+			}
+			return;
+		}
+
+		AActor* TargetActor = FindTargetActor(SightQueriesPending[QueryIdx]);
+		const bool bIsVisible = UE::AISense_SightVR::IsTraceConsideredVisible(TraceDatum.OutHits.Num() > 0 ? &TraceDatum.OutHits[0] : nullptr, TargetActor);
+
+		if (!bIsVisible && !bAllReturned)
+		{
+			return;
+		}
+
+		if (bIsVisible)
+		{
+			SightQueriesPending[QueryIdx].LastVisiblePoint = TraceSet.Points[PointIdx];
+		}
+
+		// Any traces of this set that are still in flight won't match anything anymore
+		PendingVisibilityTraceSets.RemoveAtSwap(TraceSetIdx, 1, false);
+		OnPendingQueryProcessed(QueryIdx, bIsVisible, DefaultStimulusStrength, TraceDatum.End, NullOpt, TargetActor);
 		return;
 	}
 
-	AActor* TargetActor = nullptr;
-	if (const FAISightTargetVR* Target = ObservedTargets.Find(SightQueriesPending[QueryIdx].TargetId))
+	const int32 QueryIdx = FindPendingQuery(TraceHandle);
+
+	if (QueryIdx == INDEX_NONE)
 	{
-		TargetActor = Target->Target.Get();
+		// the query is not pending. It must have been removed because the source or the target have been removed
+		return;
 	}
+
+	AActor* TargetActor = FindTargetActor(SightQueriesPending[QueryIdx]);
 	const bool bIsVisible = UE::AISense_SightVR::IsTraceConsideredVisible(TraceDatum.OutHits.Num() > 0 ? &TraceDatum.OutHits[0] : nullptr, TargetActor);
 
 	OnPendingQueryProcessed(QueryIdx, bIsVisible, DefaultStimulusStrength, TraceDatum.End, NullOpt, TargetActor);
 }
 
+void UAISense_Sight_VR::CleanupPendingVisibilityTraceSets()
+{
+	for (int32 TraceSetIdx = PendingVisibilityTraceSets.Num() - 1; TraceSetIdx >= 0; --TraceSetIdx)
+	{
+		const FVRVisibilityTraceSet& TraceSet = PendingVisibilityTraceSets[TraceSetIdx];
+		const FTraceHandle& FirstHandle = TraceSet.Handles[0];
+		const int32 QueryIdx = SightQueriesPending.IndexOfByPredicate([&FirstHandle](const FAISightQueryVR& Element)
+			{
+				return Element.TraceInfo.FrameNumber == FirstHandle._Data.FrameNumber
+					&& Element.TraceInfo.Index == FirstHandle._Data.Index;
+			});
+
+		const bool bTimedOut = (GFrameCounter - TraceSet.RequestFrame) > MaxVisibilityTraceSetAgeFrames;
+		if (QueryIdx != INDEX_NONE && !bTimedOut)
+		{
+			continue;
+		}
+
+		// Traces of this set that are still in flight won't match anything anymore
+		PendingVisibilityTraceSets.RemoveAtSwap(TraceSetIdx, 1, false);
+
+		if (QueryIdx != INDEX_NONE)
+		{
+			// Don't leave the query pending forever, it gets requested again on its next evaluation
+			// Keep the previous result (and last seen location) so that a timeout doesn't read as losing sight
+			const bool bWasVisible = SightQueriesPending[QueryIdx].GetLastResult();
+			OnPendingQueryProcessed(QueryIdx, bWasVisible, DefaultStimulusStrength, FAISystem::InvalidLocation, NullOpt, NullOpt);
+		}
+	}
+}
+
 void UAISense_Sight_VR::OnPendingQueryProcessed(const int32 SightQueryIndex, const bool bIsVisible, const float StimulusStrength, const FVector& SeenLocation, const TOptional<int32>& UserData, const TOptional<AActor*> InTargetActor)
 {
 	FAISightQueryVR SightQuery = SightQueriesPending[SightQueryIndex];
@@ -795,10 +1256,18 @@ void UAISense_Sight_VR::OnPendingQueryProcessed(const int32 SightQueryIndex, con
 	const FDigestedSightProperties& PropDigest = DigestedProperties[SightQuery.ObserverId];
 	const float SightRadiusSq = bWasVisible ? PropDigest.LoseSightRadiusSq : PropDigest.SightRadiusSq;
 	SightQuery.Importance = CalcQueryImportance(*Listener, TargetLocation, SightRadiusSq);
+	SightQuery.EvaluationInterval = CalcQueryEvaluationInterval(*Listener, TargetLocation, SightRadiusSq);
 	const bool bShouldBeInRange = SightQuery.Importance > 0.0f;
 	if (bShouldBeInRange)
 	{
-		SightQueriesInRange.Add(SightQuery);
+		if (bSightQueriesInRangeDirty)
+		{
+			SightQueriesInRange.Add(SightQuery);
+		}
+		else
+		{
+			SightQueriesInRange.HeapPush(SightQuery, FAISightQueryVR::FHeapPredicate());
+		}
 	}
 	else
 	{
@@ -862,7 +1331,10 @@ void UAISense_Sight_VR::UnregisterSource(AActor& SourceActor)
 				return EReverseForEachResult::UnTouched;
 			};
 
-			ReverseForEach(SightQueriesInRange, RemoveQuery);
+			if (ReverseForEach(SightQueriesInRange, RemoveQuery) == EReverseForEachResult::Modified)
+			{
+				bSightQueriesInRangeDirty = true;
+			}
 			if (ReverseForEach(SightQueriesOutOfRange, RemoveQuery) == EReverseForEachResult::Modified)
 			{
 				bSightQueriesOutOfRangeDirty = true;
@@ -906,6 +1378,11 @@ bool UAISense_Sight_VR::RegisterTarget(AActor& TargetActor, const TFunction<void
 	const AVRBaseCharacter * VRChar = Cast<const AVRBaseCharacter>(&TargetActor);
 	const FVector TargetLocation = VRChar != nullptr ? VRChar->GetVRLocation_Inline() : TargetActor.GetActorLocation();
 
+	if (bUseSpatialHashForQueries && LastSpatialHashRefreshTime >= 0.0)
+	{
+		TargetSpatialHash.FindOrAdd(GetSpatialHashCell(TargetLocation)).AddUnique(SightTarget->TargetId);
+	}
+
 	for (AIPerception::FListenerMap::TConstIterator ItListener(ListenersMap); ItListener; ++ItListener)
 	{
 		const FPerceptionListener& Listener = ItListener->Value;
@@ -916,6 +1393,13 @@ bool UAISense_Sight_VR::RegisterTarget(AActor& TargetActor, const TFunction<void
 		}
 
 		const FDigestedSightProperties& PropDigest = DigestedProperties[Listener.GetListenerID()];
+
+		// Pairs out of range get picked up by the spatial hash refresh once they come closer
+		if (bUseSpatialHashForQueries && !IsWithinQueryRange(Listener, PropDigest, TargetLocation, SpatialHashQueryMargin))
+		{
+			continue;
+		}
+
 		const IGenericTeamAgentInterface* ListenersTeamAgent = Listener.GetTeamAgent();
 		if (RegisterNewQuery(Listener, ListenersTeamAgent, TargetActor, SightTarget->TargetId, TargetLocation, PropDigest, OnAddedFunc))
 		{
@@ -951,21 +1435,36 @@ void UAISense_Sight_VR::GenerateQueriesForListener(const FPerceptionListener& Li
 	const IGenericTeamAgentInterface* ListenersTeamAgent = Listener.GetTeamAgent();
 	const AActor* Avatar = Listener.GetBodyActor();
 
-	// create sight queries with all legal targets
-	for (FTargetsContainer::TConstIterator ItTarget(ObservedTargets); ItTarget; ++ItTarget)
+	if (bUseSpatialHashForQueries && LastSpatialHashRefreshTime >= 0.0)
 	{
-		const AActor* TargetActor = ItTarget->Value.GetTargetActor();
-		if (TargetActor == nullptr || TargetActor == Avatar)
+		// only the targets that are close enough, the rest are added by the spatial hash refresh as they come into range
+		ForEachTargetInQueryRange(Listener, PropertyDigest, [&](const FAISightTargetVR::FTargetId& TargetId, const FAISightTargetVR& Target, const FVector& TargetLocation)
 		{
-			continue;
-		}
-
-		// Changed this up to support my VR Characters
-		const AVRBaseCharacter* VRChar = Cast<const AVRBaseCharacter>(TargetActor);
-		const FVector TargetLocation = VRChar != nullptr ? VRChar->GetVRLocation_Inline() : TargetActor->GetActorLocation();
-		if (RegisterNewQuery(Listener, ListenersTeamAgent, *TargetActor, ItTarget->Key, TargetLocation, PropertyDigest, OnAddedFunc))
+			const AActor* TargetActor = Target.GetTargetActor();
+			if (TargetActor != Avatar && RegisterNewQuery(Listener, ListenersTeamAgent, *TargetActor, TargetId, TargetLocation, PropertyDigest, OnAddedFunc))
+			{
+				bNewQueriesAdded = true;
+			}
+		});
+	}
+	else
+	{
+		// create sight queries with all legal targets
+		for (FTargetsContainer::TConstIterator ItTarget(ObservedTargets); ItTarget; ++ItTarget)
 		{
-			bNewQueriesAdded = true;
+			const AActor* TargetActor = ItTarget->Value.GetTargetActor();
+			if (TargetActor == nullptr || TargetActor == Avatar)
+			{
+				continue;
+			}
+
+			// Changed this up to support my VR Characters
+			const AVRBaseCharacter* VRChar = Cast<const AVRBaseCharacter>(TargetActor);
+			const FVector TargetLocation = VRChar != nullptr ? VRChar->GetVRLocation_Inline() : TargetActor->GetActorLocation();
+			if (RegisterNewQuery(Listener, ListenersTeamAgent, *TargetActor, ItTarget->Key, TargetLocation, PropertyDigest, OnAddedFunc))
+			{
+				bNewQueriesAdded = true;
+			}
 		}
 	}
 
@@ -990,11 +1489,16 @@ bool UAISense_Sight_VR::RegisterNewQuery(const FPerceptionListener& Listener, co
 	{
 		bSightQueriesOutOfRangeDirty = true;
 	}
+	else
+	{
+		bSightQueriesInRangeDirty = true;
+	}
 
 	FAISightQueryVR& AddedQuery = bInRange ? SightQueriesInRange.AddDefaulted_GetRef() : SightQueriesOutOfRange.AddDefaulted_GetRef();
 	AddedQuery.ObserverId = Listener.GetListenerID();
 	AddedQuery.TargetId = TargetId;
 	AddedQuery.Importance = Importance;
+	AddedQuery.EvaluationInterval = CalcQueryEvaluationInterval(Listener, TargetLocation, PropDigest.SightRadiusSq);
 
 	if (OnAddedFunc)
 	{
@@ -1101,6 +1605,9 @@ void UAISense_Sight_VR::OnListenerRemovedImpl(const FPerceptionListener& Removed
 
 	RemoveAllQueriesByListener(RemovedListener);
 
+	// Listeners unregister on end play, drop the trace sets of the queries that were just removed
+	CleanupPendingVisibilityTraceSets();
+
 	DigestedProperties.FindAndRemoveChecked(RemovedListener.GetListenerID());
 
 	// note: there use to be code to remove all queries _to_ listener here as well
@@ -1135,7 +1642,10 @@ void UAISense_Sight_VR::RemoveAllQueriesByListener(const FPerceptionListener& Li
 
 		return EReverseForEachResult::UnTouched;
 	};
-	ReverseForEach(SightQueriesInRange, RemoveQuery);
+	if (ReverseForEach(SightQueriesInRange, RemoveQuery) == EReverseForEachResult::Modified)
+	{
+		bSightQueriesInRangeDirty = true;
+	}
 	if (ReverseForEach(SightQueriesOutOfRange, RemoveQuery) == EReverseForEachResult::Modified)
 	{
 
@@ -1166,7 +1676,10 @@ void UAISense_Sight_VR::RemoveAllQueriesToTarget(const FAISightTargetVR::FTarget
 
 		return EReverseForEachResult::UnTouched;
 	};
-	ReverseForEach(SightQueriesInRange, RemoveQuery);
+	if (ReverseForEach(SightQueriesInRange, RemoveQuery) == EReverseForEachResult::Modified)
+	{
+		bSightQueriesInRangeDirty = true;
+	}
 	if (ReverseForEach(SightQueriesOutOfRange, RemoveQuery) == EReverseForEachResult::Modified)
 	{
 
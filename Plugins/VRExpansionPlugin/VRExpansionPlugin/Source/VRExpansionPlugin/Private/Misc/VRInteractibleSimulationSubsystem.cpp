@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/VRInteractibleSimulationSubsystem.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VRInteractibleSimulationSubsystem)
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("VR Interactible Simulation"), STAT_VRInteractibleSimulation, STATGROUP_Game);
+
+namespace VRInteractibleSimulationCVars
+{
+	static int32 CentralSimulation = 0;
+	FAutoConsoleVariableRef CVarCentralSimulation(
+		TEXT("vre.Interactibles.CentralSimulation"),
+		CentralSimulation,
+		TEXT("When on, awake VR interactibles are ticked by the interactible simulation subsystem instead of their own tick functions.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+}
+
+void UVRInteractibleSimulationSubsystem::Deinitialize()
+{
+	for (const TWeakObjectPtr<UActorComponent>& WeakInteractible : AwakeInteractibles)
+	{
+		if (UActorComponent* Interactible = WeakInteractible.Get())
+		{
+			Interactible->OnComponentDeactivated.RemoveDynamic(this, &UVRInteractibleSimulationSubsystem::OnInteractibleDeactivated);
+		}
+	}
+
+	AwakeInteractibles.Empty();
+	AwakeIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+void UVRInteractibleSimulationSubsystem::SetInteractibleAwake(UActorComponent* Interactible, bool bAwake)
+{
+	if (!Interactible)
+		return;
+
+	UWorld* World = Interactible->GetWorld();
+	UVRInteractibleSimulationSubsystem* Subsystem = World ? World->GetSubsystem<UVRInteractibleSimulationSubsystem>() : nullptr;
+
+	if (bAwake && Subsystem && VRInteractibleSimulationCVars::CentralSimulation > 0)
+	{
+		Interactible->SetComponentTickEnabled(false);
+		Subsystem->WakeInteractible(Interactible);
+		return;
+	}
+
+	// Always clear both so that toggling the cvar at runtime can't leave something ticking twice
+	if (Subsystem)
+		Subsystem->SleepInteractible(Interactible);
+
+	Interactible->SetComponentTickEnabled(bAwake);
+}
+
+void UVRInteractibleSimulationSubsystem::WakeInteractible(UActorComponent* Interactible)
+{
+	if (!Interactible || AwakeIndices.Contains(Interactible))
+		return;
+
+	AwakeIndices.Add(Interactible, AwakeInteractibles.Add(Interactible));
+
+	// Deactivate only turns off the components own tick, so it has to be taken out of the list as well
+	Interactible->OnComponentDeactivated.AddUniqueDynamic(this, &UVRInteractibleSimulationSubsystem::OnInteractibleDeactivated);
+}
+
+void UVRInteractibleSimulationSubsystem::SleepInteractible(UActorComponent* Interactible)
+{
+	if (const int32* Index = AwakeIndices.Find(Interactible))
+	{
+		RemoveAwakeAt(*Index);
+	}
+}
+
+void UVRInteractibleSimulationSubsystem::OnInteractibleDeactivated(UActorComponent* Component)
+{
+	SleepInteractible(Component);
+}
+
+void UVRInteractibleSimulationSubsystem::RemoveAwakeAt(int32 Index)
+{
+	if (UActorComponent* Interactible = AwakeInteractibles[Index].Get())
+	{
+		Interactible->OnComponentDeactivated.RemoveDynamic(this, &UVRInteractibleSimulationSubsystem::OnInteractibleDeactivated);
+	}
+
+	AwakeIndices.Remove(AwakeInteractibles[Index]);
+	AwakeInteractibles.RemoveAtSwap(Index, 1, false);
+
+	if (AwakeInteractibles.IsValidIndex(Index))
+	{
+		AwakeIndices.Add(AwakeInteractibles[Index], Index);
+	}
+}
+
+int32 UVRInteractibleSimulationSubsystem::GetNumAwakeInteractibles() const
+{
+	return AwakeInteractibles.Num();
+}
+
+void UVRInteractibleSimulationSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_VRInteractibleSimulation);
+
+	// Interactibles can go to sleep (or wake others) from inside of their tick, so the list is walked in place
+	for (int32 Index = 0; Index < AwakeInteractibles.Num();)
+	{
+		UActorComponent* Interactible = AwakeInteractibles[Index].Get();
+
+		if (!IsValid(Interactible) || !Interactible->IsRegistered())
+		{
+			RemoveAwakeAt(Index);
+			continue;
+		}
+
+		// Same as the components own tick function, which isn't registered until begin play
+		if (!Interactible->HasBegunPlay())
+		{
+			++Index;
+			continue;
+		}
+
+		const AActor* Owner = Interactible->GetOwner();
+		const float InteractibleDeltaTime = Owner ? DeltaTime * Owner->CustomTimeDilation : DeltaTime;
+
+		Interactible->TickComponent(InteractibleDeltaTime, LEVELTICK_All, &Interactible->PrimaryComponentTick);
+
+		// If it went to sleep then something else was swapped into its slot
+		if (AwakeInteractibles.IsValidIndex(Index) && AwakeInteractibles[Index].Get() == Interactible)
+			++Index;
+	}
+}
+
+bool UVRInteractibleSimulationSubsystem::IsTickable() const
+{
+	return AwakeInteractibles.Num() > 0;
+}
+
+bool UVRInteractibleSimulationSubsystem::IsTickableWhenPaused() const
+{
+	return false;
+}
+
+TStatId UVRInteractibleSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRInteractibleSimulationSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,237 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/VRPushModelHelpers.h"
+
+#if VREXPANSION_PUSH_MODEL_VALIDATION
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UnrealType.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogVRPushModel, Log, All);
+
+namespace VRPushModel
+{
+	// Blueprint writable properties are included, Blueprint sets go through the engines own dirty marking
+	static int32 ValidatePushModel = 0;
+	FAutoConsoleVariableRef CVarValidatePushModel(
+		TEXT("vre.PushModel.Validate"),
+		ValidatePushModel,
+		TEXT("Reports VRExpansion push model properties that changed on the server without being marked dirty.\n")
+		TEXT("0: Off, 1: On"),
+		ECVF_Default);
+
+	struct FPropertySnapshot
+	{
+		const FProperty* Property;
+		uint8* Data;
+		bool bMarkedDirty;
+
+		FPropertySnapshot(const FProperty* InProperty, const void* Value) :
+			Property(InProperty),
+			bMarkedDirty(false)
+		{
+			Data = (uint8*)FMemory::Malloc(Property->GetSize(), Property->GetMinAlignment());
+			Property->InitializeValue(Data);
+			Property->CopyCompleteValue(Data, Value);
+		}
+
+		~FPropertySnapshot()
+		{
+			Property->DestroyValue(Data);
+			FMemory::Free(Data);
+		}
+
+		FPropertySnapshot(const FPropertySnapshot&) = delete;
+		FPropertySnapshot& operator=(const FPropertySnapshot&) = delete;
+	};
+
+	struct FValidationState
+	{
+		TMap<const UClass*, TArray<FName>> RegisteredProperties;
+		TMap<TObjectKey<UObject>, TMap<FName, TUniquePtr<FPropertySnapshot>>> Snapshots;
+		FDelegateHandle PostActorTickHandle;
+	};
+
+	static FValidationState& GetValidationState()
+	{
+		static FValidationState State;
+		return State;
+	}
+
+	// Compares only what goes over the wire, NotReplicated struct members are allowed to change freely
+	static bool IsNetIdentical(const FProperty* Property, const void* A, const void* B)
+	{
+		if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
+		{
+			if (StructProp->Struct->StructFlags & STRUCT_IdenticalNative)
+			{
+				return Property->Identical(A, B);
+			}
+
+			for (int32 Idx = 0; Idx < Property->ArrayDim; ++Idx)
+			{
+				const uint8* ElementA = (const uint8*)A + (Idx * Property->ElementSize);
+				const uint8* ElementB = (const uint8*)B + (Idx * Property->ElementSize);
+
+				for (TFieldIterator<FProperty> It(StructProp->Struct); It; ++It)
+				{
+					if (It->HasAnyPropertyFlags(CPF_RepSkip))
+						continue;
+
+					if (!IsNetIdentical(*It, It->ContainerPtrToValuePtr<void>(ElementA), It->ContainerPtrToValuePtr<void>(ElementB)))
+						return false;
+				}
+			}
+
+			return true;
+		}
+		else if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper HelperA(ArrayProp, A);
+			FScriptArrayHelper HelperB(ArrayProp, B);
+
+			if (HelperA.Num() != HelperB.Num())
+				return false;
+
+			for (int32 Idx = 0; Idx < HelperA.Num(); ++Idx)
+			{
+				if (!IsNetIdentical(ArrayProp->Inner, HelperA.GetRawPtr(Idx), HelperB.GetRawPtr(Idx)))
+					return false;
+			}
+
+			return true;
+		}
+
+		return Property->Identical(A, B);
+	}
+
+	static bool ShouldValidateObject(const UObject* Object)
+	{
+		if (!IsValid(Object) || Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+			return false;
+
+		const UWorld* World = Object->GetWorld();
+		if (!World || World->GetNetMode() == NM_Client || World->GetNetMode() == NM_Standalone)
+			return false;
+
+		if (const AActor* Actor = Cast<AActor>(Object))
+		{
+			return Actor->GetIsReplicated();
+		}
+		else if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+		{
+			return Component->GetIsReplicated();
+		}
+
+		return true;
+	}
+
+	static void ValidateObject(const UObject* Object, FValidationState& State)
+	{
+		TMap<FName, TUniquePtr<FPropertySnapshot>>& ObjectSnapshots = State.Snapshots.FindOrAdd(Object);
+
+		for (const UClass* Class = Object->GetClass(); Class; Class = Class->GetSuperClass())
+		{
+			const TArray<FName>* PropertyNames = State.RegisteredProperties.Find(Class);
+			if (!PropertyNames)
+				continue;
+
+			for (const FName& PropertyName : *PropertyNames)
+			{
+				const FProperty* Property = FindFProperty<FProperty>(Class, PropertyName);
+				if (!Property)
+					continue;
+
+				const void* CurrentValue = Property->ContainerPtrToValuePtr<void>(Object);
+				TUniquePtr<FPropertySnapshot>& Snapshot = ObjectSnapshots.FindOrAdd(PropertyName);
+
+				if (!Snapshot.IsValid())
+				{
+					Snapshot = MakeUnique<FPropertySnapshot>(Property, CurrentValue);
+					continue;
+				}
+
+				if (!Snapshot->bMarkedDirty && !IsNetIdentical(Property, Snapshot->Data, CurrentValue))
+				{
+					UE_LOG(LogVRPushModel, Error, TEXT("Push model property %s::%s on %s changed without being marked dirty!"), *Class->GetName(), *PropertyName.ToString(), *Object->GetPathName());
+					ensureMsgf(false, TEXT("Push model property %s::%s changed without being marked dirty"), *Class->GetName(), *PropertyName.ToString());
+				}
+
+				Property->CopyCompleteValue(Snapshot->Data, CurrentValue);
+				Snapshot->bMarkedDirty = false;
+			}
+		}
+	}
+
+	static void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+	{
+		FValidationState& State = GetValidationState();
+
+		if (ValidatePushModel <= 0)
+		{
+			State.Snapshots.Empty();
+			return;
+		}
+
+		if (!World || World->GetNetMode() == NM_Client || World->GetNetMode() == NM_Standalone)
+			return;
+
+		// Drop snapshots of objects that no longer exist
+		for (auto It = State.Snapshots.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		TSet<const UObject*> ObjectsToValidate;
+		for (const TPair<const UClass*, TArray<FName>>& ClassPair : State.RegisteredProperties)
+		{
+			ForEachObjectOfClass(ClassPair.Key, [&](UObject* Object)
+			{
+				if (Object->GetWorld() == World && ShouldValidateObject(Object))
+				{
+					ObjectsToValidate.Add(Object);
+				}
+			}, true, RF_ClassDefaultObject | RF_ArchetypeObject);
+		}
+
+		for (const UObject* Object : ObjectsToValidate)
+		{
+			ValidateObject(Object, State);
+		}
+	}
+
+	void RegisterProperty(const UClass* OwningClass, FName PropertyName)
+	{
+		check(IsInGameThread());
+
+		FValidationState& State = GetValidationState();
+		State.RegisteredProperties.FindOrAdd(OwningClass).AddUnique(PropertyName);
+
+		if (!State.PostActorTickHandle.IsValid())
+		{
+			State.PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(&OnWorldPostActorTick);
+		}
+	}
+
+	void NotifyPropertyMarkedDirty(const UObject* Object, FName PropertyName)
+	{
+		if (ValidatePushModel <= 0 || !IsInGameThread())
+			return;
+
+		if (TMap<FName, TUniquePtr<FPropertySnapshot>>* ObjectSnapshots = GetValidationState().Snapshots.Find(Object))
+		{
+			if (TUniquePtr<FPropertySnapshot>* Snapshot = ObjectSnapshots->Find(PropertyName))
+			{
+				(*Snapshot)->bMarkedDirty = true;
+			}
+		}
+	}
+}
+
+#endif
@@ -19,6 +19,17 @@
 #include "Serialization/ArchiveLoadCompressedProxy.h"
 #include "Materials/Material.h"
 #include "Net/UnrealNetwork.h"
+#include "Tasks/Task.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/VRPushModelHelpers.h"
+
+DEFINE_LOG_CATEGORY(LogVRRenderTargetManager);
+
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager Encode"), STAT_RenderTargetManagerEncode, STATGROUP_VRRenderTargetManager);
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager Decode"), STAT_RenderTargetManagerDecode, STATGROUP_VRRenderTargetManager);
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager Apply Decoded"), STAT_RenderTargetManagerApplyDecoded, STATGROUP_VRRenderTargetManager);
 
 namespace RLE_Funcs
 {
@@ -53,6 +64,44 @@ namespace RLE_Funcs
 
 	template <typename DataType>
 	static inline void RLEWriteRunFlag(uint32 Count, uint8** loc, TArray<DataType>& Data, bool bCompressed);
+
+	// Vectorized versions, these produce and consume the exact same format as the functions above
+	// but find run boundaries with SIMD compares and fill runs with wide stores.
+
+	template <typename DataType>
+	static bool RLEEncodeBufferVectorized(const DataType* BufferToEncode, uint32 EncodeLength, TArray<uint8>* EncodedLine);
+
+	template <typename DataType>
+	static void RLEDecodeLineVectorized(const uint8* LineToDecode, uint32 Num, TArray<DataType>* DecodedLine);
+
+	// Writes a 1, 2, or 3 byte count header, BaseFlag is the byte sized flag of the set (CompressedByte, NotCompressedByte, ContinueRunByte)
+	static inline void RLEWriteCountFlag(uint8 BaseFlag, uint32 Count, uint8** loc);
+
+	// Reads a count header, returns false if the flag is invalid or the header would read past the end
+	static inline bool RLEReadCountFlag(const uint8*& loc, const uint8* EndLoc, uint8& OutFlag, uint32& OutCount);
+
+	// Returns the first index in [Start, LastIndex) where Data[i] == Data[i + 1], or LastIndex if there are none
+	template <typename DataType>
+	static inline uint32 RLEFindRunStart(const DataType* Data, uint32 Start, uint32 LastIndex);
+
+	// Returns the first index in [Start, LastIndex) where Data[i] != Data[i + 1], or LastIndex if there are none
+	template <typename DataType>
+	static inline uint32 RLEFindRunEnd(const DataType* Data, uint32 Start, uint32 LastIndex);
+
+	template <typename DataType>
+	static inline void RLEFillRun(DataType* Dest, DataType Value, uint32 Count);
+}
+
+namespace RenderTargetManagerCVars
+{
+	static int32 UseVectorizedRLE = 1;
+	FAutoConsoleVariableRef CVarUseVectorizedRLE(
+		TEXT("vr.RenderTargetManager.UseVectorizedRLE"),
+		UseVectorizedRLE,
+		TEXT("When on, render target snapshots are RLE encoded and decoded with the SIMD implementation.\n")
+		TEXT("Both implementations produce the same format.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
 }
 
 UVRRenderTargetManager::UVRRenderTargetManager(const FObjectInitializer& ObjectInitializer)
@@ -77,7 +126,13 @@ UVRRenderTargetManager::UVRRenderTargetManager(const FObjectInitializer& ObjectI
 	bInitiallyReplicateTexture = false;
 	bIsLoadingTextureBuffer = false;
 
+	bBatchDrawOperations = true;
+	MaxReplayRate = 0.0f;
+	LastReplayTime = 0.0;
+
 	OwnerIDCounter = 0;
+	RenderTargetRevision = 0;
+	DecodeRequestCounter = 0;
 }
 
 bool UVRRenderTargetManager::SendDrawOperations_Validate(const TArray<FRenderManagerOperation>& RenderOperationStoreList)
@@ -90,6 +145,48 @@ void UVRRenderTargetManager::SendDrawOperations_Implementation(const TArray<FRen
 	if (GetNetMode() == ENetMode::NM_Client)
 	{
 		RenderOperationStore.Append(RenderOperationStoreList);
+		RequestDrawOperationsReplay();
+	}
+	else
+	{
+		// The server re-sends whatever is left in the store, so it always has to flush immediately
+		DrawOperations();
+	}
+}
+
+void UVRRenderTargetManager::RequestDrawOperationsReplay()
+{
+	UWorld* World = GetWorld();
+
+	if (MaxReplayRate <= 0.0f || !World)
+	{
+		DrawOperations();
+		return;
+	}
+
+	// Already have a replay pending, these operations will be drawn with it
+	if (ReplayHandle.IsValid())
+		return;
+
+	double ReplayInterval = 1.0 / MaxReplayRate;
+	double TimeSinceReplay = World->GetTimeSeconds() - LastReplayTime;
+
+	if (TimeSinceReplay >= ReplayInterval)
+	{
+		ReplayDrawOperations();
+	}
+	else
+	{
+		World->GetTimerManager().SetTimer(ReplayHandle, this, &UVRRenderTargetManager::ReplayDrawOperations, (float)(ReplayInterval - TimeSinceReplay), false);
+	}
+}
+
+void UVRRenderTargetManager::ReplayDrawOperations()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(ReplayHandle);
+		LastReplayTime = World->GetTimeSeconds();
 	}
 
 	DrawOperations();
@@ -230,6 +327,94 @@ void UVRRenderTargetManager::DrawOperation(UCanvas* Canvas, const FRenderManager
 
 }
 
+void UVRRenderTargetManager::DrawOperationsBatched(UCanvas* Canvas, const TArray<FRenderManagerOperation>& Operations)
+{
+	FCanvas* RenderCanvas = Canvas ? Canvas->Canvas : nullptr;
+
+	if (!RenderCanvas)
+		return;
+
+	const FHitProxyId HitProxyId = RenderCanvas->GetHitProxyId();
+
+	// Only valid while nothing else has been drawn since it was retrieved, otherwise we would break draw order
+	FBatchedElements* LineBatch = nullptr;
+
+	FCanvasTriangleItem TriangleItem(FVector2D::ZeroVector, FVector2D::ZeroVector, FVector2D::ZeroVector, NULL);
+	UMaterial* TriangleMaterial = nullptr;
+
+	auto FlushTriangles = [&]()
+	{
+		if (TriangleItem.TriangleList.Num())
+		{
+			Canvas->DrawItem(TriangleItem);
+			TriangleItem.TriangleList.Reset();
+		}
+
+		TriangleMaterial = nullptr;
+	};
+
+	for (const FRenderManagerOperation& Operation : Operations)
+	{
+		if (IsValid(LocalProxy) && LocalProxy->OwnersID == Operation.OwnerID)
+		{
+			continue;
+		}
+
+		switch (Operation.OperationType)
+		{
+		case ERenderManagerOperationType::Op_LineDraw:
+		{
+			FlushTriangles();
+
+			if (!LineBatch)
+			{
+				LineBatch = RenderCanvas->GetBatchedElements(FCanvas::ET_Line);
+			}
+
+			LineBatch->AddLine(FVector(Operation.P1.X, Operation.P1.Y, 0.f), FVector(Operation.P2.X, Operation.P2.Y, 0.f), Operation.Color.ReinterpretAsLinear(), HitProxyId, (float)Operation.Thickness);
+		}break;
+		case ERenderManagerOperationType::Op_TriDraw:
+		{
+			UMaterial* OperationMaterial = Operation.Material.Get();
+
+			if (!Operation.Tris.Num() || !OperationMaterial)
+				break;
+
+			LineBatch = nullptr;
+
+			if (OperationMaterial != TriangleMaterial)
+			{
+				FlushTriangles();
+				TriangleMaterial = OperationMaterial;
+				TriangleItem.MaterialRenderProxy = OperationMaterial->GetRenderProxy();
+			}
+
+			FCanvasUVTri triStore;
+			triStore.V0_Color = Operation.Color;
+			triStore.V1_Color = Operation.Color;
+			triStore.V2_Color = Operation.Color;
+
+			TriangleItem.TriangleList.Reserve(TriangleItem.TriangleList.Num() + Operation.Tris.Num());
+			for (const FRenderManagerTri& Tri : Operation.Tris)
+			{
+				triStore.V0_Pos = Tri.P1;
+				triStore.V1_Pos = Tri.P2;
+				triStore.V2_Pos = Tri.P3;
+				TriangleItem.TriangleList.Add(triStore);
+			}
+		}break;
+		default:
+		{
+			FlushTriangles();
+			LineBatch = nullptr;
+			DrawOperation(Canvas, Operation);
+		}break;
+		}
+	}
+
+	FlushTriangles();
+}
+
 void UVRRenderTargetManager::DrawPoll()
 {
 	if (!RenderOperationStore.Num() && !LocalRenderOperationStore.Num())
@@ -256,7 +441,8 @@ void UVRRenderTargetManager::DrawPoll()
 			LocalRenderOperationStore.Empty();
 		}
 
-		DrawOperations();
+		// Shares the replay limit with received operations, the store keeps anything that has to wait
+		RequestDrawOperationsReplay();
 	}
 }
 
@@ -307,9 +493,22 @@ void UVRRenderTargetManager::DrawOperations()
 
 	if (CanvasToUse)
 	{
-		for (const FRenderManagerOperation& opt : RenderOperationStore)
+		if (bBatchDrawOperations)
+		{
+			DrawOperationsBatched(CanvasToUse, RenderOperationStore);
+		}
+		else
 		{
-			DrawOperation(CanvasToUse, opt);
+			for (const FRenderManagerOperation& opt : RenderOperationStore)
+			{
+				DrawOperation(CanvasToUse, opt);
+			}
+		}
+
+		if (RenderOperationStore.Num())
+		{
+			// Invalidates any cached snapshot
+			RenderTargetRevision++;
 		}
 
 		RenderOperationStore.Empty();
@@ -420,7 +619,7 @@ bool ARenderTargetReplicationProxy::Ack_InitTextureSend_Validate(int32 TotalData
 
 void ARenderTargetReplicationProxy::Ack_InitTextureSend_Implementation(int32 TotalDataCount)
 {
-	if (TotalDataCount == TextureStore.PackedData.Num())
+	if (SendSnapshot.IsValid() && TotalDataCount == SendSnapshot->PackedData.Num())
 	{
 		BlobNum = 0;
 
@@ -434,21 +633,37 @@ void ARenderTargetReplicationProxy::Ack_InitTextureSend_Implementation(int32 Tot
 	}
 }
 
+void ARenderTargetReplicationProxy::SendSnapshotToOwner(const FVRRenderTargetSnapshotPtr& Snapshot)
+{
+	if (!Snapshot.IsValid())
+		return;
+
+	// Drop any in progress send, the client will re-init with the new snapshot
+	if (SendTimer_Handle.IsValid())
+		GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
+
+	BlobNum = 0;
+	SendSnapshot = Snapshot;
+	SendInitMessage();
+}
+
 void ARenderTargetReplicationProxy::SendInitMessage()
 {
-	int32 TotalBlobs = TextureStore.PackedData.Num() / TextureBlobSize + (TextureStore.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+	if (!SendSnapshot.IsValid())
+		return;
+
+	const FVRRenderTargetSnapshot& Snapshot = *SendSnapshot;
+	int32 TotalBlobs = Snapshot.PackedData.Num() / TextureBlobSize + (Snapshot.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
 
-	InitTextureSend(TextureStore.Width, TextureStore.Height, TextureStore.PackedData.Num(), TotalBlobs, TextureStore.PixelFormat, TextureStore.bIsZipped/*, TextureStore.bJPG*/);
+	InitTextureSend(Snapshot.Width, Snapshot.Height, Snapshot.PackedData.Num(), TotalBlobs, Snapshot.PixelFormat, Snapshot.bIsZipped/*, Snapshot.bJPG*/);
 
 }
 
 void ARenderTargetReplicationProxy::SendNextDataBlob()
 {
-	if (!IsValid(this) || !this->GetOwner() || !IsValid(this->GetOwner()))
+	if (!IsValid(this) || !this->GetOwner() || !IsValid(this->GetOwner()) || !SendSnapshot.IsValid())
 	{	
-		TextureStore.Reset();
-		TextureStore.PackedData.Empty();
-		TextureStore.UnpackedData.Empty();
+		SendSnapshot.Reset();
 		BlobNum = 0;
 		if (SendTimer_Handle.IsValid())
 			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
@@ -456,29 +671,26 @@ void ARenderTargetReplicationProxy::SendNextDataBlob()
 		return;
 	}
 
+	const TArray<uint8>& PackedData = SendSnapshot->PackedData;
+
 	BlobNum++;
-	int32 TotalBlobs = TextureStore.PackedData.Num() / TextureBlobSize + (TextureStore.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+	int32 TotalBlobs = PackedData.Num() / TextureBlobSize + (PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
 
 	if (BlobNum <= TotalBlobs)
 	{
 		TArray<uint8> BlobStore;
-		int32 BlobLen = (BlobNum == TotalBlobs ? TextureStore.PackedData.Num() % TextureBlobSize : TextureBlobSize);
-
-
-		BlobStore.AddUninitialized(BlobLen);
-		uint8* MemLoc = TextureStore.PackedData.GetData();
 		int32 MemCount = (BlobNum - 1) * TextureBlobSize;
-		MemLoc += MemCount;
+		int32 BlobLen = FMath::Min(TextureBlobSize, PackedData.Num() - MemCount);
 
-		FMemory::Memcpy(BlobStore.GetData(), MemLoc, BlobLen);
+		BlobStore.AddUninitialized(BlobLen);
+		FMemory::Memcpy(BlobStore.GetData(), PackedData.GetData() + MemCount, BlobLen);
 
 		ReceiveTextureBlob(BlobStore, MemCount, BlobNum);
 	}
 	else
 	{
-		TextureStore.Reset();
-		TextureStore.PackedData.Empty();
-		TextureStore.UnpackedData.Empty();
+		// Release our reference to the shared snapshot
+		SendSnapshot.Reset();
 		if (SendTimer_Handle.IsValid())
 			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
 		BlobNum = 0;
@@ -491,8 +703,8 @@ void ARenderTargetReplicationProxy::GetLifetimeReplicatedProps(TArray< class FLi
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 
-	DOREPLIFETIME(ARenderTargetReplicationProxy, OwningManager);
-	DOREPLIFETIME(ARenderTargetReplicationProxy, OwnersID);
+	VRE_DOREPLIFETIME(ARenderTargetReplicationProxy, OwningManager);
+	VRE_DOREPLIFETIME(ARenderTargetReplicationProxy, OwnersID);
 }
 
 void ARenderTargetReplicationProxy::ReceiveTextureBlob_Implementation(const TArray<uint8>& TextureBlob, int32 LocationInData, int32 BlobNumber)
@@ -599,6 +811,8 @@ void UVRRenderTargetManager::UpdateRelevancyMap()
 						{
 							RenderProxy->OwnersID = ++OwnerIDCounter;
 							RenderProxy->OwningManager = this;
+							VRE_MARK_PROPERTY_DIRTY(ARenderTargetReplicationProxy, OwnersID, RenderProxy);
+							VRE_MARK_PROPERTY_DIRTY(ARenderTargetReplicationProxy, OwningManager, RenderProxy);
 							RenderProxy->MaxBytesPerSecondRate = MaxBytesPerSecondRate;
 							RenderProxy->TextureBlobSize = TextureBlobSize;
 							UGameplayStatics::FinishSpawningActor(RenderProxy, NewTransform);
@@ -635,7 +849,44 @@ void UVRRenderTargetManager::UpdateRelevancyMap()
 
 	if (bHadDirtyActors && bInitiallyReplicateTexture && GetNetMode() != ENetMode::NM_DedicatedServer)
 	{
-		QueueImageStore();
+		// If nothing has been drawn since our last encode then just stream the cached copy
+		FVRRenderTargetSnapshotPtr CurrentSnapshot = GetCurrentSnapshot();
+		if (CurrentSnapshot.IsValid())
+		{
+			SendSnapshotToDirtyClients(CurrentSnapshot);
+		}
+		else
+		{
+			QueueImageStore();
+		}
+	}
+}
+
+FVRRenderTargetSnapshotPtr UVRRenderTargetManager::GetCurrentSnapshot() const
+{
+	if (CachedSnapshot.IsValid() && CachedSnapshot->Revision == RenderTargetRevision)
+	{
+		return CachedSnapshot;
+	}
+
+	return nullptr;
+}
+
+void UVRRenderTargetManager::SendSnapshotToDirtyClients(const FVRRenderTargetSnapshotPtr& Snapshot)
+{
+	if (!Snapshot.IsValid())
+		return;
+
+	for (int i = NetRelevancyLog.Num() - 1; i >= 0; i--)
+	{
+		if (NetRelevancyLog[i].bIsDirty && IsValid(NetRelevancyLog[i].PC) && !NetRelevancyLog[i].PC->IsLocalController())
+		{
+			if (IsValid(NetRelevancyLog[i].ReplicationProxy))
+			{
+				NetRelevancyLog[i].ReplicationProxy->SendSnapshotToOwner(Snapshot);
+				NetRelevancyLog[i].bIsDirty = false;
+			}
+		}
 	}
 }
 
@@ -644,29 +895,67 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 	if (!RenderTarget)
 		return false;
 
-	RenderTargetStore.UnPackData();
+	// Hold off on draw operations until the decoded image has been written, otherwise they would be overwritten
+	bIsLoadingTextureBuffer = true;
 
+	uint32 DecodeID = ++DecodeRequestCounter;
+	TWeakObjectPtr<UVRRenderTargetManager> WeakThis(this);
 
-	int32 Width = RenderTargetStore.Width;
-	int32 Height = RenderTargetStore.Height;
-	EPixelFormat PixelFormat = RenderTargetStore.PixelFormat;
-	uint8 PixelFormat8 = 0;
+	FBPVRReplicatedTextureStore DecodeStore = MoveTemp(RenderTargetStore);
+	RenderTargetStore.Reset();
 
-	TArray<FColor> FinalColorData;
-	FinalColorData.AddUninitialized(RenderTargetStore.UnpackedData.Num());
-
-	uint32 Counter = 0;
-	FColor ColorVal;
-	ColorVal.A = 0xFF;
-	for (uint16 CompColor : RenderTargetStore.UnpackedData)
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, DecodeID, DecodeStore = MoveTemp(DecodeStore)]() mutable
 	{
-		//CompColor.FillTo(ColorVal);
-		ColorVal.R = CompColor << 3;
-		ColorVal.G = CompColor >> 5 << 2;
-		ColorVal.B = CompColor >> 11 << 3;
-		ColorVal.A = 0xFF;
-		FinalColorData[Counter++] = ColorVal;
-	}
+		TArray<FColor> FinalColorData;
+
+		{
+			SCOPE_CYCLE_COUNTER(STAT_RenderTargetManagerDecode);
+
+			DecodeStore.UnPackData();
+
+			FinalColorData.AddUninitialized(DecodeStore.UnpackedData.Num());
+
+			uint32 Counter = 0;
+			FColor ColorVal;
+			ColorVal.A = 0xFF;
+			for (uint16 CompColor : DecodeStore.UnpackedData)
+			{
+				//CompColor.FillTo(ColorVal);
+				ColorVal.R = CompColor << 3;
+				ColorVal.G = CompColor >> 5 << 2;
+				ColorVal.B = CompColor >> 11 << 3;
+				ColorVal.A = 0xFF;
+				FinalColorData[Counter++] = ColorVal;
+			}
+		}
+
+		int32 Width = DecodeStore.Width;
+		int32 Height = DecodeStore.Height;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, DecodeID, Width, Height, FinalColorData = MoveTemp(FinalColorData)]()
+		{
+			if (UVRRenderTargetManager* Manager = WeakThis.Get())
+			{
+				Manager->OnRenderTargetDecoded(DecodeID, Width, Height, FinalColorData);
+			}
+		});
+	});
+
+	return true;
+}
+
+void UVRRenderTargetManager::OnRenderTargetDecoded(uint32 DecodeID, int32 Width, int32 Height, const TArray<FColor>& FinalColorData)
+{
+	// A newer texture was received while we were decoding this one, let it apply instead
+	if (DecodeID != DecodeRequestCounter)
+		return;
+
+	bIsLoadingTextureBuffer = false;
+
+	if (!RenderTarget || !FinalColorData.Num() || FinalColorData.Num() > Width * Height)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_RenderTargetManagerApplyDecoded);
 
 	// Write this to a texture2d
 	UTexture2D* RenderBase = UTexture2D::CreateTransient(Width, Height, PF_R8G8B8A8);// RenderTargetStore.PixelFormat);
@@ -674,6 +963,14 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 	// Switched to a Memcpy instead of byte by byte transer
 	uint8* MipData = (uint8*)RenderBase->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
 	FMemory::Memcpy(MipData, (void*)FinalColorData.GetData(), FinalColorData.Num() * sizeof(FColor));
+
+	// Older senders can drop trailing pixels, clear the rest of the freshly allocated mip instead of showing whatever was in it
+	const int32 MissingPixels = (Width * Height) - FinalColorData.Num();
+	if (MissingPixels > 0)
+	{
+		FMemory::Memzero(MipData + FinalColorData.Num() * sizeof(FColor), MissingPixels * sizeof(FColor));
+	}
+
 	RenderBase->GetPlatformData()->Mips[0].BulkData.Unlock();
 
 	//Setting some Parameters for the Texture and finally returning it
@@ -747,7 +1044,8 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 	RenderBase->ReleaseResource();
 	RenderBase->MarkAsGarbage();
 
-	return true;
+	// Our contents were replaced, invalidate any cached snapshot
+	RenderTargetRevision++;
 }
 
 void UVRRenderTargetManager::QueueImageStore()
@@ -771,6 +1069,7 @@ void UVRRenderTargetManager::QueueImageStore()
 
 	renderData->Size2D = renderTargetResource->GetSizeXY();
 	renderData->PixelFormat = RenderTarget->GetFormat();
+	renderData->Revision = RenderTargetRevision;
 
 	struct FReadSurfaceContext {
 		FRenderTarget* SrcRenderTarget;
@@ -826,59 +1125,88 @@ void UVRRenderTargetManager::TickComponent(float DeltaTime, enum ELevelTick Tick
 		{
 			if (nextRenderData->RenderFence.IsFenceComplete())
 			{
-				bIsStoringImage = false;
-				RenderTargetStore.Reset();
-				uint32 SizeOfData = nextRenderData->ColorData.Num();
-
-				RenderTargetStore.UnpackedData.Reset(SizeOfData);
-				RenderTargetStore.UnpackedData.AddUninitialized(SizeOfData);
-
-				uint16 ColorVal = 0;
-				uint32 Counter = 0;
-
-				// Convert to 16bit color
-				for (FColor col : nextRenderData->ColorData)
-				{
-					ColorVal = (col.R >> 3) << 11 | (col.G >> 2) << 5 | (col.B >> 3);
-					RenderTargetStore.UnpackedData[Counter++] = ColorVal;
-				}
-
-				FIntPoint Size2D = nextRenderData->Size2D;
-				RenderTargetStore.Width = Size2D.X;
-				RenderTargetStore.Height = Size2D.Y;
-				RenderTargetStore.PixelFormat = nextRenderData->PixelFormat;
-				RenderTargetStore.PackData();
-
-
-//#if WITH_PUSH_MODEL
-				//MARK_PROPERTY_DIRTY_FROM_NAME(UVRRenderTargetManager, RenderTargetStore, this);
-//#endif
-
-
 				// Delete the first element from RenderQueue
 				RenderDataQueue.Pop();
+
+				TWeakObjectPtr<UVRRenderTargetManager> WeakThis(this);
+				FIntPoint Size2D = nextRenderData->Size2D;
+				EPixelFormat PixelFormat = nextRenderData->PixelFormat;
+				uint32 Revision = nextRenderData->Revision;
+				TArray<FColor> ColorData = MoveTemp(nextRenderData->ColorData);
 				delete nextRenderData;
 
-				for (int i = NetRelevancyLog.Num() - 1; i >= 0; i--)
+				// Encode off of the game thread, bIsStoringImage stays set until we are done
+				UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Size2D, PixelFormat, Revision, ColorData = MoveTemp(ColorData)]()
 				{
-					if (NetRelevancyLog[i].bIsDirty && IsValid(NetRelevancyLog[i].PC) && !NetRelevancyLog[i].PC->IsLocalController())
+					FVRRenderTargetSnapshotPtr NewSnapshot = UVRRenderTargetManager::EncodeSnapshot(ColorData, Size2D, PixelFormat, Revision);
+
+					AsyncTask(ENamedThreads::GameThread, [WeakThis, NewSnapshot]()
 					{
-						if (IsValid(NetRelevancyLog[i].ReplicationProxy))
+						if (UVRRenderTargetManager* Manager = WeakThis.Get())
 						{
-							NetRelevancyLog[i].ReplicationProxy->TextureStore = RenderTargetStore;
-							NetRelevancyLog[i].ReplicationProxy->SendInitMessage();
-							NetRelevancyLog[i].bIsDirty = false;
+							Manager->OnSnapshotEncoded(NewSnapshot);
 						}
-					}
-				}
-
-
+					});
+				});
 			}
 		}
 	}
 
 }
 
+FVRRenderTargetSnapshotPtr UVRRenderTargetManager::EncodeSnapshot(const TArray<FColor>& ColorData, FIntPoint Size2D, EPixelFormat PixelFormat, uint32 Revision)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RenderTargetManagerEncode);
+
+	FBPVRReplicatedTextureStore EncodeStore;
+	uint32 SizeOfData = ColorData.Num();
+
+	EncodeStore.UnpackedData.Reset(SizeOfData);
+	EncodeStore.UnpackedData.AddUninitialized(SizeOfData);
+
+	uint16 ColorVal = 0;
+	uint32 Counter = 0;
+
+	// Convert to 16bit color
+	for (FColor col : ColorData)
+	{
+		ColorVal = (col.R >> 3) << 11 | (col.G >> 2) << 5 | (col.B >> 3);
+		EncodeStore.UnpackedData[Counter++] = ColorVal;
+	}
+
+	EncodeStore.Width = Size2D.X;
+	EncodeStore.Height = Size2D.Y;
+	EncodeStore.PixelFormat = PixelFormat;
+	EncodeStore.PackData();
+
+	// Move the packed data into a shared snapshot so that every proxy streams the same encode
+	TSharedPtr<FVRRenderTargetSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FVRRenderTargetSnapshot, ESPMode::ThreadSafe>();
+	NewSnapshot->Revision = Revision;
+	NewSnapshot->Width = EncodeStore.Width;
+	NewSnapshot->Height = EncodeStore.Height;
+	NewSnapshot->PixelFormat = EncodeStore.PixelFormat;
+	NewSnapshot->bIsZipped = EncodeStore.bIsZipped;
+	NewSnapshot->PackedData = MoveTemp(EncodeStore.PackedData);
+
+	return NewSnapshot;
+}
+
+void UVRRenderTargetManager::OnSnapshotEncoded(const FVRRenderTargetSnapshotPtr& Snapshot)
+{
+	bIsStoringImage = false;
+
+	if (!Snapshot.IsValid())
+		return;
+
+	CachedSnapshot = Snapshot;
+
+//#if WITH_PUSH_MODEL
+	//MARK_PROPERTY_DIRTY_FROM_NAME(UVRRenderTargetManager, RenderTargetStore, this);
+//#endif
+
+	SendSnapshotToDirtyClients(CachedSnapshot);
+}
+
 void UVRRenderTargetManager::BeginPlay()
 {
 	Super::BeginPlay();
@@ -910,6 +1238,11 @@ void UVRRenderTargetManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	if(DrawHandle.IsValid())
 		GetWorld()->GetTimerManager().ClearTimer(DrawHandle);
 
+	if (ReplayHandle.IsValid())
+		GetWorld()->GetTimerManager().ClearTimer(ReplayHandle);
+
+	CachedSnapshot.Reset();
+
 	if (RenderTarget)
 	{
 		RenderTarget->ReleaseResource();
@@ -1116,7 +1449,14 @@ void FBPVRReplicatedTextureStore::PackData()
 	if (UnpackedData.Num() > 0)
 	{
 		TArray<uint8> TmpPacked;
-		RLE_Funcs::RLEEncodeBuffer<uint16>(UnpackedData.GetData(), UnpackedData.Num(), &TmpPacked);
+		if (RenderTargetManagerCVars::UseVectorizedRLE)
+		{
+			RLE_Funcs::RLEEncodeBufferVectorized<uint16>(UnpackedData.GetData(), UnpackedData.Num(), &TmpPacked);
+		}
+		else
+		{
+			RLE_Funcs::RLEEncodeBuffer<uint16>(UnpackedData.GetData(), UnpackedData.Num(), &TmpPacked);
+		}
 		UnpackedData.Reset();
 
 		/*if (TmpPacked.Num() > 30000)
@@ -1179,11 +1519,25 @@ void FBPVRReplicatedTextureStore::UnPackData()
 			TArray<uint8> RLEEncodedData;
 			FArchiveLoadCompressedProxy DataArchive(PackedData, NAME_Zlib);
 			DataArchive << RLEEncodedData;
-			RLE_Funcs::RLEDecodeLine<uint16>(&RLEEncodedData, &UnpackedData, true);
+			if (RenderTargetManagerCVars::UseVectorizedRLE)
+			{
+				RLE_Funcs::RLEDecodeLineVectorized<uint16>(RLEEncodedData.GetData(), RLEEncodedData.Num(), &UnpackedData);
+			}
+			else
+			{
+				RLE_Funcs::RLEDecodeLine<uint16>(&RLEEncodedData, &UnpackedData, true);
+			}
 		}
 		else
 		{
-			RLE_Funcs::RLEDecodeLine<uint16>(&PackedData, &UnpackedData, true);
+			if (RenderTargetManagerCVars::UseVectorizedRLE)
+			{
+				RLE_Funcs::RLEDecodeLineVectorized<uint16>(PackedData.GetData(), PackedData.Num(), &UnpackedData);
+			}
+			else
+			{
+				RLE_Funcs::RLEDecodeLine<uint16>(&PackedData, &UnpackedData, true);
+			}
 		}
 
 		PackedData.Reset();
@@ -1625,6 +1979,12 @@ bool RLE_Funcs::RLEEncodeBuffer(DataType* BufferToEncode, uint32 EncodeLength, T
 			TempBuffer.Add(Last);
 			RLE_Funcs::RLEWriteRunFlag(TempCount, &loc, TempBuffer, false);
 		}
+		else if (!bWroteStart)
+		{
+			// Single trailing value after a run (or a single value buffer), would be dropped otherwise
+			TempBuffer.Add(Last);
+			RLE_Funcs::RLEWriteRunFlag(1, &loc, TempBuffer, false);
+		}
 	}
 
 	// Resize the out array to fit compressed contents
@@ -1647,6 +2007,443 @@ bool RLE_Funcs::RLEEncodeBuffer(DataType* BufferToEncode, uint32 EncodeLength, T
 		return true;
 }
 
+// BEGIN VECTORIZED RLE FUNCTIONS ///
+
+void RLE_Funcs::RLEWriteCountFlag(uint8 BaseFlag, uint32 Count, uint8** loc)
+{
+	// Byte, Short, and 24 bit flags are sequential in each set
+	if (Count <= 16)
+	{
+		**loc = ((BaseFlag << 4) | ((uint8)(Count - 1)));
+		(*loc)++;
+	}
+	else if (Count <= 4096)
+	{
+		uint16 val = ((((uint16)(BaseFlag + 1)) << 12) | ((uint16)(Count - 1)));
+		**loc = (uint8)(val >> 8);
+		(*loc)++;
+		**loc = (uint8)val;
+		(*loc)++;
+	}
+	else
+	{
+		uint32 val = ((((uint32)(BaseFlag + 2)) << 20) | (Count - 1));
+		**loc = (uint8)(val >> 16);
+		(*loc)++;
+		**loc = (uint8)(val >> 8);
+		(*loc)++;
+		**loc = (uint8)val;
+		(*loc)++;
+	}
+}
+
+bool RLE_Funcs::RLEReadCountFlag(const uint8*& loc, const uint8* EndLoc, uint8& OutFlag, uint32& OutCount)
+{
+	OutFlag = *loc >> 4;
+
+	switch (OutFlag)
+	{
+	case RLE_Flags::RLE_CompressedByte:
+	case RLE_Flags::RLE_NotCompressedByte:
+	case RLE_Flags::RLE_ContinueRunByte:
+	{
+		OutCount = (*loc & ~0xF0) + 1;
+		loc++;
+	}break;
+	case RLE_Flags::RLE_CompressedShort:
+	case RLE_Flags::RLE_NotCompressedShort:
+	case RLE_Flags::RLE_ContinueRunShort:
+	{
+		if (loc + 2 > EndLoc)
+			return false;
+
+		OutCount = (((uint32)(*loc & ~0xF0)) << 8 | ((uint32)(*(loc + 1)))) + 1;
+		loc += 2;
+	}break;
+	case RLE_Flags::RLE_Compressed24:
+	case RLE_Flags::RLE_NotCompressed24:
+	case RLE_Flags::RLE_ContinueRun24:
+	{
+		if (loc + 3 > EndLoc)
+			return false;
+
+		OutCount = (((uint32)(*loc & ~0xF0)) << 16 | ((uint32)(*(loc + 1))) << 8 | ((uint32)(*(loc + 2)))) + 1;
+		loc += 3;
+	}break;
+	default:
+	{
+		return false;
+	}break;
+	}
+
+	return true;
+}
+
+template <typename DataType>
+uint32 RLE_Funcs::RLEFindRunStart(const DataType* Data, uint32 Start, uint32 LastIndex)
+{
+	uint32 i = Start;
+
+	if constexpr (std::is_same_v<DataType, uint16>)
+	{
+		// Compare 8 pixels against their right neighbor at a time, the highest read is Data[i + 8] which is <= LastIndex
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+		for (; i + 8 <= LastIndex; i += 8)
+		{
+			uint16x8_t Eq = vceqq_u16(vld1q_u16(Data + i), vld1q_u16(Data + i + 1));
+			uint64 Mask = vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(Eq)), 0);
+			if (Mask)
+			{
+				return i + (FMath::CountTrailingZeros64(Mask) >> 3);
+			}
+		}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+		for (; i + 8 <= LastIndex; i += 8)
+		{
+			__m128i Eq = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(Data + i)), _mm_loadu_si128((const __m128i*)(Data + i + 1)));
+			uint32 Mask = (uint32)_mm_movemask_epi8(Eq);
+			if (Mask)
+			{
+				return i + (FMath::CountTrailingZeros(Mask) >> 1);
+			}
+		}
+#endif
+	}
+
+	for (; i < LastIndex; ++i)
+	{
+		if (Data[i] == Data[i + 1])
+			return i;
+	}
+
+	return LastIndex;
+}
+
+template <typename DataType>
+uint32 RLE_Funcs::RLEFindRunEnd(const DataType* Data, uint32 Start, uint32 LastIndex)
+{
+	uint32 i = Start;
+
+	if constexpr (std::is_same_v<DataType, uint16>)
+	{
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+		for (; i + 8 <= LastIndex; i += 8)
+		{
+			uint16x8_t Eq = vceqq_u16(vld1q_u16(Data + i), vld1q_u16(Data + i + 1));
+			uint64 Mask = ~vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(Eq)), 0);
+			if (Mask)
+			{
+				return i + (FMath::CountTrailingZeros64(Mask) >> 3);
+			}
+		}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+		for (; i + 8 <= LastIndex; i += 8)
+		{
+			__m128i Eq = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(Data + i)), _mm_loadu_si128((const __m128i*)(Data + i + 1)));
+			uint32 Mask = ~((uint32)_mm_movemask_epi8(Eq)) & 0xFFFF;
+			if (Mask)
+			{
+				return i + (FMath::CountTrailingZeros(Mask) >> 1);
+			}
+		}
+#endif
+	}
+
+	for (; i < LastIndex; ++i)
+	{
+		if (Data[i] != Data[i + 1])
+			return i;
+	}
+
+	return LastIndex;
+}
+
+template <typename DataType>
+void RLE_Funcs::RLEFillRun(DataType* Dest, DataType Value, uint32 Count)
+{
+	uint32 i = 0;
+
+	if constexpr (std::is_same_v<DataType, uint16>)
+	{
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+		uint16x8_t Fill = vdupq_n_u16(Value);
+		for (; i + 8 <= Count; i += 8)
+		{
+			vst1q_u16(Dest + i, Fill);
+		}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+		__m128i Fill = _mm_set1_epi16((short)Value);
+		for (; i + 8 <= Count; i += 8)
+		{
+			_mm_storeu_si128((__m128i*)(Dest + i), Fill);
+		}
+#endif
+	}
+
+	for (; i < Count; ++i)
+	{
+		Dest[i] = Value;
+	}
+}
+
+template <typename DataType>
+bool RLE_Funcs::RLEEncodeBufferVectorized(const DataType* BufferToEncode, uint32 EncodeLength, TArray<uint8>* EncodedLine)
+{
+	const uint32 MAX_COUNT = 1048576; // Max of 2.5 bytes as 0.5 bytes is used for control flags
+	const uint32 incr = sizeof(DataType);
+
+	EncodedLine->Reset();
+
+	if (!EncodeLength)
+		return true;
+
+	// Runs never grow the data, lone literals between runs can add at most one header byte per every other value
+	EncodedLine->AddUninitialized((EncodeLength * incr) + (EncodeLength / 2) + 16);
+
+	uint8* loc = EncodedLine->GetData();
+	const uint32 LastIndex = EncodeLength - 1;
+	uint32 i = 0;
+
+	while (i < EncodeLength)
+	{
+		if (i < LastIndex && BufferToEncode[i] == BufferToEncode[i + 1])
+		{
+			// Run from i to RunEnd inclusive, first chunk carries the value and the rest are continues
+			uint32 RunEnd = RLEFindRunEnd(BufferToEncode, i, LastIndex);
+			uint32 RunLength = (RunEnd - i) + 1;
+			uint32 Chunk = FMath::Min(RunLength, MAX_COUNT);
+
+			RLEWriteCountFlag(RLE_Flags::RLE_CompressedByte, Chunk, &loc);
+			FMemory::Memcpy(loc, &BufferToEncode[i], incr);
+			loc += incr;
+			RunLength -= Chunk;
+
+			while (RunLength > 0)
+			{
+				Chunk = FMath::Min(RunLength, MAX_COUNT);
+				RLEWriteCountFlag(RLE_Flags::RLE_ContinueRunByte, Chunk, &loc);
+				RunLength -= Chunk;
+			}
+
+			i = RunEnd + 1;
+		}
+		else
+		{
+			// Literals up until the next run, or the end of the buffer if there are no more runs
+			uint32 LiteralEnd = i < LastIndex ? RLEFindRunStart(BufferToEncode, i, LastIndex) : LastIndex;
+			if (LiteralEnd == LastIndex)
+				LiteralEnd = EncodeLength;
+
+			while (i < LiteralEnd)
+			{
+				uint32 Chunk = FMath::Min(LiteralEnd - i, MAX_COUNT);
+				RLEWriteCountFlag(RLE_Flags::RLE_NotCompressedByte, Chunk, &loc);
+				FMemory::Memcpy(loc, &BufferToEncode[i], Chunk * incr);
+				loc += Chunk * incr;
+				i += Chunk;
+			}
+		}
+	}
+
+	// Resize the out array to fit compressed contents
+	uint32 Wrote = loc - EncodedLine->GetData();
+	EncodedLine->RemoveAt(Wrote, EncodedLine->Num() - Wrote, true);
+
+	return true;
+}
+
+template <typename DataType>
+void RLE_Funcs::RLEDecodeLineVectorized(const uint8* LineToDecode, uint32 Num, TArray<DataType>* DecodedLine)
+{
+	if (!LineToDecode || !DecodedLine)
+		return;
+
+	const uint8* EndLoc = LineToDecode + Num;
+	const uint32 incr = sizeof(DataType);
+
+	uint8 RLE_FLAG = 0;
+	uint32 Count = 0;
+
+	// First pass sums up the decoded length so that we can allocate once and write with raw pointers
+	uint64 TotalCount = 0;
+	for (const uint8* loc = LineToDecode; loc < EndLoc;)
+	{
+		if (!RLEReadCountFlag(loc, EndLoc, RLE_FLAG, Count))
+			break;
+
+		if (RLE_FLAG <= RLE_Flags::RLE_Compressed24)
+		{
+			loc += incr;
+		}
+		else if (RLE_FLAG <= RLE_Flags::RLE_NotCompressed24)
+		{
+			loc += Count * incr;
+		}
+
+		if (loc > EndLoc)
+			break;
+
+		TotalCount += Count;
+	}
+
+	DecodedLine->Empty(TotalCount);
+	DecodedLine->AddUninitialized(TotalCount);
+
+	DataType* Out = DecodedLine->GetData();
+	DataType* OutEnd = Out + TotalCount;
+	DataType ValToWrite = DataType();
+
+	for (const uint8* loc = LineToDecode; loc < EndLoc && Out < OutEnd;)
+	{
+		if (!RLEReadCountFlag(loc, EndLoc, RLE_FLAG, Count) || Out + Count > OutEnd)
+			break;
+
+		if (RLE_FLAG <= RLE_Flags::RLE_Compressed24)
+		{
+			FMemory::Memcpy(&ValToWrite, loc, incr);
+			loc += incr;
+			RLEFillRun(Out, ValToWrite, Count);
+		}
+		else if (RLE_FLAG <= RLE_Flags::RLE_NotCompressed24)
+		{
+			FMemory::Memcpy(Out, loc, Count * incr);
+			loc += Count * incr;
+		}
+		else
+		{
+			RLEFillRun(Out, ValToWrite, Count);
+		}
+
+		Out += Count;
+	}
+}
+
+// END VECTORIZED RLE FUNCTIONS ///
+
+namespace RenderTargetManagerBenchmark
+{
+	// Fills a canvas with representative content, 0 = blank, 1 = strokes on a blank background, 2 = noise
+	static void GenerateCanvas(int32 Size, int32 CanvasType, TArray<uint16>& OutCanvas)
+	{
+		FRandomStream Stream(Size + CanvasType);
+		OutCanvas.Reset(Size * Size);
+		OutCanvas.AddUninitialized(Size * Size);
+
+		const uint16 Background = 0xFFFF;
+
+		switch (CanvasType)
+		{
+		case 0:
+		{
+			for (uint16& Pixel : OutCanvas)
+			{
+				Pixel = Background;
+			}
+		}break;
+		case 1:
+		{
+			for (uint16& Pixel : OutCanvas)
+			{
+				Pixel = Background;
+			}
+
+			// Short thick line segments in a small palette, similar to what the line draw operations produce
+			int32 StrokeCount = FMath::Max(1, Size / 4);
+			for (int32 Stroke = 0; Stroke < StrokeCount; ++Stroke)
+			{
+				uint16 StrokeColor = (uint16)Stream.RandRange(0, 7) * 0x1F00;
+				FVector2D Start(Stream.FRandRange(0.f, Size - 1), Stream.FRandRange(0.f, Size - 1));
+				FVector2D Dir = FVector2D(Stream.FRandRange(-1.f, 1.f), Stream.FRandRange(-1.f, 1.f)).GetSafeNormal();
+				int32 Length = Stream.RandRange(8, FMath::Max(8, Size / 8));
+				int32 Thickness = Stream.RandRange(1, 6);
+
+				for (int32 Step = 0; Step < Length; ++Step)
+				{
+					FVector2D Point = Start + Dir * Step;
+					for (int32 Offset = 0; Offset < Thickness; ++Offset)
+					{
+						int32 X = FMath::Clamp(FMath::RoundToInt(Point.X) + Offset, 0, Size - 1);
+						int32 Y = FMath::Clamp(FMath::RoundToInt(Point.Y), 0, Size - 1);
+						OutCanvas[Y * Size + X] = StrokeColor;
+					}
+				}
+			}
+		}break;
+		default:
+		{
+			for (uint16& Pixel : OutCanvas)
+			{
+				Pixel = (uint16)Stream.RandRange(0, 0xFFFF);
+			}
+		}break;
+		}
+	}
+
+	static void RunRLEBenchmark(const TArray<FString>& Args)
+	{
+		int32 Size = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 2048;
+		int32 Iterations = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 10;
+		Size = FMath::Clamp(Size, 16, 8192);
+		Iterations = FMath::Max(Iterations, 1);
+
+		static const TCHAR* CanvasNames[] = { TEXT("Blank"), TEXT("Strokes"), TEXT("Noise") };
+
+		TArray<uint16> Canvas;
+		TArray<uint8> ScalarEncoded;
+		TArray<uint8> VectorEncoded;
+		TArray<uint16> ScalarDecoded;
+		TArray<uint16> VectorDecoded;
+
+		for (int32 CanvasType = 0; CanvasType < 3; ++CanvasType)
+		{
+			GenerateCanvas(Size, CanvasType, Canvas);
+
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				RLE_Funcs::RLEEncodeBuffer<uint16>(Canvas.GetData(), Canvas.Num(), &ScalarEncoded);
+			}
+			double ScalarEncodeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				RLE_Funcs::RLEEncodeBufferVectorized<uint16>(Canvas.GetData(), Canvas.Num(), &VectorEncoded);
+			}
+			double VectorEncodeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				RLE_Funcs::RLEDecodeLine<uint16>(&ScalarEncoded, &ScalarDecoded, true);
+			}
+			double ScalarDecodeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				RLE_Funcs::RLEDecodeLineVectorized<uint16>(VectorEncoded.GetData(), VectorEncoded.Num(), &VectorDecoded);
+			}
+			double VectorDecodeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+
+			bool bEncodeMatches = ScalarEncoded == VectorEncoded;
+			bool bDecodeMatches = ScalarDecoded == Canvas && VectorDecoded == Canvas;
+
+			UE_LOG(LogVRRenderTargetManager, Display, TEXT("RLE %s %ix%i (%i bytes packed): Encode scalar %.3fms vectorized %.3fms, Decode scalar %.3fms vectorized %.3fms, Output %s, Round trip %s"),
+				CanvasNames[CanvasType], Size, Size, VectorEncoded.Num(),
+				ScalarEncodeMs, VectorEncodeMs, ScalarDecodeMs, VectorDecodeMs,
+				bEncodeMatches ? TEXT("identical") : TEXT("MISMATCH"),
+				bDecodeMatches ? TEXT("ok") : TEXT("FAILED"));
+		}
+	}
+
+	FAutoConsoleCommand CmdBenchmarkRLE(
+		TEXT("vr.RenderTargetManager.BenchmarkRLE"),
+		TEXT("Compares the scalar and vectorized RLE implementations on generated canvas images.\n")
+		TEXT("Usage: vr.RenderTargetManager.BenchmarkRLE [Size=2048] [Iterations=10]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunRLEBenchmark));
+}
+
 template<int32 ScaleFactor, int32 MaxBitsPerComponent>
 bool WritePackedVector2D(FVector2D Value, FArchive& Ar)	// Note Value is intended to not be a reference since we are scaling it before serializing!
 {
@@ -0,0 +1,237 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/VRReplicationGraph.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VRReplicationGraph)
+
+#include "VRBaseCharacter.h"
+
+uint8 FVRReplicationGraphCharacterPolicy::GetReplicationPeriod(const FNetViewer& Viewer, const AActor* Character) const
+{
+	// The viewers own character always goes at the full rate
+	if (Character == Viewer.ViewTarget || Character == Viewer.InViewer || (Viewer.Connection && Character->GetNetConnection() == Viewer.Connection))
+		return (uint8)FMath::Clamp(FullRatePeriod, 1, 255);
+
+	const FVector ToCharacter = Character->GetActorLocation() - Viewer.ViewLocation;
+	const float DistSq = ToCharacter.SizeSquared();
+
+	if (CullDistance > 0.0f && DistSq > FMath::Square(CullDistance))
+		return 0;
+
+	if (DistSq <= FMath::Square(FullRateDistance))
+		return (uint8)FMath::Clamp(FullRatePeriod, 1, 255);
+
+	int32 Period = DistSq <= FMath::Square(ReducedRateDistance) ? ReducedRatePeriod : FarRatePeriod;
+
+	// Hands and heads behind the viewer can be a little behind
+	if ((ToCharacter.GetSafeNormal() | Viewer.ViewDir) < OutOfViewDot)
+	{
+		Period *= FMath::Max(OutOfViewPeriodScale, 1);
+	}
+
+	return (uint8)FMath::Clamp(Period, 1, 255);
+}
+
+UVRReplicationGraphNode_Characters::UVRReplicationGraphNode_Characters() :
+	Super()
+{
+	bRequiresPrepareForReplicationCall = true;
+	LastConnectionCleanupFrame = 0;
+}
+
+FIntPoint UVRReplicationGraphNode_Characters::GetCell(const FVector& Location) const
+{
+	const float CellSize = FMath::Max(Policy.CellSize, 100.0f);
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UVRReplicationGraphNode_Characters::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	Characters.AddUnique(ActorInfo.Actor);
+}
+
+bool UVRReplicationGraphNode_Characters::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	const bool bRemoved = Characters.RemoveSwap(ActorInfo.Actor) > 0;
+
+	if (bRemoved)
+	{
+		// Cells are rebuilt next frame, but this actor can't be gathered again before then
+		for (TPair<FIntPoint, TArray<AActor*>>& Cell : CharacterCells)
+		{
+			Cell.Value.RemoveSwap(ActorInfo.Actor);
+		}
+	}
+
+	UE_CLOG(!bRemoved && bWarnIfNotFound, LogNet, Warning, TEXT("UVRReplicationGraphNode_Characters::NotifyRemoveNetworkActor: %s was not found in the node"), *GetNameSafe(ActorInfo.Actor));
+	return bRemoved;
+}
+
+void UVRReplicationGraphNode_Characters::NotifyResetAllNetworkActors()
+{
+	Characters.Reset();
+	CharacterCells.Reset();
+	ConnectionLists.Reset();
+}
+
+void UVRReplicationGraphNode_Characters::PrepareForReplication()
+{
+	for (TPair<FIntPoint, TArray<AActor*>>& Cell : CharacterCells)
+	{
+		Cell.Value.Reset();
+	}
+
+	for (AActor* Character : Characters)
+	{
+		if (IsValid(Character))
+		{
+			CharacterCells.FindOrAdd(GetCell(Character->GetActorLocation())).Add(Character);
+		}
+	}
+
+	// Every so often drop empty cells and the lists of connections that have closed
+	if (++LastConnectionCleanupFrame >= 300)
+	{
+		LastConnectionCleanupFrame = 0;
+
+		for (auto It = CharacterCells.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().Num())
+				It.RemoveCurrent();
+		}
+
+		for (auto It = ConnectionLists.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+				It.RemoveCurrent();
+		}
+	}
+}
+
+void UVRReplicationGraphNode_Characters::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	BestPeriods.Reset();
+
+	auto ConsiderCharacter = [&](const FNetViewer& Viewer, AActor* Character)
+	{
+		const uint8 Period = Policy.GetReplicationPeriod(Viewer, Character);
+		if (Period > 0)
+		{
+			uint8& BestPeriod = BestPeriods.FindOrAdd(Character, MAX_uint8);
+			BestPeriod = FMath::Min(BestPeriod, Period);
+		}
+	};
+
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		if (Policy.CullDistance <= 0.0f)
+		{
+			// Nothing is culled, no point in walking the cells
+			for (AActor* Character : Characters)
+			{
+				if (IsValid(Character))
+					ConsiderCharacter(Viewer, Character);
+			}
+			continue;
+		}
+
+		const FIntPoint ViewerCell = GetCell(Viewer.ViewLocation);
+		const int32 CellRadius = FMath::CeilToInt(Policy.CullDistance / FMath::Max(Policy.CellSize, 100.0f));
+
+		for (int32 X = -CellRadius; X <= CellRadius; ++X)
+		{
+			for (int32 Y = -CellRadius; Y <= CellRadius; ++Y)
+			{
+				if (const TArray<AActor*>* Cell = CharacterCells.Find(ViewerCell + FIntPoint(X, Y)))
+				{
+					for (AActor* Character : *Cell)
+					{
+						ConsiderCharacter(Viewer, Character);
+					}
+				}
+			}
+		}
+	}
+
+	FActorRepListRefView& ConnectionList = ConnectionLists.FindOrAdd(&Params.ConnectionManager);
+	ConnectionList.Reset(BestPeriods.Num());
+
+	for (const TPair<AActor*, uint8>& BestPeriod : BestPeriods)
+	{
+		FConnectionReplicationActorInfo& ConnectionInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(BestPeriod.Key);
+		ConnectionInfo.ReplicationPeriodFrame = BestPeriod.Value;
+
+		// If the character moved into a faster band then pull its next send in instead of waiting out the old period
+		const uint32 NextFrameAtPeriod = ConnectionInfo.LastRepFrameNum + BestPeriod.Value;
+		if (ConnectionInfo.NextReplicationFrameNum > NextFrameAtPeriod)
+		{
+			ConnectionInfo.NextReplicationFrameNum = NextFrameAtPeriod;
+		}
+
+		ConnectionList.Add(BestPeriod.Key);
+	}
+
+	if (ConnectionList.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(ConnectionList);
+	}
+}
+
+void UVRReplicationGraphNode_Characters::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
+{
+	DebugInfo.Log(NodeName);
+	DebugInfo.PushIndent();
+	DebugInfo.Log(FString::Printf(TEXT("Characters: %d Cells: %d Connections: %d"), Characters.Num(), CharacterCells.Num(), ConnectionLists.Num()));
+
+	for (const AActor* Character : Characters)
+	{
+		DebugInfo.Log(GetNameSafe(Character));
+	}
+
+	DebugInfo.PopIndent();
+}
+
+UVRReplicationGraph::UVRReplicationGraph() :
+	Super()
+{
+	VRCharacterNode = nullptr;
+}
+
+void UVRReplicationGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	VRCharacterNode = CreateNewNode<UVRReplicationGraphNode_Characters>();
+	VRCharacterNode->Policy = CharacterPolicy;
+	AddGlobalGraphNode(VRCharacterNode);
+}
+
+void UVRReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+
+	// Always relevant and owner only characters keep going through the basic routing
+	if (VRCharacterNode && Actor && Actor->IsA<AVRBaseCharacter>() && !Actor->bAlwaysRelevant && !Actor->bOnlyRelevantToOwner)
+	{
+		// The node sets the per connection period, the actor itself is allowed every frame
+		GlobalInfo.Settings.ReplicationPeriodFrame = 1;
+		GlobalInfo.Settings.SetCullDistanceSquared(CharacterPolicy.CullDistance > 0.0f ? FMath::Square(CharacterPolicy.CullDistance) : 0.0f);
+
+		VRCharacterNode->NotifyAddNetworkActor(ActorInfo);
+		RoutedCharacters.Add(Actor);
+		return;
+	}
+
+	Super::RouteAddNetworkActorToNodes(ActorInfo, GlobalInfo);
+}
+
+void UVRReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	// Relevancy flags can change after the actor was added, so remove it from wherever it was routed to
+	if (VRCharacterNode && RoutedCharacters.Remove(ActorInfo.Actor) > 0)
+	{
+		VRCharacterNode->NotifyRemoveNetworkActor(ActorInfo);
+		return;
+	}
+
+	Super::RouteRemoveNetworkActorToNodes(ActorInfo);
+}
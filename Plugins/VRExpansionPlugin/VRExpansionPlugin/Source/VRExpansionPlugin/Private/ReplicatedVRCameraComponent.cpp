@@ -4,6 +4,7 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ReplicatedVRCameraComponent)
 
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
 #include "VRBaseCharacter.h"
 #include "VRCharacter.h"
 #include "VRRootComponent.h"
@@ -71,9 +72,9 @@ void UReplicatedVRCameraComponent::GetLifetimeReplicatedProps(TArray< class FLif
 	DISABLE_REPLICATED_PRIVATE_PROPERTY(USceneComponent, RelativeScale3D);
 
 	// Skipping the owner with this as the owner will use the location directly
-	DOREPLIFETIME_CONDITION(UReplicatedVRCameraComponent, ReplicatedCameraTransform, COND_SkipOwner);
-	DOREPLIFETIME(UReplicatedVRCameraComponent, NetUpdateRate);
-	DOREPLIFETIME(UReplicatedVRCameraComponent, bSmoothReplicatedMotion);
+	VRE_DOREPLIFETIME_CONDITION(UReplicatedVRCameraComponent, ReplicatedCameraTransform, COND_SkipOwner);
+	VRE_DOREPLIFETIME(UReplicatedVRCameraComponent, NetUpdateRate);
+	VRE_DOREPLIFETIME(UReplicatedVRCameraComponent, bSmoothReplicatedMotion);
 	//DOREPLIFETIME(UReplicatedVRCameraComponent, bReplicateTransform);
 }
 
@@ -92,6 +93,7 @@ void UReplicatedVRCameraComponent::Server_SendCameraTransform_Implementation(FBP
 {
 	// Store new transform and trigger OnRep_Function
 	ReplicatedCameraTransform = NewTransform;
+	VRE_MARK_PROPERTY_DIRTY(UReplicatedVRCameraComponent, ReplicatedCameraTransform, this);
 
 	// Don't call on rep on the server if the server controls this controller
 	if (!bHasAuthority)
@@ -196,6 +198,7 @@ void UReplicatedVRCameraComponent::UpdateTracking(float DeltaTime)
 
 				ReplicatedCameraTransform.Position = Position;
 				ReplicatedCameraTransform.Rotation = Orientation.Rotator();
+				VRE_MARK_PROPERTY_DIRTY(UReplicatedVRCameraComponent, ReplicatedCameraTransform, this);
 
 				if (IsValid(AttachChar) && !AttachChar->bRetainRoomscale)
 				{	
@@ -401,6 +404,7 @@ void UReplicatedVRCameraComponent::TickComponent(float DeltaTime, enum ELevelTic
 					{
 						ReplicatedCameraTransform.Position = RelativeLoc;
 						ReplicatedCameraTransform.Rotation = RelativeRot;
+						VRE_MARK_PROPERTY_DIRTY(UReplicatedVRCameraComponent, ReplicatedCameraTransform, this);
 					}
 
 					if (GetNetMode() == NM_Client)
@@ -463,6 +467,7 @@ void UReplicatedVRCameraComponent::HandleXRCamera()
 
 						ReplicatedCameraTransform.Position = Position;
 						ReplicatedCameraTransform.Rotation = Orientation.Rotator();
+						VRE_MARK_PROPERTY_DIRTY(UReplicatedVRCameraComponent, ReplicatedCameraTransform, this);
 
 						if (IsValid(AttachChar) && !AttachChar->bRetainRoomscale)
 						{
@@ -13,6 +13,7 @@
 #include "VRRootComponent.h"
 #include "VRPathFollowingComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Misc/VRPushModelHelpers.h"
 #include "XRMotionControllerBase.h"
 //#include "Runtime/Engine/Private/EnginePrivate.h"
 
@@ -235,13 +236,13 @@ void AVRBaseCharacter::PostInitializeComponents()
 void AVRBaseCharacter::GetLifetimeReplicatedProps(TArray< class FLifetimeProperty > & OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME_CONDITION(AVRBaseCharacter, SeatInformation, COND_None);
-	DOREPLIFETIME_CONDITION(AVRBaseCharacter, VRReplicateCapsuleHeight, COND_None);
-	DOREPLIFETIME_CONDITION(AVRBaseCharacter, ReplicatedCapsuleHeight, COND_SimulatedOnly);
+	VRE_DOREPLIFETIME_CONDITION(AVRBaseCharacter, SeatInformation, COND_None);
+	VRE_DOREPLIFETIME_CONDITION(AVRBaseCharacter, VRReplicateCapsuleHeight, COND_None);
+	VRE_DOREPLIFETIME_CONDITION(AVRBaseCharacter, ReplicatedCapsuleHeight, COND_SimulatedOnly);
 	
 	DISABLE_REPLICATED_PRIVATE_PROPERTY(AActor, ReplicatedMovement);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(AVRBaseCharacter, ReplicatedMovementVR, COND_SimulatedOrPhysics, REPNOTIFY_Always);
+	VRE_DOREPLIFETIME_CONDITION_NOTIFY(AVRBaseCharacter, ReplicatedMovementVR, COND_SimulatedOrPhysics, REPNOTIFY_Always);
 }
 
 void AVRBaseCharacter::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
@@ -283,6 +284,7 @@ void AVRBaseCharacter::Server_ReZeroSeating_Implementation(FTransform_NetQuantiz
 		SeatInformation.StoredTargetTransform.AddToTranslation(FVector(0, 0, -newLocation.Z));
 	}
 
+	MarkSeatInformationDirty();
 	OnRep_SeatedCharInfo();
 }
 
@@ -443,6 +445,10 @@ void AVRBaseCharacter::GatherCurrentMovement()
 
 	FRepMovement ReppedMovement = this->GetReplicatedMovement();
 
+#if VREXPANSION_PUSH_MODEL
+	const FRepMovementVRCharacter OldMovementVR = ReplicatedMovementVR;
+#endif
+
 	ReplicatedMovementVR.AngularVelocity = ReppedMovement.AngularVelocity;
 	ReplicatedMovementVR.bRepPhysics = ReppedMovement.bRepPhysics;
 	ReplicatedMovementVR.bSimulatedPhysicSleep = ReppedMovement.bSimulatedPhysicSleep;
@@ -457,6 +463,31 @@ void AVRBaseCharacter::GatherCurrentMovement()
 	ReplicatedMovementVR.PausedTrackingLoc = PausedTrackingLoc;
 	ReplicatedMovementVR.PausedTrackingRot = PausedTrackingRot;
 
+#if VREXPANSION_PUSH_MODEL
+	if (OldMovementVR.Location != ReplicatedMovementVR.Location || OldMovementVR.Rotation != ReplicatedMovementVR.Rotation ||
+		OldMovementVR.LinearVelocity != ReplicatedMovementVR.LinearVelocity || OldMovementVR.AngularVelocity != ReplicatedMovementVR.AngularVelocity ||
+		OldMovementVR.bRepPhysics != ReplicatedMovementVR.bRepPhysics || OldMovementVR.bSimulatedPhysicSleep != ReplicatedMovementVR.bSimulatedPhysicSleep ||
+		OldMovementVR.bJustTeleported != ReplicatedMovementVR.bJustTeleported || OldMovementVR.bJustTeleportedGrips != ReplicatedMovementVR.bJustTeleportedGrips ||
+		OldMovementVR.bPausedTracking != ReplicatedMovementVR.bPausedTracking || OldMovementVR.PausedTrackingLoc != ReplicatedMovementVR.PausedTrackingLoc ||
+		OldMovementVR.PausedTrackingRot != ReplicatedMovementVR.PausedTrackingRot)
+	{
+		VRE_MARK_PROPERTY_DIRTY(AVRBaseCharacter, ReplicatedMovementVR, this);
+	}
+#endif
+}
+
+void AVRBaseCharacter::SetReplicatedCapsuleHeight(float NewCapsuleHeight)
+{
+	if (ReplicatedCapsuleHeight.CapsuleHeight != NewCapsuleHeight)
+	{
+		ReplicatedCapsuleHeight.CapsuleHeight = NewCapsuleHeight;
+		VRE_MARK_PROPERTY_DIRTY(AVRBaseCharacter, ReplicatedCapsuleHeight, this);
+	}
+}
+
+void AVRBaseCharacter::MarkSeatInformationDirty()
+{
+	VRE_MARK_PROPERTY_DIRTY(AVRBaseCharacter, SeatInformation, this);
 }
 
 
@@ -813,6 +844,7 @@ bool AVRBaseCharacter::SetSeatedMode(USceneComponent * SeatParent, bool bSetSeat
 		SeatInformation.bSitting = false;
 	}
 
+	MarkSeatInformationDirty();
 	OnRep_SeatedCharInfo(); // Call this on server side because it won't call itself
 	NotifyOfTeleport(); // Teleport the controllers
 
@@ -1003,7 +1035,7 @@ void AVRBaseCharacter::SetCharacterSizeVR(float NewRadius, float NewHalfHeight,
 			Capsule->SetCapsuleSize(NewRadius, NewHalfHeight, bUpdateOverlaps);
 
 		if (GetNetMode() < ENetMode::NM_Client && VRReplicateCapsuleHeight)
-			ReplicatedCapsuleHeight.CapsuleHeight = Capsule->GetUnscaledCapsuleHalfHeight();
+			SetReplicatedCapsuleHeight(Capsule->GetUnscaledCapsuleHalfHeight());
 	}
 }
 
@@ -1015,7 +1047,7 @@ void AVRBaseCharacter::SetCharacterHalfHeightVR(float HalfHeight, bool bUpdateOv
 			Capsule->SetCapsuleHalfHeight(HalfHeight, bUpdateOverlaps);
 
 		if (GetNetMode() < ENetMode::NM_Client && VRReplicateCapsuleHeight)
-			ReplicatedCapsuleHeight.CapsuleHeight = Capsule->GetUnscaledCapsuleHalfHeight();
+			SetReplicatedCapsuleHeight(Capsule->GetUnscaledCapsuleHalfHeight());
 	}
 }
 
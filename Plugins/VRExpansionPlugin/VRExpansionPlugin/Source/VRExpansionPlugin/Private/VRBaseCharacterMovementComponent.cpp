@@ -19,10 +19,22 @@
 #include "Navigation/PathFollowingComponent.h"
 #include "VRPlayerController.h"
 #include "GameFramework/PhysicsVolume.h"
+#include "GameFramework/PlayerController.h"
 
 
 DEFINE_LOG_CATEGORY(LogVRBaseCharacterMovement);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Simulated Proxy Ticks Skipped"), STAT_VRSimulatedProxyTicksSkipped, STATGROUP_Character);
+
+namespace VRSimulatedProxyLODStatics
+{
+	// How often proxies re-evaluate their LOD
+	static const float EvaluateInterval = 0.25f;
+
+	// Longest step that a reduced rate proxy will simulate at once
+	static const float MaxAccumulatedTime = 0.25f;
+}
+
 UVRBaseCharacterMovementComponent::UVRBaseCharacterMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -45,6 +57,17 @@ UVRBaseCharacterMovementComponent::UVRBaseCharacterMovementComponent(const FObje
 	bHadExtremeInput = false;
 	bHoldPositionOnTrackingLossThresholdHit = false;
 
+	bCombineVRMoves = false;
+	VRMoveCombineMinDelta = 0.5f;
+	VRMoveCombineMaxDelta = 50.0f;
+	VRMoveCombineMaxYawDelta = 10.0f;
+	VRMoveCombineVelocityTolerance = 1.0f;
+
+	bDeltaEncodeVRCapsule = false;
+	VRCapsuleLocationQuantization = EVRVectorQuantization::RoundTwoDecimals;
+	VRCapsuleRotationQuantization = EVRRotationQuantization::RoundToShort;
+	NextVRMoveSequence = 0;
+
 	VRClimbingStepHeight = 96.0f;
 	VRClimbingEdgeRejectDistance = 5.0f;
 	VRClimbingStepUpMultiplier = 1.0f;
@@ -83,6 +106,16 @@ UVRBaseCharacterMovementComponent::UVRBaseCharacterMovementComponent(const FObje
 	bDisableSimulatedTickWhenSmoothingMovement = true;
 	bCapHMDMovementToMaxMovementSpeed = false;
 
+	bUseSimulatedProxyLOD = false;
+	SimulatedProxyReducedLODDistance = 2000.0f;
+	SimulatedProxyMinimalLODDistance = 5000.0f;
+	SimulatedProxyReducedLODTickRate = 30.0f;
+	SimulatedProxyMinimalLODTickRate = 10.0f;
+	bDemoteHiddenSimulatedProxies = true;
+	CurrentSimulatedProxyLOD = EVRSimulatedProxyLOD::VRSimLOD_Full;
+	SimulatedProxyLODAccumulatedTime = 0.0f;
+	SimulatedProxyLODEvaluateTime = 0.0f;
+
 	SetNetworkMoveDataContainer(VRNetworkMoveDataContainer);
 	SetMoveResponseDataContainer(VRMoveResponseDataContainer);
 }
@@ -1065,6 +1098,7 @@ bool UVRBaseCharacterMovementComponent::DoMASnapTurn(FVRMoveActionContainer& Mov
 		if (BaseVRCharacterOwner->SeatInformation.bSitting)
 		{
 			BaseVRCharacterOwner->SeatInformation.StoredTargetTransform = (OriginalRelativeTrans.Inverse() * BaseVRCharacterOwner->GetRootComponent()->GetRelativeTransform()) * BaseVRCharacterOwner->SeatInformation.StoredTargetTransform;
+			BaseVRCharacterOwner->MarkSeatInformationDirty();
 			if (BaseVRCharacterOwner->IsLocallyControlled() && GetNetMode() == ENetMode::NM_Client)
 			{
 				BaseVRCharacterOwner->Server_SeatedSnapTurn(MoveAction.MoveActionDeltaYaw);
@@ -1632,6 +1666,51 @@ void UVRBaseCharacterMovementComponent::SimulatedTick(float DeltaSeconds)
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_Character_CharacterMovementSimulated);
 	checkSlow(CharacterOwner != nullptr);
 
+	if (bUseSimulatedProxyLOD && !CharacterOwner->IsPlayingNetworkedRootMotionMontage() && !CurrentRootMotion.HasActiveRootMotionSources())
+	{
+		SimulatedProxyLODEvaluateTime -= DeltaSeconds;
+		if (SimulatedProxyLODEvaluateTime <= 0.0f)
+		{
+			CurrentSimulatedProxyLOD = CalculateSimulatedProxyLOD();
+			SimulatedProxyLODEvaluateTime = VRSimulatedProxyLODStatics::EvaluateInterval;
+		}
+
+		float LODTickRate = 0.0f;
+		switch (CurrentSimulatedProxyLOD)
+		{
+		case EVRSimulatedProxyLOD::VRSimLOD_Reduced:
+		{
+			LODTickRate = SimulatedProxyReducedLODTickRate;
+		}break;
+		case EVRSimulatedProxyLOD::VRSimLOD_Minimal:
+		{
+			LODTickRate = SimulatedProxyMinimalLODTickRate;
+		}break;
+		default:break;
+		}
+
+		if (LODTickRate > 0.0f)
+		{
+			// Bank the time and run it all at once when the interval is up
+			SimulatedProxyLODAccumulatedTime += DeltaSeconds;
+			if (SimulatedProxyLODAccumulatedTime < (1.0f / LODTickRate))
+			{
+				INC_DWORD_STAT(STAT_VRSimulatedProxyTicksSkipped);
+				return;
+			}
+
+			DeltaSeconds = FMath::Min(SimulatedProxyLODAccumulatedTime, VRSimulatedProxyLODStatics::MaxAccumulatedTime);
+		}
+
+		SimulatedProxyLODAccumulatedTime = 0.0f;
+	}
+	else
+	{
+		CurrentSimulatedProxyLOD = EVRSimulatedProxyLOD::VRSimLOD_Full;
+		SimulatedProxyLODAccumulatedTime = 0.0f;
+		SimulatedProxyLODEvaluateTime = 0.0f;
+	}
+
 	// If we are playing a RootMotion AnimMontage.
 	if (CharacterOwner->IsPlayingNetworkedRootMotionMontage())
 	{
@@ -1777,8 +1856,25 @@ void UVRBaseCharacterMovementComponent::SimulatedTick(float DeltaSeconds)
 			//const FQuat SavedCapsuleRotation = UpdatedComponent->GetComponentQuat();
 			const bool bPreventMeshMovement = !bNetworkSmoothingComplete;
 
+			if (CurrentSimulatedProxyLOD == EVRSimulatedProxyLOD::VRSimLOD_Minimal && !CharacterOwner->IsPlayingRootMotion())
+			{
+				// Interpolation only at this LOD, take on the replicated state and let smoothing carry the proxy to it
+				bNetworkUpdateReceived = false;
+
+				if (bNetworkGravityDirectionChanged)
+				{
+					SetGravityDirection(CharacterOwner->GetReplicatedGravityDirection());
+					bNetworkGravityDirectionChanged = false;
+				}
+
+				if (bNetworkMovementModeChanged)
+				{
+					ApplyNetworkMovementMode(CharacterOwner->GetReplicatedMovementMode());
+					bNetworkMovementModeChanged = false;
+				}
+			}
 			// Avoid moving the mesh during movement if SmoothClientPosition will take care of it.
-			if(NetworkSmoothingMode != ENetworkSmoothingMode::Disabled)
+			else if(NetworkSmoothingMode != ENetworkSmoothingMode::Disabled)
 			{
 				const FScopedPreventAttachedComponentMove PreventMeshMove(bPreventMeshMovement ? BaseVRCharacterOwner->NetSmoother : nullptr);
 				//const FScopedPreventAttachedComponentMove PreventMeshMovement(bPreventMeshMovement ? Mesh : nullptr);
@@ -1853,6 +1949,43 @@ void UVRBaseCharacterMovementComponent::SimulatedTick(float DeltaSeconds)
 	}
 }
 
+EVRSimulatedProxyLOD UVRBaseCharacterMovementComponent::CalculateSimulatedProxyLOD() const
+{
+	UWorld* MyWorld = GetWorld();
+	APlayerController* LocalController = MyWorld ? MyWorld->GetFirstPlayerController() : nullptr;
+
+	if (!LocalController || !UpdatedComponent || !CharacterOwner)
+	{
+		return EVRSimulatedProxyLOD::VRSimLOD_Full;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	LocalController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	const double DistSq = FVector::DistSquared(ViewLocation, UpdatedComponent->GetComponentLocation());
+
+	int32 LOD = (int32)EVRSimulatedProxyLOD::VRSimLOD_Full;
+	if (DistSq >= FMath::Square(SimulatedProxyMinimalLODDistance))
+	{
+		LOD = (int32)EVRSimulatedProxyLOD::VRSimLOD_Minimal;
+	}
+	else if (DistSq >= FMath::Square(SimulatedProxyReducedLODDistance))
+	{
+		LOD = (int32)EVRSimulatedProxyLOD::VRSimLOD_Reduced;
+	}
+
+	if (bDemoteHiddenSimulatedProxies && !CharacterOwner->WasRecentlyRendered(VRSimulatedProxyLODStatics::EvaluateInterval))
+	{
+		++LOD;
+	}
+
+	// Proxies on moving bases need based movement to follow them
+	const int32 MaxLOD = MovementBaseUtility::IsDynamicBase(GetMovementBase()) ? (int32)EVRSimulatedProxyLOD::VRSimLOD_Reduced : (int32)EVRSimulatedProxyLOD::VRSimLOD_Minimal;
+
+	return (EVRSimulatedProxyLOD)FMath::Min(LOD, MaxLOD);
+}
+
 void UVRBaseCharacterMovementComponent::MoveAutonomous(
 	float ClientTimeStamp,
 	float DeltaTime,
@@ -2219,6 +2352,27 @@ void UVRBaseCharacterMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
 	Super::UpdateFromCompressedFlags(Flags);
 }
 
+void UVRBaseCharacterMovementComponent::RecordVRCapsuleRepBaseline(uint8 MoveId, const FVRCapsuleRepState& State)
+{
+	if (VRCapsuleRepBaselines.Num() != VRMoveRepUtils::MoveIdCount)
+	{
+		VRCapsuleRepBaselines.SetNum(VRMoveRepUtils::MoveIdCount);
+	}
+
+	VRCapsuleRepBaselines[MoveId] = State;
+}
+
+bool UVRBaseCharacterMovementComponent::GetVRCapsuleRepBaseline(uint8 MoveId, FVRCapsuleRepState& OutState) const
+{
+	if (VRCapsuleRepBaselines.IsValidIndex(MoveId) && VRCapsuleRepBaselines[MoveId].bIsValid)
+	{
+		OutState = VRCapsuleRepBaselines[MoveId];
+		return true;
+	}
+
+	return false;
+}
+
 FVector UVRBaseCharacterMovementComponent::RoundDirectMovement(FVector InMovement) const
 {
 	// Match FVector_NetQuantize100 (2 decimal place of precision).
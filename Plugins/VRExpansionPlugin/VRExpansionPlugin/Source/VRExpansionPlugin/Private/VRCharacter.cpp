@@ -212,7 +212,7 @@ void AVRCharacter::SetCharacterSizeVR(float NewRadius, float NewHalfHeight, bool
 		VRRootReference->SetCapsuleSizeVR(NewRadius, NewHalfHeight, bUpdateOverlaps);
 
 		if (GetNetMode() < ENetMode::NM_Client)
-			ReplicatedCapsuleHeight.CapsuleHeight = VRRootReference->GetUnscaledCapsuleHalfHeight();
+			SetReplicatedCapsuleHeight(VRRootReference->GetUnscaledCapsuleHalfHeight());
 	}
 	else
 	{
@@ -227,7 +227,7 @@ void AVRCharacter::SetCharacterHalfHeightVR(float HalfHeight, bool bUpdateOverla
 		VRRootReference->SetCapsuleHalfHeightVR(HalfHeight, bUpdateOverlaps);
 
 		if (GetNetMode() < ENetMode::NM_Client)
-			ReplicatedCapsuleHeight.CapsuleHeight = VRRootReference->GetUnscaledCapsuleHalfHeight();
+			SetReplicatedCapsuleHeight(VRRootReference->GetUnscaledCapsuleHalfHeight());
 	}
 	else
 	{
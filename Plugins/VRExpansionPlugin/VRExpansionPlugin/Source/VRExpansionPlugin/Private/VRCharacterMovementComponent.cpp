@@ -1421,6 +1421,8 @@ UVRCharacterMovementComponent::UVRCharacterMovementComponent(const FObjectInitia
 	bAllowMovementMerging = true;
 	bRunClientCorrectionToHMD = false;
 	bRequestedMoveUseAcceleration = false;
+	bUseRoomscaleFloorCache = false;
+	RoomscaleFloorCacheTolerance = 2.0f;
 }
 
 void UVRCharacterMovementComponent::OnRegister()
@@ -2393,6 +2395,9 @@ void UVRCharacterMovementComponent::FindFloor(const FVector& CapsuleLocation, FF
 	// For reverting
 	FFindFloorResult LastFloor = CurrentFloor;
 
+	// Only fresh sweeps without a supplied downward hit are stored in the roomscale cache
+	bool bCanCacheFloor = false;
+
 	// Sweep floor
 	if (FloorLineTraceDist > 0.f || FloorSweepTraceDist > 0.f)
 	{
@@ -2400,8 +2405,19 @@ void UVRCharacterMovementComponent::FindFloor(const FVector& CapsuleLocation, FF
 
 		if (bAlwaysCheckFloor || !bCanUseCachedLocation || bForceNextFloorCheck || bJustTeleported)
 		{
+			const bool bCanUseRoomscaleCache = bUseRoomscaleFloorCache && !bAlwaysCheckFloor && !bForceNextFloorCheck && !bJustTeleported && !DownwardSweepResult;
 			MutableThis->bForceNextFloorCheck = false;
-			ComputeFloorDist(UseCapsuleLocation, FloorLineTraceDist, FloorSweepTraceDist, OutFloorResult, CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius(), DownwardSweepResult);
+
+			if (bCanUseRoomscaleCache && GetCachedRoomscaleFloor(UseCapsuleLocation, OutFloorResult))
+			{
+				// Was already validated when it was cached
+				bNeedToValidateFloor = false;
+			}
+			else
+			{
+				ComputeFloorDist(UseCapsuleLocation, FloorLineTraceDist, FloorSweepTraceDist, OutFloorResult, CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius(), DownwardSweepResult);
+				bCanCacheFloor = bUseRoomscaleFloorCache && !DownwardSweepResult;
+			}
 		}
 		else
 		{
@@ -2491,6 +2507,71 @@ void UVRCharacterMovementComponent::FindFloor(const FVector& CapsuleLocation, FF
 			}
 		}
 	}
+
+	if (bCanCacheFloor)
+	{
+		CacheRoomscaleFloor(UseCapsuleLocation, OutFloorResult);
+	}
+}
+
+bool UVRCharacterMovementComponent::GetCachedRoomscaleFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult) const
+{
+	if (!RoomscaleFloorCache.bIsValid || !IsMovingOnGround())
+		return false;
+
+	UPrimitiveComponent* FloorComponent = RoomscaleFloorCache.FloorComponent.Get();
+	if (!FloorComponent || FloorComponent != CharacterOwner->GetMovementBase())
+	{
+		RoomscaleFloorCache.bIsValid = false;
+		return false;
+	}
+
+	const UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
+	const FVector CapsuleDelta = CapsuleLocation - RoomscaleFloorCache.CapsuleLocation;
+
+	if (CapsuleDelta.SizeSquared() > FMath::Square(RoomscaleFloorCacheTolerance) ||
+		!FMath::IsNearlyEqual(Capsule->GetScaledCapsuleRadius(), RoomscaleFloorCache.CapsuleRadius) ||
+		!FMath::IsNearlyEqual(Capsule->GetScaledCapsuleHalfHeight(), RoomscaleFloorCache.CapsuleHalfHeight) ||
+		!GetGravityDirection().Equals(RoomscaleFloorCache.GravityDirection) ||
+		!FloorComponent->GetComponentTransform().Equals(RoomscaleFloorCache.FloorTransform))
+	{
+		return false;
+	}
+
+	// The floor hasn't moved, so only our own height above it changed
+	const float HeightDelta = RotateWorldToGravity(CapsuleDelta).Z;
+	OutFloorResult = RoomscaleFloorCache.FloorResult;
+	OutFloorResult.FloorDist += HeightDelta;
+
+	if (OutFloorResult.bLineTrace)
+	{
+		OutFloorResult.LineDist += HeightDelta;
+	}
+
+	return true;
+}
+
+void UVRCharacterMovementComponent::CacheRoomscaleFloor(const FVector& CapsuleLocation, const FFindFloorResult& FloorResult) const
+{
+	UPrimitiveComponent* FloorComponent = FloorResult.HitResult.Component.Get();
+
+	// Dynamic bases move under us so their results can't be reused
+	if (!FloorResult.IsWalkableFloor() || !FloorComponent || MovementBaseUtility::IsDynamicBase(FloorComponent))
+	{
+		RoomscaleFloorCache.bIsValid = false;
+		return;
+	}
+
+	const UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
+
+	RoomscaleFloorCache.FloorResult = FloorResult;
+	RoomscaleFloorCache.FloorComponent = FloorComponent;
+	RoomscaleFloorCache.FloorTransform = FloorComponent->GetComponentTransform();
+	RoomscaleFloorCache.CapsuleLocation = CapsuleLocation;
+	RoomscaleFloorCache.GravityDirection = GetGravityDirection();
+	RoomscaleFloorCache.CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+	RoomscaleFloorCache.CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	RoomscaleFloorCache.bIsValid = true;
 }
 
 float UVRCharacterMovementComponent::ImmersionDepth() const
@@ -3673,8 +3754,8 @@ void UVRCharacterMovementComponent::SimulateMovement(float DeltaSeconds)
 				MoveSmooth(Velocity, DeltaSeconds, &StepDownResult);
 			}
 
-			// find floor and check if falling
-			if (IsMovingOnGround() || MovementMode == MOVE_Falling)
+			// find floor and check if falling, lower LOD proxies keep their last floor and rely on the replicated movement mode
+			if ((IsMovingOnGround() || MovementMode == MOVE_Falling) && !ShouldSkipSimulatedFloorChecks())
 			{
 				bool bShouldFindFloor = Velocity.Z <= 0.f;
 				if (HasCustomGravity())
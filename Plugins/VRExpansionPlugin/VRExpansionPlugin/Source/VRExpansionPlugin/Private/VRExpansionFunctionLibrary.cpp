@@ -13,6 +13,15 @@
 #include "Components/SplineMeshComponent.h"
 #include "Components/PrimitiveComponent.h"
 #include "GripMotionControllerComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Animation/Skeleton.h"
+#include "UObject/ObjectKey.h"
+#include "Misc/VRAssetCacheHelpers.h"
 //#include "IMotionController.h"
 //#include "HeadMountedDisplayFunctionLibrary.h"
 #include "Grippables/GrippablePhysicsReplication.h"
@@ -33,6 +42,216 @@
 //General Log
 DEFINE_LOG_CATEGORY(VRExpansionFunctionLibraryLog);
 
+namespace VRGripSlotIndex
+{
+	// Entries of destroyed components are swept out once the index gets this large
+	static const int32 MaxIndexedComponents = 1024;
+
+	struct FHandSocketStamp
+	{
+		TWeakObjectPtr<UHandSocketComponent> HandSocket;
+		FName AttachSocketName;
+		FName SlotPrefix;
+	};
+
+	// Everything on a component that matches a single slot type
+	struct FSlotList
+	{
+		TArray<FName> SocketNames;
+
+		// Component space locations of the sockets, only filled in when they can't move
+		TArray<FVector> SocketLocations;
+
+		// Can be disabled at runtime so that is checked per query
+		TArray<TWeakObjectPtr<UHandSocketComponent>> HandSockets;
+	};
+
+	struct FComponentIndex
+	{
+		// What the index was built from, if any of it changes the index is rebuilt
+		TObjectKey<UObject> SourceAsset;
+		TArray<const USceneComponent*> AttachChildren;
+		TArray<FHandSocketStamp> HandSockets;
+
+		// Static mesh sockets are fixed to the component, skeletal ones are only fixed by name
+		bool bIndexSockets = false;
+		bool bStaticSockets = false;
+
+		TMap<FName, FSlotList> Slots;
+	};
+
+	struct FIndexState
+	{
+		TMap<TObjectKey<USceneComponent>, FComponentIndex> Components;
+	};
+
+	static void ClearIndexState(FIndexState& State)
+	{
+		State.Components.Reset();
+	}
+
+	// Socket edits in the mesh editors don't touch the components using the mesh
+	static bool AffectsIndex(const UObject* Object)
+	{
+		return Object && (Object->IsA<UStaticMesh>() || Object->IsA<UStaticMeshSocket>() || Object->IsA<USkeletalMesh>() || Object->IsA<USkeletalMeshSocket>() || Object->IsA<USkeleton>());
+	}
+
+	static TVRAssetDerivedCache<FIndexState> SlotIndex(
+		TEXT("vre.GripSlots.UseSlotIndex"),
+		TEXT("When on, the sockets and hand sockets matching each slot type are indexed per component instead of being searched by name on every slot query.\n")
+		TEXT("0: Disable, 1: Enable"),
+		&AffectsIndex,
+		&ClearIndexState);
+
+	static const UObject* GetSourceAsset(const USceneComponent* Component, bool& bIndexSockets, bool& bStaticSockets)
+	{
+		// Spline meshes bend their sockets along the spline, so they are searched every query like unknown providers
+		if (Component->IsA<USplineMeshComponent>())
+		{
+			bIndexSockets = false;
+			bStaticSockets = false;
+			return nullptr;
+		}
+		else if (const UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component))
+		{
+			bIndexSockets = true;
+			bStaticSockets = true;
+			return StaticMeshComp->GetStaticMesh();
+		}
+		else if (const USkinnedMeshComponent* SkinnedComp = Cast<USkinnedMeshComponent>(Component))
+		{
+			bIndexSockets = true;
+			bStaticSockets = false;
+			return SkinnedComp->GetSkinnedAsset();
+		}
+
+		// Unknown socket providers are still searched every query
+		bIndexSockets = false;
+		bStaticSockets = false;
+		return nullptr;
+	}
+
+	static void GatherMatchingSockets(const USceneComponent* Component, const FString& GripIdentifier, bool bStoreLocations, FSlotList& OutSlots)
+	{
+		for (const FName& SocketName : Component->GetAllSocketNames())
+		{
+			if (SocketName.ToString().Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+			{
+				OutSlots.SocketNames.Add(SocketName);
+
+				if (bStoreLocations)
+					OutSlots.SocketLocations.Add(Component->GetSocketTransform(SocketName, ERelativeTransformSpace::RTS_Component).GetLocation());
+			}
+		}
+	}
+
+	static void BuildComponentIndex(const USceneComponent* Component, FComponentIndex& Index)
+	{
+		Index = FComponentIndex();
+		Index.SourceAsset = GetSourceAsset(Component, Index.bIndexSockets, Index.bStaticSockets);
+
+		for (USceneComponent* AttachChild : Component->GetAttachChildren())
+		{
+			Index.AttachChildren.Add(AttachChild);
+
+			// Disabled ones are kept, they can be enabled again without anything else changing
+			if (UHandSocketComponent* SocketComp = Cast<UHandSocketComponent>(AttachChild))
+			{
+				Index.HandSockets.Add({ SocketComp, SocketComp->GetAttachSocketName(), SocketComp->SlotPrefix });
+			}
+		}
+	}
+
+	static bool IsIndexValid(const USceneComponent* Component, const FComponentIndex& Index)
+	{
+		bool bIndexSockets = false;
+		bool bStaticSockets = false;
+		if (Index.SourceAsset != TObjectKey<UObject>(GetSourceAsset(Component, bIndexSockets, bStaticSockets)))
+			return false;
+
+		const TArray<TObjectPtr<USceneComponent>>& AttachChildren = Component->GetAttachChildren();
+		if (AttachChildren.Num() != Index.AttachChildren.Num())
+			return false;
+
+		for (int32 i = 0; i < AttachChildren.Num(); ++i)
+		{
+			if (AttachChildren[i].Get() != Index.AttachChildren[i])
+				return false;
+		}
+
+		for (const FHandSocketStamp& Stamp : Index.HandSockets)
+		{
+			const UHandSocketComponent* SocketComp = Stamp.HandSocket.Get();
+			if (!SocketComp || SocketComp->GetAttachSocketName() != Stamp.AttachSocketName || SocketComp->SlotPrefix != Stamp.SlotPrefix)
+				return false;
+		}
+
+		return true;
+	}
+
+	// Returns the index of the component, or builds it into TempIndex if indexing is off or this isn't the game thread
+	static FComponentIndex& GetComponentIndex(const USceneComponent* Component, FComponentIndex& TempIndex)
+	{
+		if (!SlotIndex.IsEnabled() || !IsInGameThread())
+		{
+			BuildComponentIndex(Component, TempIndex);
+			return TempIndex;
+		}
+
+		FIndexState& State = SlotIndex.GetState();
+
+		if (FComponentIndex* Existing = State.Components.Find(Component))
+		{
+			if (!IsIndexValid(Component, *Existing))
+				BuildComponentIndex(Component, *Existing);
+
+			return *Existing;
+		}
+
+		if (State.Components.Num() >= MaxIndexedComponents)
+		{
+			for (auto It = State.Components.CreateIterator(); It; ++It)
+			{
+				if (!It.Key().ResolveObjectPtr())
+					It.RemoveCurrent();
+			}
+
+			if (State.Components.Num() >= MaxIndexedComponents)
+				State.Components.Reset();
+		}
+
+		FComponentIndex& NewIndex = State.Components.Add(Component);
+		BuildComponentIndex(Component, NewIndex);
+		return NewIndex;
+	}
+
+	static const FSlotList& GetSlotList(const USceneComponent* Component, FComponentIndex& Index, FName SlotType)
+	{
+		if (const FSlotList* Existing = Index.Slots.Find(SlotType))
+			return *Existing;
+
+		FSlotList& Slots = Index.Slots.Add(SlotType);
+		const FString GripIdentifier = SlotType.ToString();
+
+		if (Index.bIndexSockets)
+		{
+			GatherMatchingSockets(Component, GripIdentifier, Index.bStaticSockets, Slots);
+		}
+
+		for (const FHandSocketStamp& Stamp : Index.HandSockets)
+		{
+			FString SlotPrefix = Stamp.AttachSocketName != NAME_None ? Stamp.AttachSocketName.ToString() + Stamp.SlotPrefix.ToString() : Stamp.SlotPrefix.ToString();
+
+			if (SlotPrefix.Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+			{
+				Slots.HandSockets.Add(Stamp.HandSocket);
+			}
+		}
+
+		return Slots;
+	}
+}
+
 UGameViewportClient* UVRExpansionFunctionLibrary::GetGameViewportClient(UObject* WorldContextObject)
 {
 	if (WorldContextObject)
@@ -205,77 +424,74 @@ void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName_Component(FName S
 
 	float ClosestSlotDistance = -0.1f;
 
-	TArray<FName> SocketNames = Component->GetAllSocketNames();
+	// The matching names are found once per component and slot type, queries after that are just distance checks
+	VRGripSlotIndex::FComponentIndex TempIndex;
+	VRGripSlotIndex::FComponentIndex& SlotIndex = VRGripSlotIndex::GetComponentIndex(Component, TempIndex);
+	const VRGripSlotIndex::FSlotList& Slots = VRGripSlotIndex::GetSlotList(Component, SlotIndex, SlotType);
 
-	FString GripIdentifier = SlotType.ToString();
+	const TArray<FName>* SocketNames = &Slots.SocketNames;
+	VRGripSlotIndex::FSlotList UnindexedSockets;
+	if (!SlotIndex.bIndexSockets)
+	{
+		VRGripSlotIndex::GatherMatchingSockets(Component, SlotType.ToString(), false, UnindexedSockets);
+		SocketNames = &UnindexedSockets.SocketNames;
+	}
 
-	int foundIndex = 0;
+	int32 FoundIndex = INDEX_NONE;
 
-	for (int i = 0; i < SocketNames.Num(); ++i)
+	for (int32 i = 0; i < SocketNames->Num(); ++i)
 	{
-		if (SocketNames[i].ToString().Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+		// Locations are only stored for indexed static sockets
+		const FVector SocketLocation = Slots.SocketLocations.IsValidIndex(i) ? Slots.SocketLocations[i] :
+			Component->GetSocketTransform((*SocketNames)[i], ERelativeTransformSpace::RTS_Component).GetLocation();
+
+		float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketLocation);
+
+		if (MaxRange >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
 		{
-			float vecLen = FVector::DistSquared(RelativeWorldLocation, Component->GetSocketTransform(SocketNames[i], ERelativeTransformSpace::RTS_Component).GetLocation());
+			ClosestSlotDistance = vecLen;
+			bHadSlotInRange = true;
+			FoundIndex = i;
+		}
+	}
 
-			if (MaxRange >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
+	TArray<UHandSocketComponent*> RotationallyMatchingHandSockets;
+	for (const TWeakObjectPtr<UHandSocketComponent>& HandSocket : Slots.HandSockets)
+	{
+		UHandSocketComponent* SocketComp = HandSocket.Get();
+		if (!SocketComp || SocketComp->bDisabled)
+			continue;
+
+		FVector SocketRelativeLocation = Component->GetComponentTransform().InverseTransformPosition(SocketComp->GetHandSocketTransform(QueryController, true).GetLocation());
+		float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketRelativeLocation);
+		//float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketComp->GetRelativeLocation());
+		if (SocketComp->bAlwaysInRange)
+		{
+			if (SocketComp->bMatchRotation)
+			{
+				RotationallyMatchingHandSockets.Add(SocketComp);
+			}
+			else
 			{
+				TargetHandSocket = SocketComp;
 				ClosestSlotDistance = vecLen;
 				bHadSlotInRange = true;
-				foundIndex = i;
 			}
 		}
-	}
-
-	TArray<USceneComponent*> AttachChildren = Component->GetAttachChildren();
-
-	TArray<UHandSocketComponent*> RotationallyMatchingHandSockets;
-	for (USceneComponent* AttachChild : AttachChildren)
-	{
-		if (AttachChild && AttachChild->IsA<UHandSocketComponent>())
+		else
 		{
-			if (UHandSocketComponent* SocketComp = Cast<UHandSocketComponent>(AttachChild))
+			float RangeVal = (SocketComp->OverrideDistance > 0.0f ? FMath::Square(SocketComp->OverrideDistance) : MaxRange);
+			if (RangeVal >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
 			{
-				if (SocketComp->bDisabled)
-					continue;
-
-				FName BoneName = SocketComp->GetAttachSocketName();
-				FString SlotPrefix = BoneName != NAME_None ? BoneName.ToString() + SocketComp->SlotPrefix.ToString() : SocketComp->SlotPrefix.ToString();
-
-				if (SlotPrefix.Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+				if (SocketComp->bMatchRotation)
 				{
-					FVector SocketRelativeLocation = Component->GetComponentTransform().InverseTransformPosition(SocketComp->GetHandSocketTransform(QueryController, true).GetLocation());
-					float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketRelativeLocation);
-					//float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketComp->GetRelativeLocation());
-					if (SocketComp->bAlwaysInRange)
-					{
-						if (SocketComp->bMatchRotation)
-						{
-							RotationallyMatchingHandSockets.Add(SocketComp);
-						}
-						else
-						{
-							TargetHandSocket = SocketComp;
-							ClosestSlotDistance = vecLen;
-							bHadSlotInRange = true;
-						}
-					}
-					else
-					{
-						float RangeVal = (SocketComp->OverrideDistance > 0.0f ? FMath::Square(SocketComp->OverrideDistance) : MaxRange);
-						if (RangeVal >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
-						{
-							if (SocketComp->bMatchRotation)
-							{
-								RotationallyMatchingHandSockets.Add(SocketComp);
-							}
-							else
-							{
-								TargetHandSocket = SocketComp;
-								ClosestSlotDistance = vecLen;
-								bHadSlotInRange = true;
-							}
-						}
-					}
+					RotationallyMatchingHandSockets.Add(SocketComp);
+				}
+				else
+				{
+					TargetHandSocket = SocketComp;
+					ClosestSlotDistance = vecLen;
+					bHadSlotInRange = true;
 				}
 			}
 		}
@@ -311,10 +527,10 @@ void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName_Component(FName S
 			SlotName = TargetHandSocket->GetFName();
 			SlotWorldTransform.SetScale3D(FVector(1.0f));
 		}
-		else
+		else if (FoundIndex != INDEX_NONE)
 		{
-			SlotWorldTransform = Component->GetSocketTransform(SocketNames[foundIndex]);
-			SlotName = SocketNames[foundIndex];
+			SlotWorldTransform = Component->GetSocketTransform((*SocketNames)[FoundIndex]);
+			SlotName = (*SocketNames)[FoundIndex];
 			SlotWorldTransform.SetScale3D(FVector(1.0f));
 		}
 	}
@@ -23,6 +23,8 @@ DEFINE_LOG_CATEGORY(LogVRRootComponent);
 DECLARE_CYCLE_STAT(TEXT("VRRootMovement"), STAT_VRRootMovement, STATGROUP_VRRootComponent);
 DECLARE_CYCLE_STAT(TEXT("PerformOverlapQueryVR Time"), STAT_PerformOverlapQueryVR, STATGROUP_VRRootComponent);
 DECLARE_CYCLE_STAT(TEXT("UpdateOverlapsVRRoot Time"), STAT_UpdateOverlapsVRRoot, STATGROUP_VRRootComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Root Overlap Updates Skipped"), STAT_VRRootOverlapUpdatesSkipped, STATGROUP_VRRootComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Root Overlap Updates From Cache"), STAT_VRRootOverlapUpdatesFromCache, STATGROUP_VRRootComponent);
 
 typedef TArray<const FOverlapInfo*, TInlineAllocator<8>> TInlineOverlapPointerArray;
 
@@ -302,6 +304,10 @@ UVRRootComponent::UVRRootComponent(const FObjectInitializer& ObjectInitializer)
 	bUseWalkingCollisionOverride = false;
 	WalkingCollisionOverride = ECollisionChannel::ECC_Pawn;
 
+	bUseOverlapCache = false;
+	OverlapCachePadding = 5.0f;
+	OverlapCacheMovementThreshold = 0.5f;
+
 	bCalledUpdateTransform = false;
 
 	CanCharacterStepUpOn = ECB_No;
@@ -1309,6 +1315,12 @@ bool UVRRootComponent::UpdateOverlapsImpl(const TOverlapArrayView* NewPendingOve
 						GetPointersToArrayData(NewOverlappingComponentPtrs, *OverlapsAtEndLocationPtr);
 					}
 				}
+				else if (bUseOverlapCache && !(NewPendingOverlaps && NewPendingOverlaps->Num() > 0) &&
+					GetOverlapsFromCacheVR(OverlapMultiResult, OffsetComponentToWorld.GetTranslation(), GetComponentQuat(), bIgnoreChildren))
+				{
+					UE_LOG(LogVRRootComponent, VeryVerbose, TEXT("%s->%s Using cached overlap candidates!"), *GetNameSafe(GetOwner()), *GetName());
+					GetPointersToArrayData(NewOverlappingComponentPtrs, OverlapMultiResult);
+				}
 				else
 				{
 					SCOPE_CYCLE_COUNTER(STAT_PerformOverlapQueryVR);
@@ -1322,7 +1334,26 @@ bool UVRRootComponent::UpdateOverlapsImpl(const TOverlapArrayView* NewPendingOve
 					Params.bIgnoreBlocks = true;	//We don't care about blockers since we only route overlap events to real overlaps
 					FCollisionResponseParams ResponseParam;
 					InitSweepCollisionParams(Params, ResponseParam);
-					ComponentOverlapMulti(Overlaps, MyWorld, OffsetComponentToWorld.GetTranslation(), GetComponentQuat(), GetCollisionObjectType(), Params);
+
+					bool bCacheOverlapQuery = bUseOverlapCache;
+					if (bCacheOverlapQuery)
+					{
+						// Query the padded capsule, the results are the candidates for every update until we leave the padding
+						MyWorld->OverlapMultiByChannel(Overlaps, OffsetComponentToWorld.GetTranslation(), GetComponentQuat(), GetCollisionObjectType(), GetCollisionShape(OverlapCachePadding), Params, ResponseParam);
+
+						// Per instance results can't be re-tested against the component alone, fall back to the exact query for this update
+						if (Overlaps.ContainsByPredicate([](const FOverlapResult& Result) { return Result.ItemIndex != INDEX_NONE; }))
+						{
+							bCacheOverlapQuery = false;
+							Overlaps.Reset();
+						}
+					}
+
+					if (!bCacheOverlapQuery)
+					{
+						OverlapCache.bIsValid = false;
+						ComponentOverlapMulti(Overlaps, MyWorld, OffsetComponentToWorld.GetTranslation(), GetComponentQuat(), GetCollisionObjectType(), Params);
+					}
 
 					for (int32 ResultIdx = 0; ResultIdx < Overlaps.Num(); ResultIdx++)
 					{
@@ -1339,6 +1370,12 @@ bool UVRRootComponent::UpdateOverlapsImpl(const TOverlapArrayView* NewPendingOve
 						}
 					}
 
+					if (bCacheOverlapQuery)
+					{
+						// Reduces the candidates down to the actual overlaps
+						StoreOverlapCacheVR(OverlapMultiResult, OffsetComponentToWorld.GetTranslation(), GetComponentQuat());
+					}
+
 					// Fill pointers to overlap results. We ensure below that OverlapMultiResult stays in scope so these pointers remain valid.
 					GetPointersToArrayData(NewOverlappingComponentPtrs, OverlapMultiResult);
 				}
@@ -1506,7 +1543,7 @@ bool UVRRootComponent::IsLocallyControlled() const
 		{
 			if (owningVRChar->VRReplicateCapsuleHeight)
 			{
-				owningVRChar->ReplicatedCapsuleHeight.CapsuleHeight = CapsuleHalfHeight;
+				owningVRChar->SetReplicatedCapsuleHeight(CapsuleHalfHeight);
 			}
 		}
 
@@ -1700,6 +1737,109 @@ bool UVRRootComponent::ConvertRotationOverlapsToCurrentOverlapsVR(TArray<FOverla
 	return bResult;
 }
 
+template<typename AllocatorType>
+bool UVRRootComponent::GetOverlapsFromCacheVR(TArray<FOverlapInfo, AllocatorType>& OutOverlaps, const FVector& Location, const FQuat& Rotation, bool bIgnoreChildren)
+{
+	if (!OverlapCache.bIsValid)
+		return false;
+
+	// Anything that changes the shape or its filtering needs a new query
+	if (OverlapCache.ObjectType != GetCollisionObjectType() ||
+		OverlapCache.Padding != OverlapCachePadding ||
+		!FMath::IsNearlyEqual(OverlapCache.CapsuleRadius, GetScaledCapsuleRadius()) ||
+		!FMath::IsNearlyEqual(OverlapCache.CapsuleHalfHeight, GetScaledCapsuleHalfHeight()) ||
+		!OverlapCache.QueryRotation.Equals(Rotation, KINDA_SMALL_NUMBER))
+	{
+		OverlapCache.bIsValid = false;
+		return false;
+	}
+
+	// Left the padded volume, there may be things out there that we never gathered
+	if (FVector::DistSquared(Location, OverlapCache.QueryLocation) >= FMath::Square(OverlapCachePadding))
+	{
+		OverlapCache.bIsValid = false;
+		return false;
+	}
+
+	const AActor* MyActor = GetOwner();
+
+	// Other components moving into us add themselves to our overlaps, if one isn't a candidate then the cache is stale.
+	// If they are all in our last result then nothing has begun or ended an overlap with us since we last updated.
+	bool bMatchesLastOverlaps = true;
+	int32 NumExternalOverlaps = 0;
+	for (const FOverlapInfo& CurrentOverlap : OverlappingComponents)
+	{
+		if (bIgnoreChildren && MyActor && CurrentOverlap.OverlapInfo.GetActor() == MyActor)
+			continue;
+
+		if (!OverlapCache.Candidates.Contains(CurrentOverlap))
+		{
+			OverlapCache.bIsValid = false;
+			return false;
+		}
+
+		++NumExternalOverlaps;
+		bMatchesLastOverlaps &= OverlapCache.LastOverlaps.Contains(CurrentOverlap);
+	}
+
+	bMatchesLastOverlaps &= NumExternalOverlaps == OverlapCache.LastOverlaps.Num();
+
+	if (bMatchesLastOverlaps && FVector::DistSquared(Location, OverlapCache.LastExactLocation) < FMath::Square(OverlapCacheMovementThreshold))
+	{
+		// Sub threshold HMD movement, keep the last result as is
+		INC_DWORD_STAT(STAT_VRRootOverlapUpdatesSkipped);
+		OutOverlaps.Append(OverlapCache.LastOverlaps);
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_VRRootOverlapUpdatesFromCache);
+
+	const FCollisionShape ExactShape = GetCollisionShape();
+	OverlapCache.LastOverlaps.Reset();
+	for (const FOverlapInfo& Candidate : OverlapCache.Candidates)
+	{
+		UPrimitiveComponent* const HitComp = Candidate.OverlapInfo.Component.Get();
+		if (HitComp && HitComp->GetGenerateOverlapEvents() && HitComp->OverlapComponent(Location, Rotation, ExactShape))
+		{
+			OverlapCache.LastOverlaps.Add(Candidate);
+		}
+	}
+
+	OverlapCache.LastExactLocation = Location;
+	OutOverlaps.Append(OverlapCache.LastOverlaps);
+	return true;
+}
+
+template<typename AllocatorType>
+void UVRRootComponent::StoreOverlapCacheVR(TArray<FOverlapInfo, AllocatorType>& InOutOverlaps, const FVector& Location, const FQuat& Rotation)
+{
+	OverlapCache.bIsValid = true;
+	OverlapCache.Candidates.Reset();
+	OverlapCache.LastOverlaps.Reset();
+
+	const FCollisionShape ExactShape = GetCollisionShape();
+	for (int32 Idx = InOutOverlaps.Num() - 1; Idx >= 0; --Idx)
+	{
+		const FOverlapInfo& Candidate = InOutOverlaps[Idx];
+		OverlapCache.Candidates.Add(Candidate);
+
+		UPrimitiveComponent* const HitComp = Candidate.OverlapInfo.Component.Get();
+		if (!HitComp || !HitComp->OverlapComponent(Location, Rotation, ExactShape))
+		{
+			InOutOverlaps.RemoveAtSwap(Idx, 1, false);
+		}
+	}
+
+	OverlapCache.LastOverlaps.Append(InOutOverlaps);
+	OverlapCache.QueryLocation = Location;
+	OverlapCache.QueryRotation = Rotation;
+	OverlapCache.LastExactLocation = Location;
+	OverlapCache.CapsuleRadius = GetScaledCapsuleRadius();
+	OverlapCache.CapsuleHalfHeight = GetScaledCapsuleHalfHeight();
+	OverlapCache.Padding = OverlapCachePadding;
+	OverlapCache.ObjectType = GetCollisionObjectType();
+}
+
 template<typename AllocatorType>
 bool UVRRootComponent::GetOverlapsWithActor_TemplateVR(const AActor* Actor, TArray<FOverlapInfo, AllocatorType>& OutOverlaps) const
 {
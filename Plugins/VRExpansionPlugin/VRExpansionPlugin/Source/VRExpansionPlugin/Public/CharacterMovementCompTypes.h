@@ -424,6 +424,158 @@ struct TStructOpsTypeTraits< FVRMoveActionArray > : public TStructOpsTypeTraitsB
 };
 
 
+// Quantized VR capsule state of a move, location is in hundredths of a unit and yaw is a compressed short
+struct FVRCapsuleRepState
+{
+	FIntVector Location;
+	uint16 Yaw;
+	bool bIsValid;
+
+	FVRCapsuleRepState() :
+		Location(FIntVector::ZeroValue),
+		Yaw(0),
+		bIsValid(false)
+	{}
+};
+
+namespace VRMoveRepUtils
+{
+	// Moves carry an 8 bit id and the server keeps a capsule baseline per id.
+	// Saved moves are capped far below this so an id is never reused while its move can still be referenced.
+	constexpr int32 MoveIdBits = 8;
+	constexpr int32 MoveIdCount = 1 << MoveIdBits;
+	constexpr uint32 MoveIdMask = MoveIdCount - 1;
+
+	// Oldest acknowledged move (in move ids) that can be used as a delta baseline, older ones fall back to absolute
+	constexpr uint32 MaxBaselineAge = 127;
+
+	// Locations are clamped to +-2^28 hundredths (well past WORLD_MAX) so that a delta between two of them is at most +-2^29,
+	// which zigzag encodes to 31 bits, the most that the 5 bit length in SerializeSteppedIntVector can describe
+	constexpr int64 MaxQuantizedLocation = 1 << 28;
+
+	FORCEINLINE uint32 ZigZagEncode(int32 Value)
+	{
+		return ((uint32)Value << 1) ^ (uint32)(Value >> 31);
+	}
+
+	FORCEINLINE int32 ZigZagDecode(uint32 Value)
+	{
+		return (int32)(Value >> 1) ^ -(int32)(Value & 1);
+	}
+
+	inline FVRCapsuleRepState QuantizeCapsuleState(const FVector& Location, double Yaw, EVRVectorQuantization LocationQuantization, EVRRotationQuantization RotationQuantization)
+	{
+		// Both levels are stored in hundredths so that they share the same baseline grid
+		const int64 Step = LocationQuantization == EVRVectorQuantization::RoundOneDecimal ? 10 : 1;
+		auto QuantizeComponent = [Step](double Value) -> int32
+		{
+			return (int32)FMath::Clamp<int64>(FMath::RoundToInt64(Value * (100.0 / Step)) * Step, -MaxQuantizedLocation, MaxQuantizedLocation);
+		};
+
+		FVRCapsuleRepState State;
+		State.Location = FIntVector(QuantizeComponent(Location.X), QuantizeComponent(Location.Y), QuantizeComponent(Location.Z));
+		State.Yaw = FRotator::CompressAxisToShort(Yaw);
+
+		if (RotationQuantization == EVRRotationQuantization::RoundTo10Bits)
+		{
+			// 10 bit values live in the top of the short so they stay on the same grid
+			State.Yaw = (uint16)((State.Yaw + 32) & 0xFFC0);
+		}
+
+		State.bIsValid = true;
+		return State;
+	}
+
+	// Writes the components as zigzag values behind a shared 5 bit length.
+	// Uses CoarseStep units when every component is a multiple of it, so the coarse level never loses precision.
+	inline void SerializeSteppedIntVector(FIntVector& Value, FArchive& Ar, int32 CoarseStep)
+	{
+		const bool bIsSaving = Ar.IsSaving();
+
+		bool bCoarse = bIsSaving && (Value.X % CoarseStep) == 0 && (Value.Y % CoarseStep) == 0 && (Value.Z % CoarseStep) == 0;
+		Ar.SerializeBits(&bCoarse, 1);
+		const int32 Step = bCoarse ? CoarseStep : 1;
+
+		uint32 Components[3] = { 0, 0, 0 };
+		uint32 NumBits = 0;
+
+		if (bIsSaving)
+		{
+			Components[0] = ZigZagEncode(Value.X / Step);
+			Components[1] = ZigZagEncode(Value.Y / Step);
+			Components[2] = ZigZagEncode(Value.Z / Step);
+
+			const uint32 Combined = Components[0] | Components[1] | Components[2];
+			NumBits = Combined ? FMath::Min<uint32>(FMath::FloorLog2(Combined) + 1, 31) : 0;
+		}
+
+		Ar.SerializeInt(NumBits, 32);
+
+		if (NumBits > 0)
+		{
+			for (uint32& Component : Components)
+			{
+				Ar.SerializeBits(&Component, NumBits);
+			}
+		}
+
+		if (!bIsSaving)
+		{
+			Value = FIntVector(ZigZagDecode(Components[0]) * Step, ZigZagDecode(Components[1]) * Step, ZigZagDecode(Components[2]) * Step);
+		}
+	}
+
+	// Single value version of the above, used for yaw deltas
+	inline void SerializeSteppedInt(int32& Value, FArchive& Ar, int32 CoarseStep)
+	{
+		const bool bIsSaving = Ar.IsSaving();
+
+		bool bCoarse = bIsSaving && (Value % CoarseStep) == 0;
+		Ar.SerializeBits(&bCoarse, 1);
+		const int32 Step = bCoarse ? CoarseStep : 1;
+
+		uint32 Encoded = bIsSaving ? ZigZagEncode(Value / Step) : 0;
+		uint32 NumBits = Encoded ? FMath::Min<uint32>(FMath::FloorLog2(Encoded) + 1, 31) : 0;
+
+		Ar.SerializeInt(NumBits, 32);
+
+		if (NumBits > 0)
+		{
+			Ar.SerializeBits(&Encoded, NumBits);
+		}
+
+		if (!bIsSaving)
+		{
+			Value = ZigZagDecode(Encoded) * Step;
+		}
+	}
+
+	// Two decimal vectors are sent at one decimal when that reproduces them exactly, otherwise this costs a single extra bit
+	inline bool SerializeAdaptivePackedVector(FVector& Value, FArchive& Ar)
+	{
+		EVRVectorQuantization Level = EVRVectorQuantization::RoundOneDecimal;
+
+		if (Ar.IsSaving())
+		{
+			const bool bOnOneDecimalGrid =
+				(FMath::RoundToInt64(Value.X * 100.0) % 10) == 0 &&
+				(FMath::RoundToInt64(Value.Y * 100.0) % 10) == 0 &&
+				(FMath::RoundToInt64(Value.Z * 100.0) % 10) == 0;
+
+			Level = bOnOneDecimalGrid ? EVRVectorQuantization::RoundOneDecimal : EVRVectorQuantization::RoundTwoDecimals;
+		}
+
+		Ar.SerializeBits(&Level, 1);
+
+		if (Level == EVRVectorQuantization::RoundOneDecimal)
+		{
+			return SerializePackedVector<10, 22>(Value, Ar);
+		}
+
+		return SerializePackedVector<100, 22/*30*/>(Value, Ar);
+	}
+}
+
 USTRUCT()
 struct VREXPANSIONPLUGIN_API FVRConditionalMoveRep
 {
@@ -467,7 +619,7 @@ public:
 
 			if (bHasVRinput)
 			{
-				bOutSuccess &= SerializePackedVector<100, 22/*30*/>(CustomVRInputVector, Ar);
+				bOutSuccess &= VRMoveRepUtils::SerializeAdaptivePackedVector(CustomVRInputVector, Ar);
 			}
 			else if (bIsLoading)
 			{
@@ -476,7 +628,7 @@ public:
 
 			if (bHasRequestedVelocity)
 			{
-				bOutSuccess &= SerializePackedVector<100, 22/*30*/>(RequestedVelocity, Ar);
+				bOutSuccess &= VRMoveRepUtils::SerializeAdaptivePackedVector(RequestedVelocity, Ar);
 			}
 			else if (bIsLoading)
 			{
@@ -639,6 +791,14 @@ public:
 	float CapsuleHeight;
 	FVRConditionalMoveRep ConditionalValues;
 
+	// Sequence of this move on the client, sent as an 8 bit id so the server can store it as a delta baseline
+	uint32 VRMoveSequence;
+
+	// Capsule state as it is sent, and the acknowledged move state that it is delta encoded against (age 0 = absolute)
+	FVRCapsuleRepState QuantizedVRCapsuleState;
+	FVRCapsuleRepState VRCapsuleBaselineState;
+	uint8 VRCapsuleBaselineAge;
+
 	void Clear();
 	virtual void SetInitialPosition(ACharacter* C);
 	virtual void PrepMoveFor(ACharacter* Character) override;
@@ -681,11 +841,25 @@ public:
 	EVRConjoinedMovementModes ReplicatedMovementMode;
 	FVRConditionalMoveRep ConditionalMoveReps;
 
+	// Delta encoding state for the VR capsule, see FSavedMove_VRBaseCharacter
+	uint8 VRMoveId;
+	uint8 VRCapsuleBaselineAge;
+	FVRCapsuleRepState QuantizedVRCapsuleState;
+	FVRCapsuleRepState VRCapsuleBaselineState;
+
 	FVRCharacterNetworkMoveData();
 
 	virtual ~FVRCharacterNetworkMoveData();
 	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
 	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+
+private:
+
+	// Sends the capsule location and yaw either absolute or as a delta against an acknowledged move
+	void SerializeVRCapsuleState(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, bool& bOutSuccess);
+
+	// Measures the bits that each VR field costs when vre.LogMoveRepBitReport is on
+	void AccumulateBitReport(UCharacterMovementComponent& CharacterMovement);
 };
 
 struct VREXPANSIONPLUGIN_API FVRCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
@@ -502,6 +502,10 @@ public:
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GripMotionController", ReplicatedUsing = OnRep_LocalTransaction)
 		TArray<FBPActorGripInformation> LocalTransactionBuffer;
 
+	// The grip arrays are push based, call these after changing a replicated grip value on the server
+	void MarkGripArrayDirty(const TArray<FBPActorGripInformation>& GripArray);
+	void MarkGripDirty(const FBPActorGripInformation* Grip);
+
 	// Locally Gripped Array functions
 
 	// Notify a client that their local grip was bad
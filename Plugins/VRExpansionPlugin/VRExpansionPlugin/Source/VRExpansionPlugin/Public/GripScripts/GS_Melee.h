@@ -159,6 +159,37 @@ public:
 
 };
 
+// Values derived from a FBPLodgeComponentInfo when the melee script begins play, so that hits don't have to recompute them
+struct VREXPANSIONPLUGIN_API FVRMeleeLodgeZoneCache
+{
+	// Component the cache was built for, if it changes the cache is rebuilt
+	const UPrimitiveComponent* TargetComponent;
+
+	// Local space bounds of the target component
+	FBox LocalBox;
+
+	// Minimum absolute dot product of the hit normal and the forward vector for a penetration and for a hit
+	float PenetrationDotMin;
+	float HitDotMin;
+
+	// Squared velocity thresholds
+	float PenetrationVelocitySq;
+	float MinimumHitVelocitySq;
+
+	bool bCanPenetrate;
+	bool bCanHit;
+
+	FVRMeleeLodgeZoneCache() :
+		TargetComponent(nullptr),
+		LocalBox(ForceInit),
+		PenetrationDotMin(0.f),
+		HitDotMin(0.f),
+		PenetrationVelocitySq(0.f),
+		MinimumHitVelocitySq(0.f),
+		bCanPenetrate(false),
+		bCanHit(false)
+	{}
+};
 
 // Event thrown when we the melee weapon becomes lodged
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_SevenParams(FVROnMeleeShouldLodgeSignature, FBPLodgeComponentInfo, LogComponent, AActor *, OtherActor, UPrimitiveComponent *, OtherComp, ECollisionChannel, OtherCompCollisionChannel, FBPHitSurfaceProperties, HitSurfaceProperties, FVector, NormalImpulse, const FHitResult&, Hit);
@@ -218,6 +249,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Melee|Lodging")
 		TArray<FBPHitSurfaceProperties> OverrideMeleeSurfaceSettings;
 
+	// Rebuilds the surface and penetration notifier lookups used when handling hits, they are built on begin play.
+	// Call this after editing OverrideMeleeSurfaceSettings or PenetrationNotifierComponents entries in place at runtime,
+	// adding or removing entries or changing the target components is picked up automatically.
+	UFUNCTION(BlueprintCallable, Category = "Melee|Lodging")
+		void RefreshMeleeHitTables();
+
 //	FVector RollingVelocityAverage;
 	//FVector RollingAngVelocityAverage;
 
@@ -251,6 +288,16 @@ public:
 	bool bCheckLodge;
 	bool bIsHeld;
 
+	// Lookups for OnLodgeHitCallback, see RefreshMeleeHitTables
+	// The surface table holds the first settings entry for each surface type, indexed from SurfaceTableIndices
+	TArray<FVRMeleeLodgeZoneCache> LodgeZoneCache;
+	TArray<FBPHitSurfaceProperties> SurfaceTable;
+	int8 SurfaceTableIndices[SurfaceType_Max];
+	int32 SurfaceTableSourceNum;
+	bool bSurfaceTableFromOverride;
+
+	bool AreMeleeHitTablesValid() const;
+
 	FVector LastRelativePos;
 	FVector RelativeBetweenGripsCenterPos;
 
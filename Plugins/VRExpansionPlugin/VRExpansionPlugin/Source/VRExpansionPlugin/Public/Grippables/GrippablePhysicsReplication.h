@@ -66,6 +66,84 @@ public:
 
 
 
+// Error correction settings, resolved from the physics settings and CVars once per tick instead of once per body
+struct FVRPhysicsRepSettings
+{
+	float NetPingExtrapolation;
+	float NetPingLimit;
+	float ErrorPerLinearDiff;
+	float ErrorPerAngularDiff;
+	float MaxRestoredStateError;
+	float ErrorAccumulationSeconds;
+	float ErrorAccumulationDistanceSq;
+	float ErrorAccumulationSimilarity;
+	float PositionLerp;
+	float LinearVelocityCoefficient;
+	float AngleLerp;
+	float AngularVelocityCoefficient;
+	float MaxLinearHardSnapDistance;
+	bool bAlwaysHardSnap;
+
+	FVRPhysicsRepSettings(const FRigidBodyErrorCorrection& ErrorCorrection);
+};
+
+// A single replicated body for this tick.
+// Gathered on the game thread, solved in parallel (only touches its own target) and then written back to the body serially.
+struct FVRPhysicsRepWorkItem
+{
+	TWeakObjectPtr<UPrimitiveComponent> ComponentKey;
+	UPrimitiveComponent* PrimComp;
+	FBodyInstance* BI;
+	FReplicatedPhysicsTarget* PhysicsTarget;
+	FRigidBodyState CurrentState;
+	bool bSimulating;
+	bool bRemoveTarget;
+
+	// Results of SolveRigidBodyStateVR
+	bool bSolved;
+	bool bRestoredState;
+	bool bOutsideTolerance;
+	bool bHardSnap;
+	bool bLinearHardSnap;
+	bool bShouldSleep;
+	float PingSeconds;
+	FVector TargetPos;
+	FQuat TargetQuat;
+	FVector NewPos;
+	FQuat NewQuat;
+	FVector NewLinVel;
+	FVector NewAngVel;
+
+	// Only used for logging
+	FVector ExtrapolationDeltaPos;
+	float PrevProgress;
+	float PrevSimilarity;
+
+	FVRPhysicsRepWorkItem() :
+		PrimComp(nullptr),
+		BI(nullptr),
+		PhysicsTarget(nullptr),
+		bSimulating(false),
+		bRemoveTarget(false),
+		bSolved(false),
+		bRestoredState(true),
+		bOutsideTolerance(false),
+		bHardSnap(false),
+		bLinearHardSnap(false),
+		bShouldSleep(false),
+		PingSeconds(0.0f),
+		TargetPos(FVector::ZeroVector),
+		TargetQuat(FQuat::Identity),
+		NewPos(FVector::ZeroVector),
+		NewQuat(FQuat::Identity),
+		NewLinVel(FVector::ZeroVector),
+		NewAngVel(FVector::ZeroVector),
+		ExtrapolationDeltaPos(FVector::ZeroVector),
+		PrevProgress(0.0f),
+		PrevSimilarity(0.0f)
+	{}
+};
+
 class FPhysicsReplicationVR : public FPhysicsReplication
 {
 public:
@@ -89,6 +167,14 @@ public:
 	FPhysicsReplicationAsyncInput* AsyncInputVR;	//async data being written into before we push into callback
 
 	void PrepareAsyncData_ExternalVR(const FRigidBodyErrorCorrection& ErrorCorrection);	//prepare async data for writing. Call on external thread (i.e. game thread)
+
+	// Split up ApplyRigidBodyState so that the server tick can solve all of its targets in parallel
+	void GatherRigidBodyStateVR(FBodyInstance* BI, FReplicatedPhysicsTarget& PhysicsTarget, FVRPhysicsRepWorkItem& OutWorkItem) const;
+	void SolveRigidBodyStateVR(float DeltaSeconds, const FVRPhysicsRepSettings& Settings, const float PingSecondsOneWay, FVRPhysicsRepWorkItem& WorkItem) const;
+	bool ApplySolvedRigidBodyStateVR(const FVRPhysicsRepSettings& Settings, const FRigidBodyErrorCorrection& ErrorCorrection, FVRPhysicsRepWorkItem& WorkItem, bool* bDidHardSnap = nullptr);
+
+	// Reused every tick so that we aren't re-allocating it
+	TArray<FVRPhysicsRepWorkItem> RepWorkItemsVR;
 };
 
 class IPhysicsReplicationFactoryVR : public IPhysicsReplicationFactory
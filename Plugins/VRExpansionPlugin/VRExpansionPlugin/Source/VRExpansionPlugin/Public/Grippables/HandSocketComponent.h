@@ -222,6 +222,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Hand Socket Data", meta = (bIgnoreSelf = "true"))
 		static bool GetAnimationSequenceAsPoseSnapShot(UAnimSequence * InAnimationSequence, FPoseSnapshot& OutPoseSnapShot, USkeletalMeshComponent* TargetMesh = nullptr, bool bSkipRootBone = false, bool bFlipHand = false);
 
+	/**
+	* Snapshots from the two functions above are cached and shared between all hand sockets, keyed by the animation, target mesh, flags and pose deltas
+	* Editor changes to animations and skeletons clear it automatically, call this if you modify animation data at runtime
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Hand Socket Data")
+		static void ClearPoseSnapShotCache();
+
 	// Returns the target relative transform of the hand
 	//UFUNCTION(BlueprintCallable, Category = "Hand Socket Data")
 	FTransform GetHandRelativePlacement();
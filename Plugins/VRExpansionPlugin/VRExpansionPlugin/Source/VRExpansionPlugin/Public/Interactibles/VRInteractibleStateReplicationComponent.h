@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "VRInteractibleStateReplicationComponent.generated.h"
+
+/**
+* Quantized state of a single interactible.
+* Levers and dials send their angle around their rotation axis, spline sliders send their progress,
+* other sliders send their position on each axis that they can move on and buttons send their depth.
+*/
+USTRUCT()
+struct VREXPANSIONPLUGIN_API FVRInteractiblePackedState
+{
+	GENERATED_BODY()
+public:
+
+	uint16 Values[3];
+	uint8 NumValues;
+	uint8 NumBits;
+
+	FVRInteractiblePackedState() :
+		NumValues(0),
+		NumBits(16)
+	{
+		Values[0] = Values[1] = Values[2] = 0;
+	}
+
+	bool operator==(const FVRInteractiblePackedState& Other) const
+	{
+		if (NumValues != Other.NumValues || NumBits != Other.NumBits)
+			return false;
+
+		for (int32 i = 0; i < NumValues; ++i)
+		{
+			if (Values[i] != Other.Values[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FVRInteractiblePackedState> : public TStructOpsTypeTraitsBase2<FVRInteractiblePackedState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
+USTRUCT()
+struct VREXPANSIONPLUGIN_API FVRInteractibleCompactState : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY()
+		TObjectPtr<USceneComponent> Interactible;
+
+	UPROPERTY()
+		FVRInteractiblePackedState PackedState;
+
+	FVRInteractibleCompactState() :
+		Interactible(nullptr)
+	{}
+
+	void PostReplicatedAdd(const struct FVRInteractibleCompactStateArray& InArraySerializer);
+	void PostReplicatedChange(const struct FVRInteractibleCompactStateArray& InArraySerializer);
+};
+
+USTRUCT()
+struct VREXPANSIONPLUGIN_API FVRInteractibleCompactStateArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY()
+		TArray<FVRInteractibleCompactState> Items;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FVRInteractibleCompactState, FVRInteractibleCompactStateArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FVRInteractibleCompactStateArray> : public TStructOpsTypeTraitsBase2<FVRInteractibleCompactStateArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+* Replicates the state of all of the interactibles on an actor that have bUseCompactStateReplication enabled as one packed delta,
+* instead of each of them replicating its relative transform at full precision. Meant for actors with many interactibles, like control panels.
+* Levers (single axis), dials, sliders and buttons are supported, the state is only sent while the interactible has bReplicateMovement on.
+*/
+UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent), ClassGroup = (VRExpansionPlugin))
+class VREXPANSIONPLUGIN_API UVRInteractibleStateReplicationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UVRInteractibleStateReplicationComponent(const FObjectInitializer& ObjectInitializer);
+
+	// Bits per angle for levers and dials, 12 bits is just under a tenth of a degree
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VRInteractibleStateReplication", meta = (ClampMin = "4", ClampMax = "16", UIMin = "4", UIMax = "16"))
+		int32 AngleBits;
+
+	// Bits per slider progress, slider axis position and button depth
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VRInteractibleStateReplication", meta = (ClampMin = "4", ClampMax = "16", UIMin = "4", UIMax = "16"))
+		int32 ProgressBits;
+
+	UPROPERTY(Replicated)
+		FVRInteractibleCompactStateArray CompactStates;
+
+	// Adds an interactible to the packed state, it needs bUseCompactStateReplication enabled
+	// The interactibles of the owning actor are added automatically at BeginPlay
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "VRInteractibleStateReplication")
+		bool AddInteractible(USceneComponent* Interactible);
+
+	// Removes an interactible from the packed state, it goes back to replicating its transform
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "VRInteractibleStateReplication")
+		bool RemoveInteractible(USceneComponent* Interactible);
+
+	// Returns if this type of interactible with its current settings can be replicated through this component
+	static bool SupportsInteractible(const USceneComponent* Interactible);
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Packs the current state of the interactibles and marks the ones that changed
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+};
@@ -251,6 +251,20 @@ public:
 	UPROPERTY(EditAnywhere, Replicated, BlueprintReadWrite, Category = "VRGripInterface|Replication")
 		bool bReplicateMovement;
 
+	// Replicates the state of this interactible through a VRInteractibleStateReplicationComponent on the owning actor instead of through its relative transform
+	// The state is quantized to the bit counts set on that component, without one on the owner this does nothing
+	// Only single axis levers are supported, XY and flight stick levers keep replicating their transform
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VRGripInterface|Replication")
+		bool bUseCompactStateReplication;
+
+	// Set by the state replication component that this interactible was added to
+	bool bCompactStateRegistered;
+
+	bool UsesCompactStateReplication() const
+	{
+		return bUseCompactStateReplication && bCompactStateRegistered;
+	}
+
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 	virtual void BeginPlay() override;
 
@@ -36,6 +36,40 @@ enum class EVRInteractibleSliderDropBehavior : uint8
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FVRSliderHitPointSignature, float, SliderProgressPoint);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FVRSliderFinishedLerpingSignature, float, FinalProgress);
 
+/**
+* Adaptively sampled points along a followed spline, in the splines local space.
+* Finds the closest input key by walking the samples from the last result (or scanning them all if the query jumped)
+* and then refining on the curve, instead of searching every segment of the spline like FindInputKeyClosestToWorldLocation.
+*/
+struct VREXPANSIONPLUGIN_API FVRSliderSplineLookup
+{
+	TArray<float> Keys;
+	TArray<FVector> Points;
+
+	// What the samples were built from, they are rebuilt if the spline changes
+	TWeakObjectPtr<const USplineComponent> Spline;
+	uint32 SplineVersion = 0;
+	bool bClosedLoop = false;
+
+	// Largest distance between two samples, queries that moved further than this don't warm start
+	float MaxSampleSpacing = 0.0f;
+
+	int32 LastSampleIndex = INDEX_NONE;
+	FVector LastQueryLocation = FVector::ZeroVector;
+
+	bool IsValidFor(const USplineComponent* InSpline) const;
+	void Build(const USplineComponent* InSpline);
+	void Reset();
+
+	// Returns the input key closest to a location in the splines local space
+	float FindInputKeyClosestToLocalLocation(const USplineComponent* InSpline, const FVector& LocalLocation, bool bWarmStart);
+
+private:
+
+	int32 GetPrevSample(int32 Index) const;
+	int32 GetNextSample(int32 Index) const;
+};
+
 /**
 * A slider component, can act like a scroll bar, or gun bolt, or spline following component
 */
@@ -167,6 +201,12 @@ public:
 	float LastInputKey;
 	float LerpedKey;
 
+	// Built when the spline is set, or lazily if it changes after that
+	FVRSliderSplineLookup SplineLookup;
+
+	// Replacement for SplineComponentToFollow->FindInputKeyClosestToWorldLocation, bWarmStart continues the search from the last query
+	float FindSplineInputKeyClosestToWorldLocation(const FVector& WorldLocation, bool bWarmStart = false);
+
 	// Type of lerp to use when following a spline
 	// For lerping I would suggest using ConstantTo in general as it will be the smoothest.
 	// Normal Interp will change speed based on distance, that may also have its uses.
@@ -278,6 +318,19 @@ public:
 	UPROPERTY(EditAnywhere, Replicated, BlueprintReadWrite, Category = "VRGripInterface|Replication")
 		bool bReplicateMovement;
 
+	// Replicates the state of this interactible through a VRInteractibleStateReplicationComponent on the owning actor instead of through its relative transform
+	// The state is quantized to the bit counts set on that component, without one on the owner this does nothing
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VRGripInterface|Replication")
+		bool bUseCompactStateReplication;
+
+	// Set by the state replication component that this interactible was added to
+	bool bCompactStateRegistered;
+
+	bool UsesCompactStateReplication() const
+	{
+		return bUseCompactStateReplication && bCompactStateRegistered;
+	}
+
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 	virtual void BeginPlay() override;
 
@@ -129,6 +129,16 @@ struct FAISightTargetVR
 	FORCEINLINE const AActor* GetTargetActor() const { return Target.Get(); }
 };
 
+// Points on a VR character that are tested when multi point visibility is enabled
+enum class EVRSightVisibilityPoint : uint8
+{
+	Head,
+	LeftHand,
+	RightHand,
+	Body,
+	Count
+};
+
 struct FAISightQueryVR
 {
 	FPerceptionListenerID ObserverId;
@@ -137,11 +147,17 @@ struct FAISightQueryVR
 	float Score;
 	float Importance;
 
+	/** Number of frames this query should wait between evaluations, scales with distance when distance based query rates are enabled */
+	float EvaluationInterval;
+
 	FVector LastSeenLocation;
 
 	/** User data that can be used inside the IAISightTargetInterface::CanBeSeenFrom method to store a persistence state */
 	mutable int32 UserData;
 
+	/** Multi point visibility tests this point first, it is the one that was visible the last time */
+	EVRSightVisibilityPoint LastVisiblePoint;
+
 	union
 	{
 		/**
@@ -173,7 +189,7 @@ struct FAISightQueryVR
 	};
 
 	FAISightQueryVR(FPerceptionListenerID ListenerId = FPerceptionListenerID::InvalidID(), FAISightTargetVR::FTargetId Target = FAISightTargetVR::InvalidTargetId)
-		: ObserverId(ListenerId), TargetId(Target), Score(0), Importance(0), LastSeenLocation(FAISystem::InvalidLocation), UserData(0)
+		: ObserverId(ListenerId), TargetId(Target), Score(0), Importance(0), EvaluationInterval(0), LastSeenLocation(FAISystem::InvalidLocation), UserData(0), LastVisiblePoint(EVRSightVisibilityPoint::Body)
 	{
 		FrameInfo.bLastResult = false;
 		FrameInfo.LastProcessedFrameNumber = GFrameCounter;
@@ -192,7 +208,17 @@ struct FAISightQueryVR
 	 */
 	void RecalcScore()
 	{
-		Score = GetAge() + Importance;
+		Score = GetAge() - EvaluationInterval + Importance;
+	}
+
+	/**
+	 * Score minus the current frame number, since every queued query ages at the same rate the ordering by this value
+	 * does not change between frames, which lets us keep the in range queries in a heap instead of re-sorting them.
+	 * Note: This should only be called on queries that are queued up for later processing
+	 */
+	double GetPriorityKey() const
+	{
+		return (double)Importance - (double)EvaluationInterval - (double)FrameInfo.LastProcessedFrameNumber;
 	}
 
 	void OnProcessed()
@@ -237,6 +263,18 @@ struct FAISightQueryVR
 			return A.Score > B.Score;
 		}
 	};
+
+	class FHeapPredicate
+	{
+	public:
+		FHeapPredicate()
+		{}
+
+		bool operator()(const FAISightQueryVR& A, const FAISightQueryVR& B) const
+		{
+			return A.GetPriorityKey() > B.GetPriorityKey();
+		}
+	};
 };
 
 
@@ -289,9 +327,34 @@ public:
 	int32 NextOutOfRangeIndex = 0;
 	bool bSightQueriesOutOfRangeDirty = true;
 	TArray<FAISightQueryVR> SightQueriesOutOfRange;
-	TArray<FAISightQueryVR> SightQueriesInRange;
 	TArray<FAISightQueryVR> SightQueriesPending;
 
+	/** In range queries are kept as a heap (FAISightQueryVR::FHeapPredicate) instead of being sorted every update */
+	/** It only needs to be rebuilt when queries were added or removed outside of the update, which sets the dirty flag */
+	bool bSightQueriesInRangeDirty = true;
+	TArray<FAISightQueryVR> SightQueriesInRange;
+
+	/** Target ids bucketed by their 2D cell, only used when bUseSpatialHashForQueries is on */
+	TMap<FIntPoint, TArray<FAISightTargetVR::FTargetId>> TargetSpatialHash;
+	double LastSpatialHashRefreshTime = -1.0;
+
+	/** Async traces requested together for one multi point query, resolved on the first visible point or once they all returned */
+	struct FVRVisibilityTraceSet
+	{
+		TArray<FTraceHandle, TInlineAllocator<(int32)EVRSightVisibilityPoint::Count>> Handles;
+		TArray<EVRSightVisibilityPoint, TInlineAllocator<(int32)EVRSightVisibilityPoint::Count>> Points;
+		int32 NumReturned = 0;
+
+		/** GFrameCounter when the traces were requested, sets that are never fully returned are aged out */
+		uint64 RequestFrame = 0;
+	};
+
+	/** Filled in by ComputeVisibility, the pending query stores the first handle of its set in its trace info */
+	mutable TArray<FVRVisibilityTraceSet> PendingVisibilityTraceSets;
+
+	/** Drops trace sets whose query is gone or whose traces are too old to still come back, timed out queries are resolved as not visible */
+	void CleanupPendingVisibilityTraceSets();
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config)
 		int32 MaxTracesPerTick;
@@ -328,6 +391,44 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config)
 		bool bUseAsynchronousTraceForDefaultSightQueries;
 
+	/** If true, VR characters without a IAISightTargetInterface are tested at their HMD, both motion controllers and their body
+	 * instead of only at their body. Tests stop at the first visible point and start with the point that was visible last time,
+	 * async traces for all of the points are requested together. */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception|VR", config)
+		bool bUseMultiPointVRVisibility;
+
+	/** If true, targets are bucketed in a spatial hash and queries are only kept for listener / target pairs that are within
+	 * the listeners sight range (plus SpatialHashQueryMargin) instead of pairing every listener with every target
+	 * A target moving into range can go up to SpatialHashRefreshInterval before it gets a query, so this is off by default */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception|Spatial Hash", config)
+		bool bUseSpatialHashForQueries;
+
+	/** Size of the spatial hash cells on the X and Y axis */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception|Spatial Hash", config, meta = (ClampMin = "100.0", EditCondition = "bUseSpatialHashForQueries"))
+		float SpatialHashCellSize;
+
+	/** Distance past the sight range that queries are created at, they are removed again at twice this distance
+	 * Should cover how far a target can move between refreshes */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception|Spatial Hash", config, meta = (ClampMin = "0.0", EditCondition = "bUseSpatialHashForQueries"))
+		float SpatialHashQueryMargin;
+
+	/** Seconds between rebuilding the spatial hash and adding / removing queries from it */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception|Spatial Hash", config, meta = (ClampMin = "0.0", EditCondition = "bUseSpatialHashForQueries"))
+		float SpatialHashRefreshInterval;
+
+	/** If true, targets that are further away than FarQueryDistanceRatio of the sight radius are re-evaluated less often
+	 * Targets that are currently seen are always evaluated at the normal rate */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception|Distance Rates", config)
+		bool bUseDistanceBasedQueryRates;
+
+	/** Fraction of the sight radius after which queries start to be slowed down */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception|Distance Rates", config, meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bUseDistanceBasedQueryRates"))
+		float FarQueryDistanceRatio;
+
+	/** Frames to wait between evaluations of a query at the edge of the sight radius, scales linearly from 0 at FarQueryDistanceRatio */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception|Distance Rates", config, meta = (ClampMin = "0.0", EditCondition = "bUseDistanceBasedQueryRates"))
+		float MaxFarQueryIntervalFrames;
+
 	ECollisionChannel DefaultSightCollisionChannel;
 
 	FOnPendingVisibilityQueryProcessedDelegateVR OnPendingCanBeSeenQueryProcessedDelegate;
@@ -382,6 +483,21 @@ protected:
 	bool RegisterTarget(AActor& TargetActor, const TFunction<void(FAISightQueryVR&)>& OnAddedFunc = nullptr);
 
 	float CalcQueryImportance(const FPerceptionListener& Listener, const FVector& TargetLocation, const float SightRadiusSq) const;
+	/** Fills in the points to test on a VR character that are within the listeners sight cone, preferred point first */
+	int32 GatherVRVisibilityPoints(const AVRBaseCharacter& VRChar, const FPerceptionListener& Listener, const FDigestedSightProperties& PropDigest, const float SightRadiusSq, const EVRSightVisibilityPoint PreferredPoint, FVector(&OutLocations)[(int32)EVRSightVisibilityPoint::Count], EVRSightVisibilityPoint(&OutPoints)[(int32)EVRSightVisibilityPoint::Count]) const;
+
+	float CalcQueryEvaluationInterval(const FPerceptionListener& Listener, const FVector& TargetLocation, const float SightRadiusSq) const;
+
+	FIntPoint GetSpatialHashCell(const FVector& Location) const;
+
+	/** Returns true if the target is close enough to the listener that a query should exist for the pair */
+	bool IsWithinQueryRange(const FPerceptionListener& Listener, const FDigestedSightProperties& PropDigest, const FVector& TargetLocation, const float Margin) const;
+
+	/** Calls Func for every observed target in the spatial hash that is within query range of the listener */
+	void ForEachTargetInQueryRange(const FPerceptionListener& Listener, const FDigestedSightProperties& PropDigest, TFunctionRef<void(const FAISightTargetVR::FTargetId&, const FAISightTargetVR&, const FVector&)> Func) const;
+
+	/** Rebuilds the spatial hash and adds / removes queries for pairs that moved in or out of range */
+	void RefreshSpatialHashQueries();
 	bool RegisterNewQuery(const FPerceptionListener& Listener, const IGenericTeamAgentInterface* ListenersTeamAgent, const AActor& TargetActor, const FAISightTargetVR::FTargetId& TargetId, const FVector& TargetLocation, const FDigestedSightProperties& PropDigest, const TFunction<void(FAISightQueryVR&)>& OnAddedFunc);
 
 
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+#include <atomic>
+
+/**
+* Process wide cache of data that is derived from assets.
+* Owns the console variable that turns the cache off and empties itself when an asset it depends on is edited in the editor.
+* Declare it as a file scope static so that the console variable exists from startup, the state is only built on first use.
+*/
+template<typename StateType>
+class TVRAssetDerivedCache
+{
+public:
+
+	// Returns true if editing this object can change the cached data
+	typedef bool (*FAffectsCacheFunc)(const UObject* Object);
+
+	// Empties the state, takes any lock that the state needs
+	typedef void (*FClearStateFunc)(StateType& State);
+
+	TVRAssetDerivedCache(const TCHAR* CVarName, const TCHAR* CVarHelp, FAffectsCacheFunc InAffectsCache, FClearStateFunc InClearState) :
+		Enabled(1),
+		CVarEnabled(CVarName, Enabled, CVarHelp, ECVF_Default),
+		AffectsCache(InAffectsCache),
+		ClearState(InClearState)
+#if WITH_EDITOR
+		, bEditorDelegatesRegistered(false)
+#endif
+	{}
+
+	~TVRAssetDerivedCache()
+	{
+#if WITH_EDITOR
+		FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+		FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
+#endif
+	}
+
+	TVRAssetDerivedCache(const TVRAssetDerivedCache&) = delete;
+	TVRAssetDerivedCache& operator=(const TVRAssetDerivedCache&) = delete;
+
+	bool IsEnabled() const
+	{
+		return Enabled > 0;
+	}
+
+	// Also binds the editor invalidation on first use, the engine delegates can't be bound to during static init
+	StateType& GetState()
+	{
+#if WITH_EDITOR
+		if (!bEditorDelegatesRegistered.load(std::memory_order_acquire))
+		{
+			FScopeLock ScopeLock(&RegisterLock);
+			if (!bEditorDelegatesRegistered.load(std::memory_order_relaxed))
+			{
+				FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &TVRAssetDerivedCache::OnObjectPropertyChanged);
+				FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &TVRAssetDerivedCache::OnObjectModified);
+				bEditorDelegatesRegistered.store(true, std::memory_order_release);
+			}
+		}
+#endif
+
+		return State;
+	}
+
+	void Clear()
+	{
+		ClearState(State);
+	}
+
+private:
+
+#if WITH_EDITOR
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+	{
+		if (AffectsCache(Object))
+			Clear();
+	}
+
+	void OnObjectModified(UObject* Object)
+	{
+		if (AffectsCache(Object))
+			Clear();
+	}
+#endif
+
+	int32 Enabled;
+	FAutoConsoleVariableRef CVarEnabled;
+	FAffectsCacheFunc AffectsCache;
+	FClearStateFunc ClearState;
+	StateType State;
+
+#if WITH_EDITOR
+	FCriticalSection RegisterLock;
+	std::atomic<bool> bEditorDelegatesRegistered;
+#endif
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "VRInteractibleSimulationSubsystem.generated.h"
+
+/**
+* Runs the TickComponent of awake interactibles (levers, dials, sliders, buttons and mounts) in a single pass over a dense list,
+* instead of each of them having its own tick function enabled while it is moving.
+* Interactibles wake up when gripped, overlapped or told to lerp and go back to sleep once they are at rest and not held,
+* sleeping ones cost nothing per frame.
+*/
+UCLASS()
+class VREXPANSIONPLUGIN_API UVRInteractibleSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UVRInteractibleSimulationSubsystem() :
+		Super()
+	{
+
+	}
+
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+		// Editor worlds fall back to the components own tick
+	}
+
+	virtual void Deinitialize() override;
+
+	// Wakes or sleeps an interactible, used in place of SetComponentTickEnabled by the interactibles
+	// When vre.Interactibles.CentralSimulation is off (the default, or the world has no subsystem) this just toggles the components own tick
+	// Centrally simulated interactibles tick after the worlds tick groups and ignore their TickInterval
+	static void SetInteractibleAwake(UActorComponent* Interactible, bool bAwake);
+
+	void WakeInteractible(UActorComponent* Interactible);
+	void SleepInteractible(UActorComponent* Interactible);
+
+	// Returns the number of interactibles currently being simulated
+	UFUNCTION(BlueprintPure, Category = "VRInteractibleSimulation")
+		int32 GetNumAwakeInteractibles() const;
+
+	// FTickableGameObject functions
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual TStatId GetStatId() const override;
+	// End tickable object information
+
+private:
+
+	UFUNCTION()
+		void OnInteractibleDeactivated(UActorComponent* Component);
+
+	void RemoveAwakeAt(int32 Index);
+
+	// Dense list of the awake interactibles, sleeping swaps the last one into the hole
+	TArray<TWeakObjectPtr<UActorComponent>> AwakeInteractibles;
+	TMap<TWeakObjectPtr<UActorComponent>, int32> AwakeIndices;
+};
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/UnrealNetwork.h"
+#if WITH_PUSH_MODEL
+#include "Net/Core/PushModel/PushModel.h"
+#endif
+
+// Set in the Build.cs and off by default, when off our replicated properties are compared every net update
+#ifndef VREXPANSION_PUSH_MODEL
+#define VREXPANSION_PUSH_MODEL 0
+#endif
+
+// Nothing to push to if the engine was built without it
+#if !WITH_PUSH_MODEL
+#undef VREXPANSION_PUSH_MODEL
+#define VREXPANSION_PUSH_MODEL 0
+#endif
+
+// Validation snapshots push based properties and reports any that changed without being marked dirty, see vre.PushModel.Validate
+#define VREXPANSION_PUSH_MODEL_VALIDATION (VREXPANSION_PUSH_MODEL && !UE_BUILD_SHIPPING)
+
+namespace VRPushModel
+{
+	// Value for FDoRepLifetimeParams::bIsPushBased on our properties
+	constexpr bool bIsPushBased = (VREXPANSION_PUSH_MODEL != 0);
+
+#if VREXPANSION_PUSH_MODEL_VALIDATION
+	// Adds a push based property to the validation list of its class, called from GetLifetimeReplicatedProps
+	VREXPANSIONPLUGIN_API void RegisterProperty(const UClass* OwningClass, FName PropertyName);
+
+	// Lets the validation know that a change to this property was marked
+	VREXPANSIONPLUGIN_API void NotifyPropertyMarkedDirty(const UObject* Object, FName PropertyName);
+#endif
+}
+
+#if VREXPANSION_PUSH_MODEL_VALIDATION
+#define VRE_PUSH_MODEL_REGISTER_PROPERTY(c, v) VRPushModel::RegisterProperty(c::StaticClass(), GET_MEMBER_NAME_CHECKED(c, v))
+#define VRE_PUSH_MODEL_NOTIFY_MARKED(c, v, obj) VRPushModel::NotifyPropertyMarkedDirty(obj, GET_MEMBER_NAME_CHECKED(c, v))
+#else
+#define VRE_PUSH_MODEL_REGISTER_PROPERTY(c, v)
+#define VRE_PUSH_MODEL_NOTIFY_MARKED(c, v, obj)
+#endif
+
+// Registers a replicated property as push based when VREXPANSION_PUSH_MODEL is on, otherwise as a normal compared property
+#define VRE_DOREPLIFETIME_WITH_PARAMS(c, v, params) \
+{ \
+	FDoRepLifetimeParams VREPushParams(params); \
+	VREPushParams.bIsPushBased = VRPushModel::bIsPushBased; \
+	DOREPLIFETIME_WITH_PARAMS_FAST(c, v, VREPushParams); \
+	VRE_PUSH_MODEL_REGISTER_PROPERTY(c, v); \
+}
+
+#define VRE_DOREPLIFETIME(c, v) VRE_DOREPLIFETIME_WITH_PARAMS(c, v, FDoRepLifetimeParams())
+
+#define VRE_DOREPLIFETIME_CONDITION(c, v, cond) \
+{ \
+	FDoRepLifetimeParams VRECondParams; \
+	VRECondParams.Condition = cond; \
+	VRE_DOREPLIFETIME_WITH_PARAMS(c, v, VRECondParams); \
+}
+
+#define VRE_DOREPLIFETIME_CONDITION_NOTIFY(c, v, cond, rncond) \
+{ \
+	FDoRepLifetimeParams VRECondParams; \
+	VRECondParams.Condition = cond; \
+	VRECondParams.RepNotifyCondition = rncond; \
+	VRE_DOREPLIFETIME_WITH_PARAMS(c, v, VRECondParams); \
+}
+
+// Marks a property registered with the macros above as dirty, needs to be called at every mutation site that runs on the server
+#if VREXPANSION_PUSH_MODEL
+#define VRE_MARK_PROPERTY_DIRTY(c, v, obj) \
+{ \
+	MARK_PROPERTY_DIRTY_FROM_NAME(c, v, obj); \
+	VRE_PUSH_MODEL_NOTIFY_MARKED(c, v, obj); \
+}
+#else
+#define VRE_MARK_PROPERTY_DIRTY(c, v, obj)
+#endif
@@ -9,6 +9,8 @@ class UTexture2D;
 class UMaterial;
 class APlayerController;
 
+DECLARE_LOG_CATEGORY_EXTERN(LogVRRenderTargetManager, Log, All);
+DECLARE_STATS_GROUP(TEXT("VRRenderTargetManager"), STATGROUP_VRRenderTargetManager, STATCAT_Advanced);
 
 // #TODO: Dirty rects so don't have to send entire texture?
 
@@ -82,6 +84,35 @@ struct TStructOpsTypeTraits< FBPVRReplicatedTextureStore > : public TStructOpsTy
 };
 
 
+/**
+* An encoded copy of the render target at a given revision
+* Shared between all of the replication proxies that need to stream it so that we only encode once per revision
+*/
+struct VREXPANSIONPLUGIN_API FVRRenderTargetSnapshot
+{
+	// Revision of the render target that this snapshot was taken from
+	uint32 Revision;
+
+	uint32 Width;
+	uint32 Height;
+	EPixelFormat PixelFormat;
+	bool bIsZipped;
+
+	// RLE and optionally zlib packed data, never modified after creation
+	TArray<uint8> PackedData;
+
+	FVRRenderTargetSnapshot()
+	{
+		Revision = 0;
+		Width = 0;
+		Height = 0;
+		PixelFormat = (EPixelFormat)0;
+		bIsZipped = false;
+	}
+};
+
+typedef TSharedPtr<const FVRRenderTargetSnapshot, ESPMode::ThreadSafe> FVRRenderTargetSnapshotPtr;
+
 USTRUCT()
 struct FRenderDataStore {
 	GENERATED_BODY()
@@ -91,7 +122,11 @@ struct FRenderDataStore {
 	FIntPoint Size2D;
 	EPixelFormat PixelFormat;
 
+	// Render target revision at the time that the read back was queued
+	uint32 Revision;
+
 	FRenderDataStore() {
+		Revision = 0;
 	}
 };
 
@@ -189,12 +224,18 @@ public:
 
 	UPROPERTY(Transient)
 	FBPVRReplicatedTextureStore TextureStore;
+
+	// Shared snapshot that we are currently streaming to our owner (server side only)
+	FVRRenderTargetSnapshotPtr SendSnapshot;
 	
 	UPROPERTY(Transient)
 		int32 BlobNum;
 
 	bool bWaitingForManager;
 
+	// Begin streaming the passed in snapshot to our owning client
+	void SendSnapshotToOwner(const FVRRenderTargetSnapshotPtr& Snapshot);
+
 	void SendInitMessage();
 
 	UFUNCTION()
@@ -219,6 +260,8 @@ public:
 		if(SendTimer_Handle.IsValid())
 			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
 
+		SendSnapshot.Reset();
+
 		Super::EndPlay(EndPlayReason);
 	}
 
@@ -312,14 +355,36 @@ public:
 
 	void DrawOperation(UCanvas* Canvas, const FRenderManagerOperation& Operation);
 
+	// Draws a list of operations, merging consecutive line draws into a single line batch
+	// and consecutive triangle draws that share a material into a single triangle item
+	void DrawOperationsBatched(UCanvas* Canvas, const TArray<FRenderManagerOperation>& Operations);
+
 	UFUNCTION()
 		void DrawPoll();
 
 	void DrawOperations();
 
+	// Replays received operations now, or schedules a replay if we are above MaxReplayRate
+	void RequestDrawOperationsReplay();
+
+	UFUNCTION()
+		void ReplayDrawOperations();
+
 	UPROPERTY()
 		FTimerHandle DrawHandle;
 
+	// If true then operations are merged into as few canvas items as possible when drawn
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager")
+		bool bBatchDrawOperations;
+
+	// Maximum number of times per second that operations received from the server are replayed onto the render target
+	// Operations received between replays are coalesced into a single flush, 0 replays them as soon as they arrive
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager", meta = (ClampMin = "0.0"))
+		float MaxReplayRate;
+
+	FTimerHandle ReplayHandle;
+	double LastReplayTime;
+
 	UPROPERTY(Transient)
 		bool bIsStoringImage;
 
@@ -364,6 +429,31 @@ public:
 	UPROPERTY(Transient)
 		FBPVRReplicatedTextureStore RenderTargetStore;
 
+	// Incremented every time that the contents of the render target change
+	uint32 RenderTargetRevision;
+
+	// The last encoded snapshot of the render target, re-used for every newly relevant client
+	// as long as the render target revision has not changed since it was taken
+	FVRRenderTargetSnapshotPtr CachedSnapshot;
+
+	// Returns the cached snapshot if it is still valid for the current revision of the render target
+	FVRRenderTargetSnapshotPtr GetCurrentSnapshot() const;
+
+	// Streams the passed in snapshot to every client that is waiting on the texture
+	void SendSnapshotToDirtyClients(const FVRRenderTargetSnapshotPtr& Snapshot);
+
+	// Converts and packs read back pixel data into a snapshot, safe to call off of the game thread
+	static FVRRenderTargetSnapshotPtr EncodeSnapshot(const TArray<FColor>& ColorData, FIntPoint Size2D, EPixelFormat PixelFormat, uint32 Revision);
+
+	// Called on the game thread when an async encode finishes
+	void OnSnapshotEncoded(const FVRRenderTargetSnapshotPtr& Snapshot);
+
+	// Called on the game thread when an async decode finishes, writes the pixels to our render target
+	void OnRenderTargetDecoded(uint32 DecodeID, int32 Width, int32 Height, const TArray<FColor>& ColorData);
+
+	// ID of the latest requested decode, older decodes that finish after it are discarded
+	uint32 DecodeRequestCounter;
+
 	UFUNCTION(BlueprintCallable, Category = "VRRenderTargetManager|UtilityFunctions")
 		bool GenerateTrisFromBoxPlaneIntersection(UPrimitiveComponent* PrimToBoxCheck, FTransform WorldTransformOfPlane, const FPlane& LocalProjectionPlane, FVector2D PlaneSize, FColor UVColor, TArray<FCanvasUVTri>& OutTris);
 	
@@ -374,6 +464,7 @@ public:
 	void UpdateRelevancyMap();
 
 	// Decompress the render target data to a texture and copy it to our managed render target
+	// Decoding runs as a task, the render target is updated on the game thread once it completes
 	bool DeCompressRenderTarget2D();
 
 	// Queues storing the render target image to our buffer
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "BasicReplicationGraph.h"
+#include "VRReplicationGraph.generated.h"
+
+/**
+* Per connection replication rates for VR characters.
+* The character carries its tracked components (camera and motion controllers) as sub objects, so the rate
+* picked here is also the rate that the head and hands are sent at to that connection.
+*/
+USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
+struct VREXPANSIONPLUGIN_API FVRReplicationGraphCharacterPolicy
+{
+	GENERATED_BODY()
+public:
+
+	// Size of the cells that characters are grouped into, should be on the order of the cull distance
+	UPROPERTY(EditAnywhere, Config, Category = "VRReplicationGraph", meta = (ClampMin = "100.0", UIMin = "100.0"))
+		float CellSize;
+
+	// Characters further than this from all of a connections viewers are not sent to it
+	UPROPERTY(EditAnywhere, Config, Category = "VRReplicationGraph", meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float CullDistance;
+
+	// Characters within this distance are sent every FullRatePeriod frames, regardless of view direction
+	UPROPERTY(EditAnywhere, Config, Category = "VRReplicationGraph", meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float FullRateDistance;
+
+	// Characters within this distance are sent every ReducedRatePeriod frames, beyond it every FarRatePeriod frames
+	UPROPERTY(EditAnywhere, Config, Category = "VRReplicationGraph", meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float ReducedRateDistance;
+
+	// Replication periods in server frames for each distance band
+	UPROPERTY(EditAnywhere, Config, Category = "VRReplicationGraph", meta = (ClampMin = "1", ClampMax = "255"))
+		int32 FullRatePeriod;
+
+	UPROPERTY(EditAnywhere, Config, Category = "VRReplicationGraph", meta = (ClampMin = "1", ClampMax = "255"))
+		int32 ReducedRatePeriod;
+
+	UPROPERTY(EditAnywhere, Config, Category = "VRReplicationGraph", meta = (ClampMin = "1", ClampMax = "255"))
+		int32 FarRatePeriod;
+
+	// Dot product between the view direction and the direction to the character below which it counts as out of view
+	UPROPERTY(EditAnywhere, Config, Category = "VRReplicationGraph", meta = (ClampMin = "-1.0", ClampMax = "1.0"))
+		float OutOfViewDot;
+
+	// Multiplier on the period of characters outside of FullRateDistance that are out of view
+	UPROPERTY(EditAnywhere, Config, Category = "VRReplicationGraph", meta = (ClampMin = "1", ClampMax = "16"))
+		int32 OutOfViewPeriodScale;
+
+	FVRReplicationGraphCharacterPolicy() :
+		CellSize(10000.0f),
+		CullDistance(15000.0f),
+		FullRateDistance(1500.0f),
+		ReducedRateDistance(5000.0f),
+		FullRatePeriod(1),
+		ReducedRatePeriod(2),
+		FarRatePeriod(4),
+		OutOfViewDot(0.25f),
+		OutOfViewPeriodScale(2)
+	{}
+
+	// Returns the replication period of a character for this viewer, or 0 if it should be culled
+	uint8 GetReplicationPeriod(const FNetViewer& Viewer, const AActor* Character) const;
+};
+
+/**
+* Replication graph node for VR characters.
+* Characters are grouped into a coarse grid each frame, for each connection only the cells around its viewers are visited
+* and each character found is given a per connection replication period based on its distance from and direction to the viewer.
+*/
+UCLASS()
+class VREXPANSIONPLUGIN_API UVRReplicationGraphNode_Characters : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+
+	UVRReplicationGraphNode_Characters();
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+	virtual void PrepareForReplication() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
+
+	FVRReplicationGraphCharacterPolicy Policy;
+
+private:
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	TArray<AActor*> Characters;
+
+	// Rebuilt every frame in PrepareForReplication
+	TMap<FIntPoint, TArray<AActor*>> CharacterCells;
+
+	// Lists handed to each connection, kept around so that they are valid for the whole replication frame
+	TMap<TObjectKey<UNetReplicationGraphConnection>, FActorRepListRefView> ConnectionLists;
+
+	// Scratch for the best period of each character across a connections viewers
+	TMap<AActor*, uint8> BestPeriods;
+
+	uint32 LastConnectionCleanupFrame;
+};
+
+/**
+* Basic replication graph that routes VR characters to a UVRReplicationGraphNode_Characters instead of the grid node.
+* Enable it for a net driver in DefaultEngine.ini, for example:
+* [/Script/OnlineSubsystemUtils.IpNetDriver]
+* ReplicationDriverClassName="/Script/VRExpansionPlugin.VRReplicationGraph"
+* Projects with their own graph can add the node and route characters to it the same way.
+*/
+UCLASS(transient, config = Engine)
+class VREXPANSIONPLUGIN_API UVRReplicationGraph : public UBasicReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+
+	UVRReplicationGraph();
+
+	virtual void InitGlobalGraphNodes() override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	UPROPERTY(Config)
+		FVRReplicationGraphCharacterPolicy CharacterPolicy;
+
+	UPROPERTY()
+		TObjectPtr<UVRReplicationGraphNode_Characters> VRCharacterNode;
+
+	// Characters that were routed to the VRCharacterNode when they were added
+	TSet<AActor*> RoutedCharacters;
+};
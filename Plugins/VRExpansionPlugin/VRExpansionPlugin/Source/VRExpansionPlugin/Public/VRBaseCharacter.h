@@ -338,6 +338,9 @@ public:
 	UPROPERTY(Replicated, ReplicatedUsing = OnRep_CapsuleHeight)
 		FVRReplicatedCapsuleHeight ReplicatedCapsuleHeight;
 
+	// Sets the replicated capsule height and marks it for replication (server)
+	void SetReplicatedCapsuleHeight(float NewCapsuleHeight);
+
 	UFUNCTION()
 	void OnRep_CapsuleHeight();
 
@@ -442,6 +445,9 @@ public:
 	UPROPERTY(BlueprintReadOnly, Replicated, EditAnywhere, Category = "Seating", ReplicatedUsing = OnRep_SeatedCharInfo)
 	FVRSeatedCharacterInfo SeatInformation;
 
+	// Marks the seat information for replication, needs to be called when it is modified from outside of the character
+	void MarkSeatInformationDirty();
+
 	// Called when the seated mode is changed
 	UFUNCTION(BlueprintNativeEvent, Category = "Seating")
 		void OnSeatedModeChanged(bool bNewSeatedMode, bool bWasAlreadySeated);
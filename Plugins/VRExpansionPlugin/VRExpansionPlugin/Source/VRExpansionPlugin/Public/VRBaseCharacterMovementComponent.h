@@ -14,6 +14,18 @@ struct FPathFollowingResult;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogVRBaseCharacterMovement, Log, All);
 
+// Simulation detail levels for simulated proxies, see bUseSimulatedProxyLOD
+UENUM(BlueprintType)
+enum class EVRSimulatedProxyLOD : uint8
+{
+	// Full movement simulation and smoothing every frame
+	VRSimLOD_Full,
+	// Reduced tick rate and no floor checks
+	VRSimLOD_Reduced,
+	// Only takes on replicated state and smooths to it, at the lowest tick rate
+	VRSimLOD_Minimal
+};
+
 /** Delegate for notification when to handle a climbing step up, will override default step up logic if is bound to. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FVROnPerformClimbingStepUp, FVector, FinalStepUpLocation);
 
@@ -61,6 +73,47 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRBaseCharacterMovementComponent|Smoothing")
 		bool bDisableSimulatedTickWhenSmoothingMovement;
 
+	// If true then simulated proxies lower their simulation detail based on their distance to the local view (and if they are being rendered)
+	// Root motion is always fully simulated.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRBaseCharacterMovementComponent|Smoothing|LOD")
+		bool bUseSimulatedProxyLOD;
+
+	// Distance from the local view after which simulated proxies drop to the reduced LOD
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRBaseCharacterMovementComponent|Smoothing|LOD", meta = (ClampMin = "0.0", UIMin = "0", EditCondition = "bUseSimulatedProxyLOD"))
+		float SimulatedProxyReducedLODDistance;
+
+	// Distance from the local view after which simulated proxies drop to the minimal LOD
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRBaseCharacterMovementComponent|Smoothing|LOD", meta = (ClampMin = "0.0", UIMin = "0", EditCondition = "bUseSimulatedProxyLOD"))
+		float SimulatedProxyMinimalLODDistance;
+
+	// Simulation rate (in hz) of the reduced LOD, 0 ticks every frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRBaseCharacterMovementComponent|Smoothing|LOD", meta = (ClampMin = "0.0", UIMin = "0", EditCondition = "bUseSimulatedProxyLOD"))
+		float SimulatedProxyReducedLODTickRate;
+
+	// Simulation rate (in hz) of the minimal LOD, 0 ticks every frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRBaseCharacterMovementComponent|Smoothing|LOD", meta = (ClampMin = "0.0", UIMin = "0", EditCondition = "bUseSimulatedProxyLOD"))
+		float SimulatedProxyMinimalLODTickRate;
+
+	// If true then proxies that haven't been rendered recently are dropped one more LOD
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRBaseCharacterMovementComponent|Smoothing|LOD", meta = (EditCondition = "bUseSimulatedProxyLOD"))
+		bool bDemoteHiddenSimulatedProxies;
+
+	// Returns the simulation LOD that this proxy is currently running at
+	UFUNCTION(BlueprintPure, Category = "VRBaseCharacterMovementComponent|Smoothing|LOD")
+		EVRSimulatedProxyLOD GetSimulatedProxyLOD() const
+	{
+		return CurrentSimulatedProxyLOD;
+	}
+
+	// Picks the simulation LOD of this proxy, override to drive it from a significance manager instead of distance
+	virtual EVRSimulatedProxyLOD CalculateSimulatedProxyLOD() const;
+
+	// If true then simulated movement should keep its current floor instead of running floor checks
+	inline bool ShouldSkipSimulatedFloorChecks() const
+	{
+		return CurrentSimulatedProxyLOD != EVRSimulatedProxyLOD::VRSimLOD_Full;
+	}
+
 	// When true the hmd movement injection speed is capped to the maximum movement speed
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement")
 		bool bCapHMDMovementToMaxMovementSpeed;
@@ -200,6 +253,50 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement")
 		bool bHoldPositionOnTrackingLossThresholdHit;
 
+	// If true then client moves with roomscale HMD motion, custom VR input or requested velocity can be combined
+	// into a single server move within the tolerances below, this greatly lowers the ServerMove rate on high refresh headsets.
+	// If false (default) then any of those will block combining like in the base engine.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Networking")
+		bool bCombineVRMoves;
+
+	// HMD deltas and custom input smaller than this are treated as jitter and can be combined regardless of their direction
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Networking", meta = (ClampMin = "0.0", UIMin = "0", EditCondition = "bCombineVRMoves"))
+		float VRMoveCombineMinDelta;
+
+	// Largest accumulated HMD delta or custom input that a combined move can carry
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Networking", meta = (ClampMin = "0.0", UIMin = "0", EditCondition = "bCombineVRMoves"))
+		float VRMoveCombineMaxDelta;
+
+	// Largest change in HMD yaw (degrees) between two moves that can be combined
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Networking", meta = (ClampMin = "0.0", UIMin = "0", ClampMax = "180.0", UIMax = "180", EditCondition = "bCombineVRMoves"))
+		float VRMoveCombineMaxYawDelta;
+
+	// Requested velocities (nav movement) within this tolerance of each other can be combined
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Networking", meta = (ClampMin = "0.0", UIMin = "0", EditCondition = "bCombineVRMoves"))
+		float VRMoveCombineVelocityTolerance;
+
+	// If true then the VR capsule location and yaw are sent as a delta against the last acknowledged move when possible
+	// instead of in absolute terms on every move.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Networking")
+		bool bDeltaEncodeVRCapsule;
+
+	// Precision that the VR capsule location is sent to the server at, one decimal saves bits at the cost of a millimeter of precision
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Networking")
+		EVRVectorQuantization VRCapsuleLocationQuantization;
+
+	// Precision that the VR capsule yaw is sent to the server at
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Networking")
+		EVRRotationQuantization VRCapsuleRotationQuantization;
+
+	// Client side sequence of recorded moves, the low bits are sent as the move id
+	uint32 NextVRMoveSequence;
+
+	// Stores the capsule state of a received move so later moves can be delta encoded against it (server)
+	void RecordVRCapsuleRepBaseline(uint8 MoveId, const FVRCapsuleRepState& State);
+
+	// Returns the capsule state recorded for a move id, false if we never received it (server)
+	bool GetVRCapsuleRepBaseline(uint8 MoveId, FVRCapsuleRepState& OutState) const;
+
 	// Rewind the relative movement that we had with the HMD, this is exposed to Blueprint so that custom movement modes can use it to rewind prior to movement actions.
 	// Returns the Vector required to get back to the original position (for custom movement modes)
 	UFUNCTION(BlueprintCallable, Category = "VRMovement")
@@ -445,5 +542,15 @@ public:
 	// If true then low grav will ignore the default physics volume fluid friction, useful if you have a mix of low grav and normal movement
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|LowGrav")
 		bool VRLowGravIgnoresDefaultFluidFriction;
+
+protected:
+
+	// Capsule state of received moves indexed by move id, allocated on the first received move
+	TArray<FVRCapsuleRepState> VRCapsuleRepBaselines;
+
+	// Simulated proxy LOD state
+	EVRSimulatedProxyLOD CurrentSimulatedProxyLOD;
+	float SimulatedProxyLODAccumulatedTime;
+	float SimulatedProxyLODEvaluateTime;
 };
 
@@ -227,6 +227,50 @@ public:
 	// Had to force it within the function to use VRLocation instead.
 	virtual void FindFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bCanUseCachedLocation, const FHitResult* DownwardSweepResult = NULL) const;
 
+	// If true then a walkable floor result is reused while the VR capsule stays within RoomscaleFloorCacheTolerance of where it was found
+	// on the same unmoved floor component, this skips the floor sweeps when the only motion is leaning or small roomscale steps.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement")
+		bool bUseRoomscaleFloorCache;
+
+	// Distance (in cm) that the VR capsule can move away from a cached floor result before it is swept for again
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement", meta = (ClampMin = "0.0", UIMin = "0", EditCondition = "bUseRoomscaleFloorCache"))
+		float RoomscaleFloorCacheTolerance;
+
+	// Clears the roomscale floor cache so that the next floor check sweeps
+	void InvalidateRoomscaleFloorCache() const { RoomscaleFloorCache.bIsValid = false; }
+
+protected:
+
+	struct FRoomscaleFloorCache
+	{
+		FFindFloorResult FloorResult;
+		TWeakObjectPtr<UPrimitiveComponent> FloorComponent;
+		FTransform FloorTransform;
+		FVector CapsuleLocation;
+		FVector GravityDirection;
+		float CapsuleRadius;
+		float CapsuleHalfHeight;
+		bool bIsValid;
+
+		FRoomscaleFloorCache() :
+			CapsuleLocation(FVector::ZeroVector),
+			GravityDirection(FVector::ZeroVector),
+			CapsuleRadius(0.0f),
+			CapsuleHalfHeight(0.0f),
+			bIsValid(false)
+		{}
+	};
+
+	mutable FRoomscaleFloorCache RoomscaleFloorCache;
+
+	// Returns true and fills OutFloorResult if the cached floor is still good for this capsule location
+	bool GetCachedRoomscaleFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult) const;
+
+	// Stores a freshly swept floor result if it is one that can be reused
+	void CacheRoomscaleFloor(const FVector& CapsuleLocation, const FFindFloorResult& FloorResult) const;
+
+public:
+
 	// Need to use actual capsule location for step up
 	bool StepUp(const FVector& GravDir, const FVector& Delta, const FHitResult &InHit, FStepDownResult* OutStepDownResult = NULL) override;
 
@@ -106,6 +106,42 @@ protected:
 	template<typename AllocatorType>
 	bool ConvertSweptOverlapsToCurrentOverlapsVR(TArray<FOverlapInfo, AllocatorType>& OutOverlapsAtEndLocation, const TOverlapArrayView& SweptOverlaps, int32 SweptOverlapsIndex, const FVector& EndLocation, const FQuat& EndRotationQuat);
 
+	// Overlap candidates from the last padded query, see bUseOverlapCache
+	struct FVROverlapCache
+	{
+		TArray<FOverlapInfo> Candidates;
+		TArray<FOverlapInfo> LastOverlaps;
+		FVector QueryLocation;
+		FQuat QueryRotation;
+		FVector LastExactLocation;
+		float CapsuleRadius;
+		float CapsuleHalfHeight;
+		float Padding;
+		TEnumAsByte<ECollisionChannel> ObjectType;
+		bool bIsValid;
+
+		FVROverlapCache() :
+			QueryLocation(FVector::ZeroVector),
+			QueryRotation(FQuat::Identity),
+			LastExactLocation(FVector::ZeroVector),
+			CapsuleRadius(0.0f),
+			CapsuleHalfHeight(0.0f),
+			Padding(0.0f),
+			ObjectType(ECC_Pawn),
+			bIsValid(false)
+		{}
+	};
+
+	FVROverlapCache OverlapCache;
+
+	// Fills OutOverlaps from the overlap cache if the capsule is still inside of the padded query bounds, returns false if a new query is needed
+	template<typename AllocatorType>
+	bool GetOverlapsFromCacheVR(TArray<FOverlapInfo, AllocatorType>& OutOverlaps, const FVector& Location, const FQuat& Rotation, bool bIgnoreChildren);
+
+	// Filters the padded query candidates down to the ones that overlap the capsule at Location and stores them for later updates
+	template<typename AllocatorType>
+	void StoreOverlapCacheVR(TArray<FOverlapInfo, AllocatorType>& InOutOverlaps, const FVector& Location, const FQuat& Rotation);
+
 
 public:
 	void BeginPlay() override;
@@ -166,6 +202,19 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary")
 	bool bUseWalkingCollisionOverride;
 
+	// If true then overlaps are queried with a padded capsule and later updates are resolved against those candidates
+	// while the capsule stays inside of the padding, instead of re-querying the world on every HMD driven move.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary|Overlaps")
+		bool bUseOverlapCache;
+
+	// Padding (in cm) added to the capsule for the cached overlap query, the capsule can move this far before the world is queried again
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary|Overlaps", meta = (ClampMin = "0.0", UIMin = "0", EditCondition = "bUseOverlapCache"))
+		float OverlapCachePadding;
+
+	// Capsule moves smaller than this (in cm) since the last overlap update keep the previous overlaps entirely, filters out HMD jitter
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary|Overlaps", meta = (ClampMin = "0.0", UIMin = "0", EditCondition = "bUseOverlapCache"))
+		float OverlapCacheMovementThreshold;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary")
 	TEnumAsByte<ECollisionChannel> WalkingCollisionOverride;
 
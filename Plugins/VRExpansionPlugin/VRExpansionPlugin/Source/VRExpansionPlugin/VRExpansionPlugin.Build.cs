@@ -16,6 +16,11 @@ public class VRExpansionPlugin : ModuleRules
 
         PublicDefinitions.Add("WITH_VR_EXPANSION=1");
 
+        // Push model replication for the plugins replicated properties
+        // Opt in, set to true to stop comparing them every net update (has no effect if the engine is built without push model)
+        bool bUseVRExpansionPushModel = false;
+        PublicDefinitions.Add("VREXPANSION_PUSH_MODEL=" + (bUseVRExpansionPushModel ? "1" : "0"));
+
         // To detect VR Preview, not built out in packaged builds
         if (Target.bBuildEditor == true)
         {
@@ -72,7 +77,8 @@ public class VRExpansionPlugin : ModuleRules
                     "AIModule",
                     "AnimGraphRuntime",
                     "XRBase",
-                    "GameplayTags"
+                    "GameplayTags",
+                    "ReplicationGraph"
                     //"Renderer",
                     //"UtilityShaders"
         });